@@ -1,6 +1,8 @@
 /// AcousticEchoCanceller.cpp
 
 #include "AcousticEchoCanceller.h"
+#include "../util/EventLog.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 
 /**
@@ -60,7 +62,11 @@ void dibiff::adaptive::AcousticEchoCanceller::process() {
         int inBlockSize = input->getBlockSize();
         int refBlockSize = reference->getBlockSize();
         if (inBlockSize != refBlockSize) {
-            throw std::runtime_error("Block sizes do not match");
+            /// Pass the input through rather than fail on the audio thread
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Error, name.c_str(), "Block sizes do not match, bypassing", {static_cast<double>(inBlockSize), static_cast<double>(refBlockSize)});
+            output->setData(inData, inBlockSize);
+            markProcessed();
+            return;
         }
         Eigen::VectorXf x(inBlockSize), r(inBlockSize), y(inBlockSize);
         for (int i = 0; i < inBlockSize; ++i) {
@@ -74,6 +80,8 @@ void dibiff::adaptive::AcousticEchoCanceller::process() {
         for (int i = 0; i < inBlockSize; ++i) {
             out[i] = y(i);
         }
+        /// The per-sample path leaves the divergence check to the caller
+        adaptiveFilter->recoverDivergence(out.data(), out.size());
         output->setData(out, inBlockSize);
         markProcessed();
     }
@@ -111,6 +119,30 @@ bool dibiff::adaptive::AcousticEchoCanceller::isReadyToProcess() const {
     }
     return input->isReady() && reference->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the echo canceller
+ * @return -1, since the converged weights depend on the whole history
+ */
+long dibiff::adaptive::AcousticEchoCanceller::getStateMemory() const {
+    return -1;
+}
+/**
+ * @brief Save the runtime state of the echo canceller
+ * @return A versioned blob of the adaptive filter state
+ */
+std::vector<unsigned char> dibiff::adaptive::AcousticEchoCanceller::saveState() const {
+    dibiff::util::StateWriter writer("AcousticEchoCanceller", 1);
+    writer.writeVector(adaptiveFilter->saveState());
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the echo canceller
+ * @param state A blob returned by saveState()
+ */
+void dibiff::adaptive::AcousticEchoCanceller::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "AcousticEchoCanceller", 1);
+    adaptiveFilter->restoreState(reader.readVector<unsigned char>());
+}
 /**
  * Create a new acoustic echo canceller object
  * @param filterLength The length of the adaptive filter
@@ -61,6 +61,21 @@ class dibiff::adaptive::AcousticEchoCanceller : public dibiff::graph::AudioObjec
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the echo canceller
+         * @return -1, since the converged weights depend on the whole history
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the echo canceller
+         * @return A versioned blob of the adaptive filter state
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the echo canceller
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * Create a new acoustic echo canceller object
          * @param filterLength The length of the adaptive filter
@@ -1,6 +1,7 @@
 /// Compressor.cpp
 
 #include "Compressor.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 
 /**
@@ -155,6 +156,33 @@ bool dibiff::dynamic::Compressor::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the compressor
+ * @details The smoothing coefficient for a time constant t is exp(-log10(9) / (t * fs)),
+ * so the gain settles to within -80 dB after ln(1e4) / log10(9) * t * fs samples
+ * @return The settling time of the slower of the attack and release smoothing, in samples
+ */
+long dibiff::dynamic::Compressor::getStateMemory() const {
+    const float slowest = std::max(attack, release);
+    return static_cast<long>(std::ceil(std::log(1.0e4f) / std::log10(9.0f) * slowest * sampleRate));
+}
+/**
+ * @brief Save the runtime state of the compressor
+ * @return A versioned blob of the smoothed gain
+ */
+std::vector<unsigned char> dibiff::dynamic::Compressor::saveState() const {
+    dibiff::util::StateWriter writer("Compressor", 1);
+    writer.write(gS);
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the compressor
+ * @param state A blob returned by saveState()
+ */
+void dibiff::dynamic::Compressor::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "Compressor", 1);
+    gS = reader.read<float>();
+}
 /**
  * Create a new compressor object
  * @param threshold The threshold of the compressor in dB
@@ -86,6 +86,21 @@ class dibiff::dynamic::Compressor : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the compressor
+         * @return The settling time of the slower of the attack and release smoothing, in samples
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the compressor
+         * @return A versioned blob of the smoothed gain
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the compressor
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * Create a new compressor object
          * @param threshold The threshold of the compressor in dB
@@ -1,6 +1,7 @@
 /// Envelope.cpp
 
 #include "Envelope.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 
 #include <iostream>
@@ -21,7 +22,8 @@ enum EnvelopeStage {
  * @param releaseTime The release time in seconds
  * @param sampleRate The sample rate of the input signal
  */
-dibiff::dynamic::Envelope::Envelope(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate)
+template<typename SampleType, typename StateType>
+dibiff::dynamic::BasicEnvelope<SampleType, StateType>::BasicEnvelope(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate)
 : dibiff::graph::AudioObject(), 
   attackTime(attackTime), decayTime(decayTime), sustainLevel(sustainLevel), releaseTime(releaseTime), sampleRate(sampleRate) {
     name = "Envelope";
@@ -30,7 +32,8 @@ dibiff::dynamic::Envelope::Envelope(float& attackTime, float& decayTime, float&
  * @brief Initialize
  * @details Initializes the envelope connection points and parameters
  */
-void dibiff::dynamic::Envelope::initialize() {
+template<typename SampleType, typename StateType>
+void dibiff::dynamic::BasicEnvelope<SampleType, StateType>::initialize() {
     auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "EnvelopeInput"));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
@@ -41,45 +44,50 @@ void dibiff::dynamic::Envelope::initialize() {
     _outputs.emplace_back(std::move(o));
     output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
 
-    attackIncrement = 1.0f / (attackTime * sampleRate);
-    decayIncrement = (1.0f - sustainLevel) / (decayTime * sampleRate);
-    releaseIncrement = sustainLevel / (releaseTime * sampleRate);
+    attackIncrement = StateType(1) / (StateType(attackTime) * sampleRate);
+    decayIncrement = (StateType(1) - sustainLevel) / (StateType(decayTime) * sampleRate);
+    releaseIncrement = StateType(sustainLevel) / (StateType(releaseTime) * sampleRate);
 }
 /**
  * @brief Process a sample
  * @details Processes a single sample of audio data
  * @param sample The input sample
  */
-float dibiff::dynamic::Envelope::processAttack(float sample) {
+template<typename SampleType, typename StateType>
+SampleType dibiff::dynamic::BasicEnvelope<SampleType, StateType>::processAttack(SampleType sample) {
     currentLevel += attackIncrement;
-    if (currentLevel >= 1.0f) {
-        currentLevel = 1.0f;
+    if (currentLevel >= StateType(1)) {
+        currentLevel = StateType(1);
         currentStage = Decay;
     }
-    return sample * currentLevel;
+    return static_cast<SampleType>(sample * currentLevel);
 }
-float dibiff::dynamic::Envelope::processDecay(float sample) {
+template<typename SampleType, typename StateType>
+SampleType dibiff::dynamic::BasicEnvelope<SampleType, StateType>::processDecay(SampleType sample) {
     currentLevel -= decayIncrement;
     if (currentLevel <= sustainLevel) {
         currentLevel = sustainLevel;
         currentStage = Sustain;
     }
-    return sample * currentLevel;
+    return static_cast<SampleType>(sample * currentLevel);
 }
-float dibiff::dynamic::Envelope::processSustain(float sample) {
-    return sample * currentLevel;
+template<typename SampleType, typename StateType>
+SampleType dibiff::dynamic::BasicEnvelope<SampleType, StateType>::processSustain(SampleType sample) {
+    return static_cast<SampleType>(sample * currentLevel);
 }
-float dibiff::dynamic::Envelope::processRelease(float sample) {
+template<typename SampleType, typename StateType>
+SampleType dibiff::dynamic::BasicEnvelope<SampleType, StateType>::processRelease(SampleType sample) {
     currentLevel -= releaseIncrement;
-    if (currentLevel <= 0.0f) {
-        currentLevel = 0.0f;
+    if (currentLevel <= StateType(0)) {
+        currentLevel = StateType(0);
         currentStage = Idle;
     }
-    return sample * currentLevel;
+    return static_cast<SampleType>(sample * currentLevel);
 }
-float dibiff::dynamic::Envelope::processIdle(float sample) {
+template<typename SampleType, typename StateType>
+SampleType dibiff::dynamic::BasicEnvelope<SampleType, StateType>::processIdle(SampleType sample) {
     // return sample * currentLevel;
-    return 0.0f;
+    return SampleType(0);
 }
 /**
  * @brief Process a block of samples
@@ -87,10 +95,11 @@ float dibiff::dynamic::Envelope::processIdle(float sample) {
  * @param buffer The input buffer
  * @param blockSize The size of the block
  */
-void dibiff::dynamic::Envelope::process() {
-    attackIncrement = 1.0f / (attackTime * sampleRate);
-    decayIncrement = (1.0f - sustainLevel) / (decayTime * sampleRate);
-    releaseIncrement = sustainLevel / (releaseTime * sampleRate);
+template<typename SampleType, typename StateType>
+void dibiff::dynamic::BasicEnvelope<SampleType, StateType>::process() {
+    attackIncrement = StateType(1) / (StateType(attackTime) * sampleRate);
+    decayIncrement = (StateType(1) - sustainLevel) / (StateType(decayTime) * sampleRate);
+    releaseIncrement = StateType(sustainLevel) / (StateType(releaseTime) * sampleRate);
     if (midiInput->isConnected()) {
         auto& midiData = midiInput->getData();
         int noteOnOff = 0;
@@ -112,7 +121,8 @@ void dibiff::dynamic::Envelope::process() {
     } else if (input->isReady()) {
         const std::vector<float>& data = input->getData();
         const int blockSize = input->getBlockSize();
-        Eigen::VectorXf x(blockSize), y(blockSize);
+        using Vector = Eigen::Matrix<SampleType, Eigen::Dynamic, 1>;
+        Vector x(blockSize), y(blockSize);
         for (int i = 0; i < blockSize; ++i) {
             x(i) = data[i];
         }
@@ -140,7 +150,7 @@ void dibiff::dynamic::Envelope::process() {
         }
         std::vector<float> out(blockSize);
         for (int i = 0; i < blockSize; ++i) {
-            out[i] = y(i);
+            out[i] = static_cast<float>(y(i));
         }
         output->setData(out, blockSize);
         markProcessed();
@@ -150,42 +160,82 @@ void dibiff::dynamic::Envelope::process() {
  * @brief Note on event
  * @details Triggers the envelope to start the attack phase
  */
-void dibiff::dynamic::Envelope::noteOn() {
+template<typename SampleType, typename StateType>
+void dibiff::dynamic::BasicEnvelope<SampleType, StateType>::noteOn() {
     currentStage = Attack;
-    currentLevel = 0.0f;
+    currentLevel = StateType(0);
 }
 /**
  * @brief Note off event
  * @details Triggers the envelope to start the release phase
  */
-void dibiff::dynamic::Envelope::noteOff() {
+template<typename SampleType, typename StateType>
+void dibiff::dynamic::BasicEnvelope<SampleType, StateType>::noteOff() {
     currentStage = Release;
 }
 /**
  * @brief Reset the envelope
  * @details Resets the envelope to the idle state
  */
-void dibiff::dynamic::Envelope::reset() {
+template<typename SampleType, typename StateType>
+void dibiff::dynamic::BasicEnvelope<SampleType, StateType>::reset() {
     currentStage = Idle;
-    currentLevel = 0.0f;
+    currentLevel = StateType(0);
 }
 /**
  * @brief Check if the envelope is finished processing
  * @return True if the envelope is finished processing, false otherwise
  */
-bool dibiff::dynamic::Envelope::isFinished() const {
+template<typename SampleType, typename StateType>
+bool dibiff::dynamic::BasicEnvelope<SampleType, StateType>::isFinished() const {
     return input->isConnected() && input->isReady() && input->isFinished() && processed;
 }
 /**
  * @brief Check if the filter is ready to process
  * @return True if the filter is ready to process, false otherwise
  */
-bool dibiff::dynamic::Envelope::isReadyToProcess() const {
+template<typename SampleType, typename StateType>
+bool dibiff::dynamic::BasicEnvelope<SampleType, StateType>::isReadyToProcess() const {
     if (!input->isConnected()) {
         return true;
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the envelope
+ * @return -1, since the envelope stage depends on every note event so far
+ */
+template<typename SampleType, typename StateType>
+long dibiff::dynamic::BasicEnvelope<SampleType, StateType>::getStateMemory() const {
+    return -1;
+}
+/**
+ * @brief Save the runtime state of the envelope
+ * @return A versioned blob of the envelope stage and level
+ */
+template<typename SampleType, typename StateType>
+std::vector<unsigned char> dibiff::dynamic::BasicEnvelope<SampleType, StateType>::saveState() const {
+    dibiff::util::StateWriter writer("Envelope", 1);
+    writer.write(static_cast<std::int32_t>(currentStage));
+    writer.writeArray(&currentLevel, 1);
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the envelope
+ * @param state A blob returned by saveState()
+ */
+template<typename SampleType, typename StateType>
+void dibiff::dynamic::BasicEnvelope<SampleType, StateType>::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "Envelope", 1);
+    const std::int32_t stage = reader.read<std::int32_t>();
+    if (stage < Attack || stage > Idle) {
+        throw std::runtime_error("Invalid envelope stage.");
+    }
+    StateType level;
+    reader.readArray(&level, 1);
+    currentStage = static_cast<EnvelopeStage>(stage);
+    currentLevel = level;
+}
 /**
  * Create a new envelope object
  * @param attackTime The attack time in seconds
@@ -194,13 +244,15 @@ bool dibiff::dynamic::Envelope::isReadyToProcess() const {
  * @param releaseTime The release time in seconds
  * @param sampleRate The sample rate of the input signal
  */
-std::unique_ptr<dibiff::dynamic::Envelope> dibiff::dynamic::Envelope::create(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate) {
-    auto instance = std::make_unique<dibiff::dynamic::Envelope>(attackTime, decayTime, sustainLevel, releaseTime, sampleRate);
+template<typename SampleType, typename StateType>
+std::unique_ptr<dibiff::dynamic::BasicEnvelope<SampleType, StateType>> dibiff::dynamic::BasicEnvelope<SampleType, StateType>::create(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate) {
+    auto instance = std::make_unique<dibiff::dynamic::BasicEnvelope<SampleType, StateType>>(attackTime, decayTime, sustainLevel, releaseTime, sampleRate);
     instance->initialize();
     return std::move(instance);
 }
 
-int dibiff::dynamic::Envelope::hasNoteOnNoteOff(const std::vector<unsigned char> &message) {
+template<typename SampleType, typename StateType>
+int dibiff::dynamic::BasicEnvelope<SampleType, StateType>::hasNoteOnNoteOff(const std::vector<unsigned char> &message) {
     if (message.empty()) return 0;
     if (message.size() < 3) return 0;
 
@@ -214,4 +266,8 @@ int dibiff::dynamic::Envelope::hasNoteOnNoteOff(const std::vector<unsigned char>
         return -2;
     }
     return 0;
-}
\ No newline at end of file
+}
+
+template class dibiff::dynamic::BasicEnvelope<float, float>;
+template class dibiff::dynamic::BasicEnvelope<float, double>;
+template class dibiff::dynamic::BasicEnvelope<double, double>;
\ No newline at end of file
@@ -16,8 +16,11 @@
  * @param sustainLevel The sustain level of the envelope (0 to 1)
  * @param releaseTime The release time of the envelope in seconds
  * @param sampleRate The sample rate of the input signal
+ * @tparam SampleType The type of the samples passed to the per-stage process functions
+ * @tparam StateType The type of the envelope level and increments
  */
-class dibiff::dynamic::Envelope : public dibiff::graph::AudioObject {
+template<typename SampleType, typename StateType>
+class dibiff::dynamic::BasicEnvelope : public dibiff::graph::AudioObject {
     public:
         dibiff::graph::MidiInput* midiInput;
         dibiff::graph::AudioInput* input;
@@ -42,7 +45,7 @@ class dibiff::dynamic::Envelope : public dibiff::graph::AudioObject {
          * @param releaseTime The release time in seconds
          * @param sampleRate The sample rate of the input signal
          */
-        Envelope(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate);
+        BasicEnvelope(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate);
         /**
          * @brief Initialize
          * @details Initializes the envelope connection points and parameters
@@ -53,11 +56,11 @@ class dibiff::dynamic::Envelope : public dibiff::graph::AudioObject {
          * @details Processes a single sample of audio data
          * @param sample The input sample
          */
-        float processAttack(float sample);
-        float processDecay(float sample);
-        float processSustain(float sample);
-        float processRelease(float sample);
-        float processIdle(float sample);
+        SampleType processAttack(SampleType sample);
+        SampleType processDecay(SampleType sample);
+        SampleType processSustain(SampleType sample);
+        SampleType processRelease(SampleType sample);
+        SampleType processIdle(SampleType sample);
         /**
          * @brief Process a block of samples
          * @details Processes a block of audio data
@@ -95,6 +98,21 @@ class dibiff::dynamic::Envelope : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the envelope
+         * @return -1, since the envelope stage depends on every note event so far
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the envelope
+         * @return A versioned blob of the envelope stage and level
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the envelope
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * Create a new envelope object
          * @param attackTime The attack time in seconds
@@ -103,16 +121,16 @@ class dibiff::dynamic::Envelope : public dibiff::graph::AudioObject {
          * @param releaseTime The release time in seconds
          * @param sampleRate The sample rate of the input signal
          */
-        static std::unique_ptr<Envelope> create(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate);
+        static std::unique_ptr<BasicEnvelope> create(float& attackTime, float& decayTime, float& sustainLevel, float& releaseTime, float& sampleRate);
     private:
         float& attackTime;
         float& decayTime;
         float& sustainLevel;
         float& releaseTime;
         float& sampleRate;
-        float attackIncrement;
-        float decayIncrement;
-        float releaseIncrement;
-        float currentLevel = 0.0f;
+        StateType attackIncrement;
+        StateType decayIncrement;
+        StateType releaseIncrement;
+        StateType currentLevel = StateType(0);
         int hasNoteOnNoteOff(const std::vector<unsigned char>& message);
 };
\ No newline at end of file
@@ -84,6 +84,11 @@ class dibiff::dynamic::Expander : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the expander
+         * @return The settling time of the slower of the attack and release smoothing, in samples
+         */
+        long getStateMemory() const override;
         /**
          * Create a new expander object
          * @param threshold The threshold of the expander in dB
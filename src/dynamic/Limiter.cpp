@@ -151,6 +151,16 @@ bool dibiff::dynamic::Limiter::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the limiter
+ * @details As for the compressor, the gain settles to within -80 dB after
+ * ln(1e4) / log10(9) * t * fs samples for a time constant t
+ * @return The settling time of the slower of the attack and release smoothing, in samples
+ */
+long dibiff::dynamic::Limiter::getStateMemory() const {
+    const float slowest = std::max(attack, release);
+    return static_cast<long>(std::ceil(std::log(1.0e4f) / std::log10(9.0f) * slowest * sampleRate));
+}
 /**
  * Create a new limiter object
  * @param threshold The threshold of the limiter in dB
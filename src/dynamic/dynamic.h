@@ -13,6 +13,7 @@ namespace dibiff {
         class Limiter;
         class Compressor;
         class Expander;
-        class Envelope;
+        template<typename SampleType = float, typename StateType = SampleType> class BasicEnvelope;
+        using Envelope = BasicEnvelope<>;
     }
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+/// PitchShifter.cpp
+
+#include "PitchShifter.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constructor
+ * @details Initializes the pitch shifter with a shift and frame layout
+ * @param semitones The pitch shift in semitones
+ * @param fftSize The FFT size, a power of two
+ * @param hop The hop between frames, at most a quarter of the FFT size
+ */
+dibiff::effect::PitchShifter::PitchShifter(float& semitones, int fftSize, int hop)
+: dibiff::graph::AudioObject(), semitones(semitones), fftSize(fftSize), hop(hop) {
+    name = "PitchShifter";
+    /// Check the layout now rather than on the first block
+    dibiff::util::PhaseVocoder(fftSize, hop);
+}
+/**
+ * @brief Initialize
+ * @details Initializes the pitch shifter connection points
+ */
+void dibiff::effect::PitchShifter::initialize() {
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "PitchShifterInput", 0));
+    _inputs.emplace_back(std::move(i));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+    auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "PitchShifterOutput"));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+    configure(1);
+}
+/**
+ * @brief Process a block of samples
+ * @details Queues the block, runs a frame for every hop of input and outputs
+ * the oldest finished samples
+ */
+void dibiff::effect::PitchShifter::process() {
+    if (!input->isConnected()) {
+        /// If no input is connected, just dump zeros into the output
+        std::vector<float> out(input->getBlockSize(), 0.0f);
+        output->setData(out, input->getBlockSize());
+        markProcessed();
+    } else if (input->isReady()) {
+        const int blockSize = input->getBlockSize();
+        const int channels = input->getChannels();
+        if (static_cast<int>(vocoders.size()) != channels) {
+            configure(channels);
+        }
+        const float ratio = std::pow(2.0f, semitones / 12.0f);
+        std::vector<float> out(static_cast<std::size_t>(blockSize) * channels);
+        for (int c = 0; c < channels; ++c) {
+            const float* x = input->getChannel(c);
+            std::vector<float>& in = pending[c];
+            std::vector<float>& done = ready[c];
+            dibiff::util::PhaseVocoder& vocoder = *vocoders[c];
+            vocoder.setPitch(ratio);
+            in.insert(in.end(), x, x + blockSize);
+            std::size_t start = 0;
+            while (in.size() - start >= static_cast<std::size_t>(fftSize)) {
+                const std::size_t end = done.size();
+                done.resize(end + hop);
+                vocoder.process(in.data() + start, hop, done.data() + end);
+                start += hop;
+            }
+            in.erase(in.begin(), in.begin() + start);
+            std::copy(done.begin(), done.begin() + blockSize, out.begin() + static_cast<std::size_t>(c) * blockSize);
+            done.erase(done.begin(), done.begin() + blockSize);
+        }
+        output->setData(std::move(out), blockSize, channels);
+        markProcessed();
+    }
+}
+/**
+ * @brief Build a vocoder and queues for every channel
+ * @details The input queue starts with the frames before the first sample and the
+ * output queue with one hop, which covers the hop granularity of the frames and makes
+ * the latency exactly one FFT size
+ * @param channels The number of channels
+ */
+void dibiff::effect::PitchShifter::configure(int channels) {
+    vocoders.clear();
+    pending.assign(channels, std::vector<float>(fftSize - hop, 0.0f));
+    ready.assign(channels, std::vector<float>(hop, 0.0f));
+    for (int c = 0; c < channels; ++c) {
+        vocoders.emplace_back(std::make_unique<dibiff::util::PhaseVocoder>(fftSize, hop));
+    }
+}
+/**
+ * @brief Reset the pitch shifter
+ * @details Clears the vocoders and queues
+ */
+void dibiff::effect::PitchShifter::reset() {
+    configure(static_cast<int>(vocoders.size()));
+}
+/**
+ * @brief Clear the pitch shifter
+ * @details Clears the vocoders and queues
+ */
+void dibiff::effect::PitchShifter::clear() {
+    reset();
+}
+/**
+ * @brief Check if the pitch shifter is finished processing
+ * @return True if the pitch shifter is finished processing, false otherwise
+ */
+bool dibiff::effect::PitchShifter::isFinished() const {
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
+}
+/**
+ * @brief Check if the pitch shifter is ready to process
+ * @return True if the pitch shifter is ready to process, false otherwise
+ */
+bool dibiff::effect::PitchShifter::isReadyToProcess() const {
+    if (!input->isConnected()) {
+        return true;
+    }
+    return input->isReady() && !processed;
+}
+/**
+ * @brief Get the state memory of the pitch shifter
+ * @details Unshifted, each frame is resynthesized as it is. Shifted, the synthesis phases
+ * accumulate from the first frame, so the output depends on the whole history.
+ * @return The FFT size when unshifted, -1 otherwise
+ */
+long dibiff::effect::PitchShifter::getStateMemory() const {
+    return semitones == 0.0f ? fftSize : -1;
+}
+/**
+ * Create a new pitch shifter object
+ * @param semitones The pitch shift in semitones
+ * @param fftSize The FFT size, a power of two
+ * @param hop The hop between frames, at most a quarter of the FFT size
+ */
+std::unique_ptr<dibiff::effect::PitchShifter> dibiff::effect::PitchShifter::create(float& semitones, int fftSize, int hop) {
+    auto instance = std::make_unique<dibiff::effect::PitchShifter>(semitones, fftSize, hop);
+    instance->initialize();
+    return std::move(instance);
+}
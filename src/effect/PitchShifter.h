@@ -0,0 +1,95 @@
+/// PitchShifter.h
+
+#pragma once
+
+#include "effect.h"
+#include "../graph/graph.h"
+#include "../util/PhaseVocoder.h"
+
+/**
+ * @brief Pitch Shifter
+ * @details A pitch shifter object shifts the pitch of the input signal without
+ * changing its duration, with a phase vocoder per channel. The FFT size and hop trade
+ * quality against CPU and latency: the output is delayed by the FFT size, and every hop
+ * costs one forward and one inverse transform per channel. A live stream cannot be time
+ * stretched, since the graph consumes it at a fixed rate; sampled material is stretched
+ * by reading it at a different rate, see SampleGenerator.
+ * @param semitones The pitch shift in semitones
+ * @param fftSize The FFT size, a power of two
+ * @param hop The hop between frames, at most a quarter of the FFT size
+ */
+class dibiff::effect::PitchShifter : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioInput* input;
+        dibiff::graph::AudioOutput* output;
+        /**
+         * @brief Constructor
+         * @details Initializes the pitch shifter with a shift and frame layout
+         * @param semitones The pitch shift in semitones
+         * @param fftSize The FFT size, a power of two
+         * @param hop The hop between frames, at most a quarter of the FFT size
+         */
+        PitchShifter(float& semitones, int fftSize = 2048, int hop = 512);
+        /**
+         * @brief Initialize
+         * @details Initializes the pitch shifter connection points
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Queues the block, runs a frame for every hop of input and outputs
+         * the oldest finished samples
+         */
+        void process() override;
+        /**
+         * @brief Reset the pitch shifter
+         * @details Clears the vocoders and queues
+         */
+        void reset() override;
+        /**
+         * @brief Clear the pitch shifter
+         * @details Clears the vocoders and queues
+         */
+        void clear() override;
+        /**
+         * @brief Check if the pitch shifter is finished processing
+         * @return True if the pitch shifter is finished processing, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the pitch shifter is ready to process
+         * @return True if the pitch shifter is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the pitch shifter
+         * @return The FFT size when unshifted, -1 otherwise
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Get the latency of the pitch shifter
+         * @return The delay of the output in samples
+         */
+        int getLatency() const { return fftSize; }
+        /**
+         * Create a new pitch shifter object
+         * @param semitones The pitch shift in semitones
+         * @param fftSize The FFT size, a power of two
+         * @param hop The hop between frames, at most a quarter of the FFT size
+         */
+        static std::unique_ptr<PitchShifter> create(float& semitones, int fftSize = 2048, int hop = 512);
+    private:
+        float& semitones;
+        int fftSize;
+        int hop;
+        std::vector<std::unique_ptr<dibiff::util::PhaseVocoder>> vocoders;
+        /// Input not yet framed, per channel
+        std::vector<std::vector<float>> pending;
+        /// Output not yet sent, per channel
+        std::vector<std::vector<float>> ready;
+        /**
+         * @brief Build a vocoder and queues for every channel
+         * @param channels The number of channels
+         */
+        void configure(int channels);
+};
@@ -1,6 +1,7 @@
 /// Reverb.cpp
 
 #include "Reverb.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 
 #include <iostream>
@@ -32,7 +33,7 @@ void dibiff::effect::Reverb::initialize() {
     int delayLength;
     for (int i = 0; i < numDelays; ++i) {
         delayLength = static_cast<int>((roomSize / speedOfSound) * sampleRate) * (i + 1);
-        buffers.push_back(std::vector<float>(delayLength, 0.0f));
+        buffers.push_back(dibiff::util::HugeVector<float>(delayLength, 0.0f));
         bufferIndices.push_back(0);
     }
     feedback = std::pow(10, -3.0f * delayLength / (decayTime * sampleRate));
@@ -124,6 +125,49 @@ bool dibiff::effect::Reverb::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the reverb
+ * @return The reverb tail to -60 dB plus the longest delay line, in samples
+ */
+long dibiff::effect::Reverb::getStateMemory() const {
+    long longest = 0;
+    for (auto& buffer : buffers) {
+        longest = std::max(longest, static_cast<long>(buffer.size()));
+    }
+    return static_cast<long>(std::ceil(decayTime * sampleRate)) + longest;
+}
+/**
+ * @brief Save the runtime state of the reverb
+ * @return A versioned blob of the delay lines and their positions
+ */
+std::vector<unsigned char> dibiff::effect::Reverb::saveState() const {
+    dibiff::util::StateWriter writer("Reverb", 1);
+    writer.write(static_cast<std::uint64_t>(buffers.size()));
+    for (auto& buffer : buffers) {
+        writer.writeVector(buffer);
+    }
+    writer.writeVector(bufferIndices);
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the reverb
+ * @param state A blob returned by saveState()
+ */
+void dibiff::effect::Reverb::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "Reverb", 1);
+    if (reader.read<std::uint64_t>() != buffers.size()) {
+        throw std::runtime_error("State size mismatch.");
+    }
+    std::vector<dibiff::util::HugeVector<float>> lines(buffers.size());
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        lines[i].resize(buffers[i].size());
+        reader.readVector(lines[i]);
+    }
+    std::vector<int> indices(bufferIndices.size());
+    reader.readVector(indices);
+    buffers = std::move(lines);
+    bufferIndices = std::move(indices);
+}
 /**
  * Create a new reverb object
  * @param decayTime The decay time of the reverb in seconds
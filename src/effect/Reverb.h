@@ -4,6 +4,7 @@
 
 #include "effect.h"
 #include "../graph/graph.h"
+#include "../util/HugePages.h"
 
 /**
  * @brief Reverb
@@ -66,6 +67,21 @@ class dibiff::effect::Reverb : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the reverb
+         * @return The reverb tail to -60 dB plus the longest delay line, in samples
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the reverb
+         * @return A versioned blob of the delay lines and their positions
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the reverb
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * Create a new reverb object
          * @param decayTime The decay time of the reverb in seconds
@@ -83,6 +99,6 @@ class dibiff::effect::Reverb : public dibiff::graph::AudioObject {
         float feedback;
         int& numDelays;
         const float speedOfSound = 343.0f;
-        std::vector<std::vector<float>> buffers;
+        std::vector<dibiff::util::HugeVector<float>> buffers;
         std::vector<int> bufferIndices;
 };
\ No newline at end of file
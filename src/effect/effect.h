@@ -15,5 +15,6 @@ namespace dibiff {
         class Phaser;
         class Vibrato;
         class Tremolo;
+        class PitchShifter;
     }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 /// AdaptiveFilter.cpp
 
 #include "AdaptiveFilter.h"
+#include "../util/EventLog.h"
+#include "../util/SignalHealth.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 #include <numeric>
 
@@ -11,15 +14,17 @@
  * @param filterLength The length of the filter
  * @param stepSize The step size of the filter
  */
-dibiff::filter::AdaptiveFilter::AdaptiveFilter(int& filterLength, float& stepSize)
-: filterLength(filterLength), stepSize(stepSize), filterCoefficients(filterLength, 0.0f), buffer(filterLength, 0.0f) {
+template<typename SampleType, typename StateType>
+dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::BasicAdaptiveFilter(int& filterLength, float& stepSize)
+: filterLength(filterLength), stepSize(stepSize), filterCoefficients(filterLength, 0), buffer(filterLength, 0) {
     name = "AdaptiveFilter";
 };
 /**
  * @brief Initialize
  * @details Initializes the adaptive filter connection points
  */
-void dibiff::filter::AdaptiveFilter::initialize() {
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::initialize() {
     auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "AdaptiveFilterInput"));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
@@ -36,42 +41,40 @@ void dibiff::filter::AdaptiveFilter::initialize() {
  * @param sample The input sample
  * @param reference The reference sample
  */
-float dibiff::filter::AdaptiveFilter::process(float sample, float reference) {
+template<typename SampleType, typename StateType>
+SampleType dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::process(SampleType sample, SampleType reference) {
     // Shift the buffer
     std::copy(buffer.begin() + 1, buffer.end(), buffer.begin());
     buffer.back() = reference;
     // Compute the filter output
-    float output = 0.0f;
+    StateType output = 0;
     for (int i = 0; i < filterLength; ++i) {
         output += filterCoefficients[i] * buffer[i];
     }
     // Compute the error signal
-    float error = sample - output;
+    StateType error = sample - output;
     // Normalize the buffer to prevent large updates due to high signal power
-    float bufferNorm = std::inner_product(buffer.begin(), buffer.end(), buffer.begin(), 0.0f);
-    if (bufferNorm > 0.0f) {
+    StateType bufferNorm = std::inner_product(buffer.begin(), buffer.end(), buffer.begin(), StateType(0));
+    if (bufferNorm > 0) {
         bufferNorm = std::sqrt(bufferNorm);
     } else {
-        bufferNorm = 1.0f;  // Prevent division by zero
+        bufferNorm = 1;  // Prevent division by zero
     }
     // Update the filter coefficients using the LMS algorithm with gradient clipping
-    float maxUpdate = 0.1f;  // Maximum update to prevent large coefficient changes
+    const StateType maxUpdate = StateType(0.1);  // Maximum update to prevent large coefficient changes
     for (int i = 0; i < filterLength; ++i) {
-        float update = stepSize * error * buffer[i] / bufferNorm;
+        StateType update = stepSize * error * buffer[i] / bufferNorm;
         update = std::min(std::max(update, -maxUpdate), maxUpdate);  // Clip the update
         filterCoefficients[i] += update;
-        // Check for NaN and handle it
-        if (std::isnan(filterCoefficients[i])) {
-            filterCoefficients[i] = 0.0f;  // Reset the coefficient to zero if NaN is detected
-        }
     }
-    return error;
+    return static_cast<SampleType>(error);
 }
 /**
  * @brief Process a block of samples
  * @details Processes a block of audio data
  */
-void dibiff::filter::AdaptiveFilter::process() {
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::process() {
     if (!input->isConnected()) {
         /// If no input is connected, just dump zeros into the output
         const std::vector<float>& inData = input->getData();
@@ -89,7 +92,11 @@ void dibiff::filter::AdaptiveFilter::process() {
         const int inBlockSize = input->getBlockSize();
         const int refBlockSize = reference->getBlockSize();
         if (inBlockSize != refBlockSize) {
-            throw std::runtime_error("Block sizes do not match");
+            /// Pass the input through rather than fail on the audio thread
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Error, name.c_str(), "Block sizes do not match, bypassing", {static_cast<double>(inBlockSize), static_cast<double>(refBlockSize)});
+            output->setData(inData, inBlockSize);
+            markProcessed();
+            return;
         }
         Eigen::VectorXf x(inBlockSize), r(inBlockSize), y(inBlockSize);
         for (int i = 0; i < inBlockSize; ++i) {
@@ -97,43 +104,65 @@ void dibiff::filter::AdaptiveFilter::process() {
             r(i) = refData[i];
         }
         for (int i = 0; i < inBlockSize; ++i) {
-            y(i) = process(x(i), r(i));
+            y(i) = static_cast<float>(process(static_cast<SampleType>(x(i)), static_cast<SampleType>(r(i))));
         }
         std::vector<float> out(inBlockSize);
         for (int i = 0; i < inBlockSize; ++i) {
             out[i] = y(i);
         }
+        recoverDivergence(out.data(), out.size());
         output->setData(out, inBlockSize);
         markProcessed();
     }
 }
+/**
+ * @brief Recover from divergence
+ * @details One check per block instead of a branch per coefficient per sample
+ * @param out The samples produced since the last check
+ * @param count The number of samples
+ * @return True if the filter had diverged
+ */
+template<typename SampleType, typename StateType>
+bool dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::recoverDivergence(float* out, std::size_t count) {
+    if (Eigen::Map<const Eigen::Matrix<StateType, Eigen::Dynamic, 1>>(filterCoefficients.data(), filterLength).allFinite()) {
+        return false;
+    }
+    dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Warning, name.c_str(), "Filter diverged, resetting");
+    reset();
+    dibiff::util::SignalHealth::sanitize(out, count);
+    return true;
+}
 /**
  * @brief Reset the filter
  * @details Resets the filter coefficients and buffer
  */
-void dibiff::filter::AdaptiveFilter::reset() {
-    filterCoefficients = std::vector<float>(filterLength, 0.0f);
-    buffer = std::vector<float>(filterLength, 0.0f);
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::reset() {
+    filterCoefficients = std::vector<StateType>(filterLength, 0);
+    buffer = std::vector<StateType>(filterLength, 0);
 }
 /**
  * @brief Clear the filter
  * @details Clears the buffer
  */
-void dibiff::filter::AdaptiveFilter::clear() {
-    buffer = std::vector<float>(filterLength, 0.0f);
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::clear() {
+    buffer = std::vector<StateType>(filterLength, 0);
 }
 /**
  * @brief Check if the filter is finished processing
  * @return True if the filter is finished processing, false otherwise
  */
-bool dibiff::filter::AdaptiveFilter::isFinished() const {
+template<typename SampleType, typename StateType>
+bool dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::isFinished() const {
     return input->isConnected() && input->isReady() && input->isFinished() && reference->isConnected() && reference->isReady() && reference->isFinished() && processed;
 }
 /**
  * @brief Check if the filter is ready to process
  * @return True if the filter is ready to process, false otherwise
  */
-bool dibiff::filter::AdaptiveFilter::isReadyToProcess() const {
+template<typename SampleType, typename StateType>
+bool dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::isReadyToProcess() const {
         if (!reference->isConnected()) {
         return input->isConnected() && input->isReady() && !processed;
     } else if (!input->isConnected()) {
@@ -141,13 +170,51 @@ bool dibiff::filter::AdaptiveFilter::isReadyToProcess() const {
     }
     return input->isReady() && reference->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the adaptive filter
+ * @return -1, since the converged weights depend on the whole history
+ */
+template<typename SampleType, typename StateType>
+long dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::getStateMemory() const {
+    return -1;
+}
+/**
+ * @brief Save the runtime state of the adaptive filter
+ * @return A versioned blob of the filter coefficients and history
+ */
+template<typename SampleType, typename StateType>
+std::vector<unsigned char> dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::saveState() const {
+    dibiff::util::StateWriter writer("AdaptiveFilter", 1);
+    writer.writeVector(filterCoefficients);
+    writer.writeVector(buffer);
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the adaptive filter
+ * @param state A blob returned by saveState()
+ */
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "AdaptiveFilter", 1);
+    std::vector<StateType> coefficients(filterCoefficients.size());
+    std::vector<StateType> history(buffer.size());
+    reader.readVector(coefficients);
+    reader.readVector(history);
+    filterCoefficients = std::move(coefficients);
+    buffer = std::move(history);
+}
 /**
  * Create a new adaptive filter object
  * @param filterLength The length of the filter
  * @param stepSize The step size of the filter
  */
-std::unique_ptr<dibiff::filter::AdaptiveFilter> dibiff::filter::AdaptiveFilter::create(int& filterLength, float& stepSize) {
-    auto instance = std::make_unique<dibiff::filter::AdaptiveFilter>(filterLength, stepSize);
+template<typename SampleType, typename StateType>
+std::unique_ptr<dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>> dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>::create(int& filterLength, float& stepSize) {
+    auto instance = std::make_unique<dibiff::filter::BasicAdaptiveFilter<SampleType, StateType>>(filterLength, stepSize);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicAdaptiveFilter<float, float>;
+template class dibiff::filter::BasicAdaptiveFilter<float, double>;
+template class dibiff::filter::BasicAdaptiveFilter<double, double>;
\ No newline at end of file
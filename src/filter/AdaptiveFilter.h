@@ -12,8 +12,12 @@
  * and echo cancellation applications.
  * @param filterLength The length of the filter
  * @param stepSize The step size of the filter
+ * @tparam SampleType The type of the samples passed to process(sample, reference)
+ * @tparam StateType The type of the filter coefficients and history, double keeps
+ * long filters from losing precision
  */
-class dibiff::filter::AdaptiveFilter : public dibiff::graph::AudioObject {
+template<typename SampleType, typename StateType>
+class dibiff::filter::BasicAdaptiveFilter : public dibiff::graph::AudioObject {
     public: 
         dibiff::graph::AudioInput* input;
         dibiff::graph::AudioInput* reference;
@@ -25,7 +29,7 @@ class dibiff::filter::AdaptiveFilter : public dibiff::graph::AudioObject {
          * @param filterLength The length of the filter
          * @param stepSize The step size of the filter
          */
-        AdaptiveFilter(int& filterLength, float& stepSize);
+        BasicAdaptiveFilter(int& filterLength, float& stepSize);
         /**
          * @brief Initialize
          * @details Initializes the adaptive filter connection points
@@ -37,12 +41,22 @@ class dibiff::filter::AdaptiveFilter : public dibiff::graph::AudioObject {
          * @param sample The input sample
          * @param reference The reference sample
          */
-        float process(float sample, float reference);
+        SampleType process(SampleType sample, SampleType reference);
         /**
          * @brief Process a block of samples
          * @details Processes a block of audio data
          */
         void process() override;
+        /**
+         * @brief Recover from divergence
+         * @details Call after a run of per-sample process() calls, such as a block. If a
+         * coefficient is no longer finite, the filter is reset and the samples produced
+         * since the last check are sanitized.
+         * @param out The samples produced since the last check
+         * @param count The number of samples
+         * @return True if the filter had diverged
+         */
+        bool recoverDivergence(float* out, std::size_t count);
         /**
          * @brief Reset the filter
          * @details Resets the filter coefficients and buffer
@@ -63,15 +77,30 @@ class dibiff::filter::AdaptiveFilter : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the adaptive filter
+         * @return -1, since the converged weights depend on the whole history
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the adaptive filter
+         * @return A versioned blob of the filter coefficients and history
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the adaptive filter
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * Create a new adaptive filter object
          * @param filterLength The length of the filter
          * @param stepSize The step size of the filter
          */
-        static std::unique_ptr<AdaptiveFilter> create(int& filterLength, float& stepSize);
+        static std::unique_ptr<BasicAdaptiveFilter> create(int& filterLength, float& stepSize);
     private:
         int& filterLength;
         float& stepSize;
-        std::vector<float> filterCoefficients;
-        std::vector<float> buffer;
+        std::vector<StateType> filterCoefficients;
+        std::vector<StateType> buffer;
 };
\ No newline at end of file
@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::AllPassFilter::AllPassFilter(float& cutoff, float& sampleRate, float& qFactor) 
+template<typename StateType>
+dibiff::filter::BasicAllPassFilter<StateType>::BasicAllPassFilter(float& cutoff, float& sampleRate, float& qFactor) 
 : _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "AllPassFilter";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "AllPassFilter";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 
 /**
@@ -21,19 +22,21 @@ dibiff::filter::AllPassFilter::AllPassFilter(float& cutoff, float& sampleRate, f
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::AllPassFilter::calculateCoefficients() {
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b0 = 1.0f - alpha;
-    float b1 = -2.0f * std::cos(w0);
-    float b2 = 1.0f + alpha;
-    coeffs = dibiff::filter::Coefficients{b0, b1, b2, b2, b1, b0};
+template<typename StateType>
+void dibiff::filter::BasicAllPassFilter<StateType>::calculateCoefficients() {
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b0 = 1.0f - alpha;
+    StateType b1 = -2.0f * std::cos(w0);
+    StateType b2 = 1.0f + alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, b1, b2, b2, b1, b0};
 }
 /**
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::AllPassFilter::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicAllPassFilter<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -41,7 +44,8 @@ void dibiff::filter::AllPassFilter::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::AllPassFilter::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicAllPassFilter<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -49,7 +53,8 @@ void dibiff::filter::AllPassFilter::setSampleRate(float sampleRate) {
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::AllPassFilter::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicAllPassFilter<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -57,7 +62,8 @@ void dibiff::filter::AllPassFilter::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter 
  */
-void dibiff::filter::AllPassFilter::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicAllPassFilter<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -68,8 +74,12 @@ void dibiff::filter::AllPassFilter::setBandwidth(float bandwidth) {
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::AllPassFilter> dibiff::filter::AllPassFilter::create(float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::AllPassFilter>(cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicAllPassFilter<StateType>> dibiff::filter::BasicAllPassFilter<StateType>::create(float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicAllPassFilter<StateType>>(cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicAllPassFilter<float>;
+template class dibiff::filter::BasicAllPassFilter<double>;
\ No newline at end of file
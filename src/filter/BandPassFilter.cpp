@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::BandPassFilterConstantSkirtGain::BandPassFilterConstantSkirtGain(float& cutoff, float& sampleRate, float& qFactor)
+template<typename StateType>
+dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::BasicBandPassFilterConstantSkirtGain(float& cutoff, float& sampleRate, float& qFactor)
 : _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "BandPassFilterConstantSkirtGain";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "BandPassFilterConstantSkirtGain";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -20,20 +21,22 @@ dibiff::filter::BandPassFilterConstantSkirtGain::BandPassFilterConstantSkirtGain
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::BandPassFilterConstantSkirtGain::calculateCoefficients() {
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b0 = _qFactor * alpha;
-    float a0 = 1 + alpha;
-    float a1 = -2.0f * std::cos(w0);
-    float a2 = 1 - alpha;
-    coeffs = dibiff::filter::Coefficients{b0, 0.0f, -b0, a0, a1, a0};
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::calculateCoefficients() {
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b0 = _qFactor * alpha;
+    StateType a0 = 1 + alpha;
+    StateType a1 = -2.0f * std::cos(w0);
+    StateType a2 = 1 - alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, 0.0f, -b0, a0, a1, a0};
 }
 /**
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::BandPassFilterConstantSkirtGain::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -41,7 +44,8 @@ void dibiff::filter::BandPassFilterConstantSkirtGain::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::BandPassFilterConstantSkirtGain::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -49,7 +53,8 @@ void dibiff::filter::BandPassFilterConstantSkirtGain::setSampleRate(float sample
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::BandPassFilterConstantSkirtGain::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -57,7 +62,8 @@ void dibiff::filter::BandPassFilterConstantSkirtGain::setQFactor(float qFactor)
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::BandPassFilterConstantSkirtGain::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -68,8 +74,9 @@ void dibiff::filter::BandPassFilterConstantSkirtGain::setBandwidth(float bandwid
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::BandPassFilterConstantSkirtGain> dibiff::filter::BandPassFilterConstantSkirtGain::create(float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::BandPassFilterConstantSkirtGain>(cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>> dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>::create(float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicBandPassFilterConstantSkirtGain<StateType>>(cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
 }
@@ -78,12 +85,13 @@ std::unique_ptr<dibiff::filter::BandPassFilterConstantSkirtGain> dibiff::filter:
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::BandPassFilterConstantPeakGain::BandPassFilterConstantPeakGain(float& cutoff, float& sampleRate, float& qFactor)
+template<typename StateType>
+dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::BasicBandPassFilterConstantPeakGain(float& cutoff, float& sampleRate, float& qFactor)
 : _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "BandPassFilterConstantPeakGain";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "BandPassFilterConstantPeakGain";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -92,20 +100,22 @@ dibiff::filter::BandPassFilterConstantPeakGain::BandPassFilterConstantPeakGain(f
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::BandPassFilterConstantPeakGain::calculateCoefficients() {
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b0 = alpha;
-    float a0 = 1 + alpha;
-    float a1 = -2.0f * std::cos(w0);
-    float a2 = 1 - alpha;
-    coeffs = dibiff::filter::Coefficients{b0, 0.0f, -b0, a0, a1, a2};
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::calculateCoefficients() {
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b0 = alpha;
+    StateType a0 = 1 + alpha;
+    StateType a1 = -2.0f * std::cos(w0);
+    StateType a2 = 1 - alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, 0.0f, -b0, a0, a1, a2};
 }
 /**
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::BandPassFilterConstantPeakGain::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -113,7 +123,8 @@ void dibiff::filter::BandPassFilterConstantPeakGain::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::BandPassFilterConstantPeakGain::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -121,7 +132,8 @@ void dibiff::filter::BandPassFilterConstantPeakGain::setSampleRate(float sampleR
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::BandPassFilterConstantPeakGain::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -129,7 +141,8 @@ void dibiff::filter::BandPassFilterConstantPeakGain::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::BandPassFilterConstantPeakGain::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -140,8 +153,14 @@ void dibiff::filter::BandPassFilterConstantPeakGain::setBandwidth(float bandwidt
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::BandPassFilterConstantPeakGain> dibiff::filter::BandPassFilterConstantPeakGain::create(float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::BandPassFilterConstantPeakGain>(cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>> dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>::create(float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicBandPassFilterConstantPeakGain<StateType>>(cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicBandPassFilterConstantSkirtGain<float>;
+template class dibiff::filter::BasicBandPassFilterConstantSkirtGain<double>;
+template class dibiff::filter::BasicBandPassFilterConstantPeakGain<float>;
+template class dibiff::filter::BasicBandPassFilterConstantPeakGain<double>;
\ No newline at end of file
@@ -15,14 +15,16 @@
  * @param qFactor The quality factor of the filter, default value is 0.7071067811865476, or 1/sqrt(2)
  * @return A band pass filter object
  * @see DigitalBiquadFilter
+ * @tparam StateType The type of the coefficients and the filter state, float or double
  */
-class dibiff::filter::BandPassFilterConstantSkirtGain : public dibiff::filter::DigitalBiquadFilter {
+template<typename StateType>
+class dibiff::filter::BasicBandPassFilterConstantSkirtGain : public dibiff::filter::BasicDigitalBiquadFilter<float, StateType> {
     public:
         /**
          * @brief Constructor
          * @details Initializes the filter with default values
          */
-        BandPassFilterConstantSkirtGain(float& cutoff, float& sampleRate, float& qFactor);
+        BasicBandPassFilterConstantSkirtGain(float& cutoff, float& sampleRate, float& qFactor);
         /**
          * @brief Calculate the filter coefficients
          * @details Calculates the filter coefficients based on the cutoff frequency, sample rate, and quality factor
@@ -58,12 +60,12 @@ class dibiff::filter::BandPassFilterConstantSkirtGain : public dibiff::filter::D
          * @param sampleRate The sample rate of the input signal
          * @param qFactor The quality factor of the filter
          */
-        static std::unique_ptr<BandPassFilterConstantSkirtGain> create(float& cutoff, float& sampleRate, float& qFactor);
+        static std::unique_ptr<BasicBandPassFilterConstantSkirtGain> create(float& cutoff, float& sampleRate, float& qFactor);
     private:
         float& _cutoff;
         float& _sampleRate;
         float& _qFactor;
-        dibiff::filter::Coefficients coeffs;
+        dibiff::filter::BasicCoefficients<StateType> coeffs;
 };
 /**
  * @brief Band Pass Filter
@@ -75,14 +77,16 @@ class dibiff::filter::BandPassFilterConstantSkirtGain : public dibiff::filter::D
  * @param qFactor The quality factor of the filter, default value is 0.7071067811865476, or 1/sqrt(2)
  * @return A band pass filter object
  * @see DigitalBiquadFilter
+ * @tparam StateType The type of the coefficients and the filter state, float or double
  */
-class dibiff::filter::BandPassFilterConstantPeakGain : public dibiff::filter::DigitalBiquadFilter {
+template<typename StateType>
+class dibiff::filter::BasicBandPassFilterConstantPeakGain : public dibiff::filter::BasicDigitalBiquadFilter<float, StateType> {
     public:
         /**
          * @brief Constructor
          * @details Initializes the filter with default values
          */
-        BandPassFilterConstantPeakGain(float& cutoff, float& sampleRate, float& qFactor);
+        BasicBandPassFilterConstantPeakGain(float& cutoff, float& sampleRate, float& qFactor);
         /**
          * @brief Calculate the filter coefficients
          * @details Calculates the filter coefficients based on the cutoff frequency, sample rate, and quality factor
@@ -118,10 +122,10 @@ class dibiff::filter::BandPassFilterConstantPeakGain : public dibiff::filter::Di
          * @param sampleRate The sample rate of the input signal
          * @param qFactor The quality factor of the filter
          */
-        static std::unique_ptr<BandPassFilterConstantPeakGain> create(float& cutoff, float& sampleRate, float& qFactor);
+        static std::unique_ptr<BasicBandPassFilterConstantPeakGain> create(float& cutoff, float& sampleRate, float& qFactor);
     private:
         float& _cutoff;
         float& _sampleRate;
         float& _qFactor;
-        dibiff::filter::Coefficients coeffs;
+        dibiff::filter::BasicCoefficients<StateType> coeffs;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 /// DigitalBiquadFilter.cpp
 
 #include "DigitalBiquadFilter.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 
 /**
@@ -11,7 +12,8 @@
  * @see reset
  * @see dibiff::Coefficients
  */
-dibiff::filter::DigitalBiquadFilter::DigitalBiquadFilter(dibiff::filter::Coefficients* coeffs) 
+template<typename SampleType, typename StateType>
+dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::BasicDigitalBiquadFilter(dibiff::filter::BasicCoefficients<StateType>* coeffs) 
 : dibiff::graph::AudioObject(), _coeffs(coeffs) {
     name = "DigitalBiquadFilter";
     reset();
@@ -20,8 +22,9 @@ dibiff::filter::DigitalBiquadFilter::DigitalBiquadFilter(dibiff::filter::Coeffic
  * @brief Initialize
  * @details Initializes the filter state variables and connection points
  */
-void dibiff::filter::DigitalBiquadFilter::initialize() {
-    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "DigitalBiquadFilterInput"));
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::initialize() {
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "DigitalBiquadFilterInput", 0));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
     auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "DigitalBiquadFilterOutput"));
@@ -38,41 +41,61 @@ void dibiff::filter::DigitalBiquadFilter::initialize() {
  * @brief Process a sample
  * @details Processes a single sample of audio data
  * @param sample The input sample
+ * @param channel The channel whose filter state is used
  */
-float dibiff::filter::DigitalBiquadFilter::process(float sample) {
-    float output = ((_coeffs->b0 / _coeffs->a0) * sample) + ((_coeffs->b1 / _coeffs->a0) * x1) + ((_coeffs->b2 / _coeffs->a0) * x2) - ((_coeffs->a1 / _coeffs->a0) * y1) - ((_coeffs->a2 / _coeffs->a0) * y2);
-    x2 = x1;
-    x1 = sample;
-    y2 = y1;
-    y1 = output;
+template<typename SampleType, typename StateType>
+SampleType dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::process(SampleType sample, int channel) {
+    State& s = state[channel];
+    const StateType a0 = _coeffs->a0;
+    const StateType x = sample;
+    StateType output = ((_coeffs->b0 / a0) * x) + ((_coeffs->b1 / a0) * s.x1) + ((_coeffs->b2 / a0) * s.x2) - ((_coeffs->a1 / a0) * s.y1) - ((_coeffs->a2 / a0) * s.y2);
+    s.x2 = s.x1;
+    s.x1 = x;
+    s.y2 = s.y1;
+    s.y1 = output;
     iter++;
-    return output;
+    return static_cast<SampleType>(output);
 }
 /**
  * @brief Process a block of samples
- * @details Processes a block of samples of audio data
+ * @details Processes a block of samples of audio data, filtering every
+ * channel of the input with its own state
  */
-void dibiff::filter::DigitalBiquadFilter::process() {
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::process() {
     if (!input->isConnected()) {
         /// If no input is connected, just dump zeros into the output
         std::vector<float> out(input->getBlockSize(), 0.0f);
         output->setData(out, input->getBlockSize());
         markProcessed();
     } else if (input->isReady()) {
-        const std::vector<float>& data = input->getData();
         const int blockSize = input->getBlockSize();
-        Eigen::VectorXf x(blockSize), y(blockSize);
-        for (int i = 0; i < blockSize; ++i) {
-            x(i) = data[i];
+        const int channels = input->getChannels();
+        if (static_cast<int>(state.size()) != channels) {
+            state.resize(channels);
         }
-        for (int i = 0; i < blockSize; ++i) {
-            y(i) = process(x(i));
+        /// Normalize the coefficients once per block
+        const StateType a0 = _coeffs->a0;
+        const StateType b0 = _coeffs->b0 / a0, b1 = _coeffs->b1 / a0, b2 = _coeffs->b2 / a0;
+        const StateType a1 = _coeffs->a1 / a0, a2 = _coeffs->a2 / a0;
+        std::vector<float> out(static_cast<std::size_t>(blockSize) * channels);
+        for (int c = 0; c < channels; ++c) {
+            const float* x = input->getChannel(c);
+            float* y = out.data() + static_cast<std::size_t>(c) * blockSize;
+            State s = state[c];
+            for (int i = 0; i < blockSize; ++i) {
+                const StateType xn = x[i];
+                const StateType yn = b0 * xn + b1 * s.x1 + b2 * s.x2 - a1 * s.y1 - a2 * s.y2;
+                s.x2 = s.x1;
+                s.x1 = xn;
+                s.y2 = s.y1;
+                s.y1 = yn;
+                y[i] = static_cast<float>(yn);
+            }
+            state[c] = s;
         }
-        std::vector<float> out(blockSize);
-        for (int i = 0; i < blockSize; ++i) {
-            out[i] = y(i);
-        }
-        output->setData(out, blockSize);
+        iter += blockSize;
+        output->setData(std::move(out), blockSize, channels);
         markProcessed();
     }
 }
@@ -83,7 +106,8 @@ void dibiff::filter::DigitalBiquadFilter::process() {
  * b0, b1 b2, a0, a1, a2
  * @see dibiff::Coefficients 
  */
-void dibiff::filter::DigitalBiquadFilter::setCoefficients(dibiff::filter::Coefficients* coeffs) {
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::setCoefficients(dibiff::filter::BasicCoefficients<StateType>* coeffs) {
     _coeffs = coeffs;
     reset();
 }
@@ -91,38 +115,96 @@ void dibiff::filter::DigitalBiquadFilter::setCoefficients(dibiff::filter::Coeffi
  * @brief Reset the filter
  * @details Resets the filter state variables
  */
-void dibiff::filter::DigitalBiquadFilter::reset() {
-    x1 = 0;
-    x2 = 0;
-    y1 = 0;
-    y2 = 0;
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::reset() {
+    std::fill(state.begin(), state.end(), State());
     iter = 0;
 }
 /**
  * @brief Check if the filter is finished processing
  * @return True if the filter is finished processing, false otherwise
  */
-bool dibiff::filter::DigitalBiquadFilter::isFinished() const {
+template<typename SampleType, typename StateType>
+bool dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::isFinished() const {
     return input->isConnected() && input->isReady() && input->isFinished() && processed;
 }
 /**
  * @brief Check if the filter is ready to process
  * @return True if the filter is ready to process, false otherwise
  */
-bool dibiff::filter::DigitalBiquadFilter::isReadyToProcess() const {
+template<typename SampleType, typename StateType>
+bool dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::isReadyToProcess() const {
     if (!input->isConnected()) {
         return true;
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the filter
+ * @details Finds the largest pole radius r of the normalized denominator
+ * z^2 + a1 z + a2, and returns the number of samples for r^n to fall below -80 dB
+ * @return The settling time of the impulse response to -80 dB in samples, or -1 if the filter is unstable
+ */
+template<typename SampleType, typename StateType>
+long dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::getStateMemory() const {
+    const double a1 = static_cast<double>(_coeffs->a1) / _coeffs->a0;
+    const double a2 = static_cast<double>(_coeffs->a2) / _coeffs->a0;
+    const double disc = a1 * a1 - 4.0 * a2;
+    double radius;
+    if (disc < 0.0) {
+        /// Complex conjugate poles share the radius sqrt(a2)
+        radius = std::sqrt(a2);
+    } else {
+        const double root = std::sqrt(disc);
+        radius = std::max(std::abs(-a1 + root), std::abs(-a1 - root)) / 2.0;
+    }
+    if (radius >= 1.0) {
+        return -1;
+    }
+    if (radius == 0.0) {
+        return 2;
+    }
+    return static_cast<long>(std::ceil(std::log(1.0e-4) / std::log(radius))) + 2;
+}
+/**
+ * @brief Save the runtime state of the filter
+ * @return A versioned blob of the filter state of every channel
+ */
+template<typename SampleType, typename StateType>
+std::vector<unsigned char> dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::saveState() const {
+    dibiff::util::StateWriter writer("DigitalBiquadFilter", 1);
+    writer.write(static_cast<std::uint64_t>(state.size()));
+    writer.writeVector(state);
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the filter
+ * @param state A blob returned by saveState()
+ */
+template<typename SampleType, typename StateType>
+void dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::restoreState(const std::vector<unsigned char>& blob) {
+    dibiff::util::StateReader reader(blob, "DigitalBiquadFilter", 1);
+    const std::uint64_t count = reader.read<std::uint64_t>();
+    /// Sized by the bytes in the blob rather than by the count, which is only checked
+    std::vector<State> channels = reader.readVector<State>();
+    if (channels.size() != count) {
+        throw std::runtime_error("State size mismatch.");
+    }
+    state = std::move(channels);
+}
 /**
  * @brief Create a new filter object
  * @details Creates a new filter object with custom coefficients
  * @param coeffs A dibiff::Coefficients struct containing the filter coefficients:
  * b0, b1 b2, a0, a1, a2
  */
-std::unique_ptr<dibiff::filter::DigitalBiquadFilter> dibiff::filter::DigitalBiquadFilter::create(dibiff::filter::Coefficients* coeffs) {
-    auto instance = std::make_unique<DigitalBiquadFilter>(coeffs);
+template<typename SampleType, typename StateType>
+std::unique_ptr<dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>> dibiff::filter::BasicDigitalBiquadFilter<SampleType, StateType>::create(dibiff::filter::BasicCoefficients<StateType>* coeffs) {
+    auto instance = std::make_unique<BasicDigitalBiquadFilter>(coeffs);
     instance->initialize();
     return std::move(instance);
-} 
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicDigitalBiquadFilter<float, float>;
+template class dibiff::filter::BasicDigitalBiquadFilter<float, double>;
+template class dibiff::filter::BasicDigitalBiquadFilter<double, double>; 
\ No newline at end of file
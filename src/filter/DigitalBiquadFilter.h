@@ -12,8 +12,13 @@
  * H(z) = (b0 + b1*z^-1 + b2*z^-2) / (a0 + a1*z^-1 + a2*z^-2)
  * The filter is implemented by applying the following difference equation:
  * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ * The sample and state types are chosen at compile time, so low-frequency filters
+ * can keep double-precision state while the rest of the graph stays in float.
+ * @tparam SampleType The type of the samples passed to process(sample)
+ * @tparam StateType The type of the coefficients and the filter state
  */
-class dibiff::filter::DigitalBiquadFilter : public dibiff::graph::AudioObject {
+template<typename SampleType, typename StateType>
+class dibiff::filter::BasicDigitalBiquadFilter : public dibiff::graph::AudioObject {
     public: 
         dibiff::graph::AudioInput* input;
         dibiff::graph::AudioOutput* output;
@@ -25,7 +30,7 @@ class dibiff::filter::DigitalBiquadFilter : public dibiff::graph::AudioObject {
          * @see reset
          * @see dibiff::Coefficients
          */
-        DigitalBiquadFilter(dibiff::filter::Coefficients* coeffs);
+        BasicDigitalBiquadFilter(dibiff::filter::BasicCoefficients<StateType>* coeffs);
         /**
          * @brief Initialize
          * @details Initializes the filter state variables and connection points
@@ -35,11 +40,13 @@ class dibiff::filter::DigitalBiquadFilter : public dibiff::graph::AudioObject {
          * @brief Process a sample
          * @details Processes a single sample of audio data
          * @param sample The input sample
+         * @param channel The channel whose filter state is used
          */
-        float process(float sample);
+        SampleType process(SampleType sample, int channel = 0);
         /**
          * @brief Process a block of samples
-         * @details Processes a block of samples of audio data
+         * @details Processes a block of samples of audio data, filtering every
+         * channel of the input with its own state
          */
         void process() override;
         /**
@@ -49,7 +56,7 @@ class dibiff::filter::DigitalBiquadFilter : public dibiff::graph::AudioObject {
          * b0, b1 b2, a0, a1, a2
          * @see dibiff::Coefficients 
          */
-        void setCoefficients(dibiff::filter::Coefficients* coeffs);
+        void setCoefficients(dibiff::filter::BasicCoefficients<StateType>* coeffs);
         /**
          * @brief Reset the filter
          * @details Resets the filter state variables
@@ -70,20 +77,41 @@ class dibiff::filter::DigitalBiquadFilter : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the filter
+         * @return The settling time of the impulse response to -80 dB in samples, or -1 if the filter is unstable
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the filter
+         * @return A versioned blob of the filter state of every channel
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the filter
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * @brief Create a new filter object
          * @details Creates a new filter object with custom coefficients
          * @param coeffs A dibiff::Coefficients struct containing the filter coefficients:
          * b0, b1 b2, a0, a1, a2
          */
-        static std::unique_ptr<DigitalBiquadFilter> create(dibiff::filter::Coefficients* coeffs);
+        static std::unique_ptr<BasicDigitalBiquadFilter> create(dibiff::filter::BasicCoefficients<StateType>* coeffs);
         /**
          * @brief Destructor
          * @details Destroys the filter object
          */
-        ~DigitalBiquadFilter() {};
+        ~BasicDigitalBiquadFilter() {};
     protected:
-        dibiff::filter::Coefficients* _coeffs;
-        float x1, x2, y1, y2;
+        /**
+         * @brief Filter state of a single channel
+         */
+        struct State {
+            StateType x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        };
+        dibiff::filter::BasicCoefficients<StateType>* _coeffs;
+        std::vector<State> state = std::vector<State>(1);
         long int iter;
 };
\ No newline at end of file
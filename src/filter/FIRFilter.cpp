@@ -0,0 +1,616 @@
+/// FIRFilter.cpp
+
+#include "FIRFilter.h"
+#include "../util/EventLog.h"
+#include "../util/FFT.h"
+#include "../util/StateBlob.h"
+#include "../inc/Eigen/Dense"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace {
+#ifdef __AVX2__
+    /// a * b + c, fused when the build enables FMA
+    inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 c) {
+#ifdef __FMA__
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+#endif
+    /// The zeroth-order modified Bessel function of the first kind, for the Kaiser window
+    double besselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+    /// The answers of FIRFilter::isPartitionedFaster(), shared by every filter
+    struct Timings {
+        std::mutex mutex;
+        std::map<std::pair<int, int>, bool> table;
+    };
+    Timings& getTimings() {
+        static Timings timings;
+        return timings;
+    }
+}
+
+/**
+ * @brief Constructor
+ * @param taps The impulse response of the filter, h[0] first
+ */
+dibiff::filter::FIRFilter::FIRFilter(std::vector<float> taps)
+: dibiff::graph::AudioObject() {
+    name = "FIRFilter";
+    setTaps(std::move(taps));
+}
+/**
+ * @brief Initialize
+ * @details Initializes the filter connection points
+ */
+void dibiff::filter::FIRFilter::initialize() {
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "FIRFilterInput", 0));
+    _inputs.emplace_back(std::move(i));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+    auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "FIRFilterOutput"));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+}
+/**
+ * @brief Process a block of samples
+ * @details Appends the block to the history of each channel, filters it and keeps the
+ * last N-1 samples for the next block. The history is kept up to date when the filter
+ * is partitioned too, so it can switch back to direct form at any block.
+ */
+void dibiff::filter::FIRFilter::process() {
+    if (!input->isConnected()) {
+        /// If no input is connected, just dump zeros into the output
+        std::vector<float> out(input->getBlockSize(), 0.0f);
+        output->setData(out, input->getBlockSize());
+        markProcessed();
+    } else if (input->isReady()) {
+        const int n = input->getBlockSize();
+        const int channels = input->getChannels();
+        if (static_cast<int>(history.size()) != channels || n > blockSize) {
+            /// Never timed here: an unannounced layout uses what is already known
+            resize(channels, std::max(n, blockSize), false);
+        }
+        const int length = static_cast<int>(taps.size());
+        /// A shorter block, such as the last one, goes through direct form
+        const bool partitioned = !convolutions.empty() && n == blockSize;
+        std::vector<float> out(static_cast<std::size_t>(n) * channels);
+        for (int c = 0; c < channels; ++c) {
+            const float* x = input->getChannel(c);
+            float* h = history[c].data();
+            float* y = out.data() + static_cast<std::size_t>(c) * n;
+            std::copy(x, x + n, h + length - 1);
+            if (partitioned) {
+                convolutions[c]->process(x, y);
+            } else {
+                convolve(reversed.data(), length, h, y, n);
+            }
+            std::copy(h + n, h + n + length - 1, h);
+            if (!partitioned && !convolutions.empty()) {
+                convolutions[c]->prime(h, length - 1);
+            }
+        }
+        output->setData(std::move(out), n, channels);
+        markProcessed();
+    }
+}
+/**
+ * @brief Filter a block of one channel
+ * @details With AVX2, output i is the sum over k of taps[k] * history[i + k], so eight
+ * consecutive outputs share a broadcast tap and an unaligned load of eight history
+ * samples. Four groups of eight are accumulated at once to hide the latency of the
+ * multiply-adds, then single groups, then the remaining outputs one at a time.
+ * @param taps The impulse response reversed, h[N-1] first
+ * @param length The number of taps N
+ * @param history The history of the channel, taps + n - 1 samples
+ * @param out The output, n samples
+ * @param n The number of samples
+ */
+void dibiff::filter::FIRFilter::convolve(const float* taps, int length, const float* history, float* out, int n) {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 32 <= n; i += 32) {
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps(), a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+        const float* x = history + i;
+        for (int k = 0; k < length; ++k) {
+            const __m256 h = _mm256_broadcast_ss(taps + k);
+            a0 = multiplyAdd(h, _mm256_loadu_ps(x + k), a0);
+            a1 = multiplyAdd(h, _mm256_loadu_ps(x + k + 8), a1);
+            a2 = multiplyAdd(h, _mm256_loadu_ps(x + k + 16), a2);
+            a3 = multiplyAdd(h, _mm256_loadu_ps(x + k + 24), a3);
+        }
+        _mm256_storeu_ps(out + i, a0);
+        _mm256_storeu_ps(out + i + 8, a1);
+        _mm256_storeu_ps(out + i + 16, a2);
+        _mm256_storeu_ps(out + i + 24, a3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 a = _mm256_setzero_ps();
+        const float* x = history + i;
+        for (int k = 0; k < length; ++k) {
+            a = multiplyAdd(_mm256_broadcast_ss(taps + k), _mm256_loadu_ps(x + k), a);
+        }
+        _mm256_storeu_ps(out + i, a);
+    }
+#endif
+    for (; i < n; ++i) {
+        float y = 0.0f;
+        const float* x = history + i;
+        for (int k = 0; k < length; ++k) {
+            y += taps[k] * x[k];
+        }
+        out[i] = y;
+    }
+}
+/**
+ * @brief Set the impulse response
+ * @details Keeps the most recent samples of the history that the new kernel reaches
+ * @param newTaps The impulse response of the filter, h[0] first
+ */
+void dibiff::filter::FIRFilter::setTaps(std::vector<float> newTaps) {
+    if (newTaps.empty()) {
+        throw std::runtime_error("An FIR filter needs at least one tap.");
+    }
+    const int oldLength = static_cast<int>(taps.size());
+    const int length = static_cast<int>(newTaps.size());
+    if (length != oldLength) {
+        for (auto& h : history) {
+            std::vector<float> state(static_cast<std::size_t>(length - 1 + blockSize), 0.0f);
+            const int kept = std::min(std::max(oldLength - 1, 0), length - 1);
+            if (kept > 0) {
+                std::copy(h.begin() + (oldLength - 1 - kept), h.begin() + (oldLength - 1), state.begin() + (length - 1 - kept));
+            }
+            h = std::move(state);
+        }
+    }
+    taps = std::move(newTaps);
+    reversed.assign(taps.rbegin(), taps.rend());
+    configure(true);
+}
+/**
+ * @brief Set how the filter is applied
+ * @param mode The mode
+ */
+void dibiff::filter::FIRFilter::setMode(Mode mode) {
+    this->mode = mode;
+    configure(true);
+}
+/**
+ * @brief Reset the filter
+ * @details Clears the history
+ */
+void dibiff::filter::FIRFilter::reset() {
+    clear();
+}
+/**
+ * @brief Clear the filter
+ * @details Clears the history
+ */
+void dibiff::filter::FIRFilter::clear() {
+    for (auto& h : history) {
+        std::fill(h.begin(), h.end(), 0.0f);
+    }
+    for (auto& convolution : convolutions) {
+        convolution->reset();
+    }
+}
+/**
+ * @brief Check if the filter is finished processing
+ * @return True if the filter is finished processing, false otherwise
+ */
+bool dibiff::filter::FIRFilter::isFinished() const {
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
+}
+/**
+ * @brief Check if the filter is ready to process
+ * @return True if the filter is ready to process, false otherwise
+ */
+bool dibiff::filter::FIRFilter::isReadyToProcess() const {
+    if (!input->isConnected()) {
+        return true;
+    }
+    return input->isReady() && !processed;
+}
+/**
+ * @brief Get the state memory of the filter
+ * @return The length of the impulse response in samples
+ */
+long dibiff::filter::FIRFilter::getStateMemory() const {
+    return static_cast<long>(taps.size());
+}
+/**
+ * @brief Save the runtime state of the filter
+ * @return A versioned blob of the history of every channel
+ */
+std::vector<unsigned char> dibiff::filter::FIRFilter::saveState() const {
+    dibiff::util::StateWriter writer("FIRFilter", 1);
+    writer.write(static_cast<std::uint64_t>(history.size()));
+    for (const auto& h : history) {
+        writer.writeArray(h.data(), taps.size() - 1);
+    }
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the filter
+ * @param state A blob returned by saveState()
+ */
+void dibiff::filter::FIRFilter::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "FIRFilter", 1);
+    const std::uint64_t channels = reader.read<std::uint64_t>();
+    /// Grown one saved channel at a time, so a corrupt count runs out of blob before it
+    /// can ask for a large allocation
+    std::vector<std::vector<float>> restored;
+    for (std::uint64_t c = 0; c < channels; ++c) {
+        std::vector<float> h = reader.readVector<float>();
+        if (h.size() != taps.size() - 1) {
+            throw std::runtime_error("State size mismatch.");
+        }
+        h.resize(taps.size() - 1 + blockSize, 0.0f);
+        restored.push_back(std::move(h));
+    }
+    history = std::move(restored);
+    configure(true);
+}
+/**
+ * @brief Set the block size
+ * @details Resizes the history buffers and times the new configuration ahead of the
+ * first block of the new size
+ * @param blockSize The new block size
+ */
+void dibiff::filter::FIRFilter::setBlockSize(int blockSize) {
+    resize(static_cast<int>(history.size()), blockSize, true);
+}
+/**
+ * @brief Set the number of channels
+ * @details Sizes the history and builds the convolutions of every channel ahead of the
+ * first block
+ * @param channels The number of channels
+ */
+void dibiff::filter::FIRFilter::setChannels(int channels) {
+    if (channels < 1) {
+        throw std::runtime_error("An FIR filter needs at least one channel.");
+    }
+    resize(channels, blockSize, true);
+}
+/**
+ * @brief Size the history of every channel for a block size
+ * @details The saved samples are at the front of each buffer, so they survive
+ * @param channels The number of channels
+ * @param blockSize The block size
+ * @param measure Whether an untimed configuration may be timed now
+ */
+void dibiff::filter::FIRFilter::resize(int channels, int blockSize, bool measure) {
+    this->blockSize = blockSize;
+    history.resize(channels);
+    for (auto& h : history) {
+        h.resize(taps.size() - 1 + blockSize, 0.0f);
+    }
+    configure(measure);
+}
+/**
+ * @brief Choose between direct and partitioned convolution
+ * @details Builds the partitioned convolutions from the history, so a change of
+ * implementation does not interrupt the output. Timing a new configuration takes a few
+ * milliseconds, so it is only done when measure is set, from the control thread; on the
+ * audio thread an untimed configuration is applied in direct form until it is announced
+ * with setBlockSize().
+ * @param measure Whether an untimed configuration may be timed now
+ */
+void dibiff::filter::FIRFilter::configure(bool measure) {
+    const bool wasPartitioned = !convolutions.empty();
+    convolutions.clear();
+    if (blockSize <= 0 || mode == Mode::Direct) {
+        return;
+    }
+    const int length = static_cast<int>(taps.size());
+    const bool powerOfTwo = (blockSize & (blockSize - 1)) == 0;
+    const bool partitioned = mode == Mode::Partitioned ? powerOfTwo
+        : measure ? isPartitionedFaster(length, blockSize) : isPartitionedKnownFaster(length, blockSize);
+    if (!partitioned) {
+        if (wasPartitioned) {
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Info, name.c_str(), "Switched to direct convolution", {static_cast<double>(length), static_cast<double>(blockSize)});
+        }
+        return;
+    }
+    for (const auto& h : history) {
+        auto convolution = std::make_unique<dibiff::util::PartitionedConvolution>(taps.data(), length, blockSize);
+        convolution->prime(h.data(), length - 1);
+        convolutions.emplace_back(std::move(convolution));
+    }
+    if (!wasPartitioned) {
+        dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Info, name.c_str(), "Switched to partitioned convolution", {static_cast<double>(length), static_cast<double>(blockSize)});
+    }
+}
+/**
+ * @brief Check if partitioned convolution is faster
+ * @details Runs each implementation over a block of noise for at least a millisecond
+ * and compares the time per block. The answers are kept in a table shared by every
+ * filter, so a graph of many filters of the same size is timed once.
+ * @param length The number of taps
+ * @param blockSize The block size
+ * @return True if partitioned convolution is faster, false if it is slower or the
+ * block size is not a power of two
+ */
+bool dibiff::filter::FIRFilter::isPartitionedFaster(int length, int blockSize) {
+    if (length < 1 || blockSize < 2 || (blockSize & (blockSize - 1)) != 0) {
+        return false;
+    }
+    Timings& timings = getTimings();
+    const std::pair<int, int> key(length, blockSize);
+    {
+        std::lock_guard<std::mutex> lock(timings.mutex);
+        auto it = timings.table.find(key);
+        if (it != timings.table.end()) {
+            return it->second;
+        }
+    }
+    /// Noise rather than tones, whose spectra have bins small enough to turn denormal
+    std::uint32_t seed = 1;
+    auto noise = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+    };
+    std::vector<float> h(length), history(length - 1 + blockSize), out(blockSize);
+    std::generate(h.begin(), h.end(), noise);
+    std::generate(history.begin(), history.end(), noise);
+    auto time = [](auto&& run) {
+        using Clock = std::chrono::steady_clock;
+        run();
+        long runs = 0;
+        const Clock::time_point start = Clock::now();
+        Clock::duration elapsed;
+        do {
+            run();
+            ++runs;
+            elapsed = Clock::now() - start;
+        } while (elapsed < std::chrono::milliseconds(1));
+        return std::chrono::duration<double>(elapsed).count() / runs;
+    };
+    const double direct = time([&]() {
+        convolve(h.data(), length, history.data(), out.data(), blockSize);
+    });
+    dibiff::util::PartitionedConvolution convolution(h.data(), length, blockSize);
+    const double partitioned = time([&]() {
+        convolution.process(history.data(), out.data());
+    });
+    const bool faster = partitioned < direct;
+    std::lock_guard<std::mutex> lock(timings.mutex);
+    timings.table[key] = faster;
+    return faster;
+}
+/**
+ * @brief Check if partitioned convolution is known to be faster
+ * @details Looks the configuration up without timing it, and without waiting for a
+ * timing in progress, so it is safe on the audio thread
+ * @param length The number of taps
+ * @param blockSize The block size
+ * @return True if the configuration was timed and partitioned convolution was faster
+ */
+bool dibiff::filter::FIRFilter::isPartitionedKnownFaster(int length, int blockSize) {
+    Timings& timings = getTimings();
+    std::unique_lock<std::mutex> lock(timings.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    auto it = timings.table.find(std::make_pair(length, blockSize));
+    return it != timings.table.end() && it->second;
+}
+/**
+ * @brief Design a windowed-sinc low-pass kernel
+ * @details The ideal low-pass response sin(2 pi fc t) / (pi t), centred on the kernel and
+ * shaped by a Kaiser window
+ * @param length The number of taps
+ * @param cutoff The cutoff frequency in Hz, where the gain is -6 dB
+ * @param sampleRate The sample rate in Hz
+ * @param beta The Kaiser window parameter
+ * @return The taps, normalized to unity gain at DC
+ */
+std::vector<float> dibiff::filter::FIRFilter::lowPass(int length, float cutoff, float sampleRate, float beta) {
+    if (length < 1) {
+        throw std::runtime_error("An FIR filter needs at least one tap.");
+    }
+    if (cutoff <= 0.0f || cutoff >= sampleRate / 2.0f) {
+        throw std::runtime_error("FIR cutoff must be between 0 and half the sample rate.");
+    }
+    const double fc = static_cast<double>(cutoff) / sampleRate;
+    const double centre = (length - 1) / 2.0;
+    std::vector<double> h(length);
+    double sum = 0.0;
+    for (int i = 0; i < length; ++i) {
+        const double t = i - centre;
+        const double sinc = t == 0.0 ? 2.0 * fc : std::sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        const double r = centre > 0.0 ? t / centre : 0.0;
+        const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(beta);
+        h[i] = sinc * window;
+        sum += h[i];
+    }
+    std::vector<float> out(length);
+    for (int i = 0; i < length; ++i) {
+        out[i] = static_cast<float>(h[i] / sum);
+    }
+    return out;
+}
+/**
+ * @brief Design a windowed-sinc high-pass kernel
+ * @details Subtracts the low-pass kernel from a unit impulse at its centre, which needs
+ * a centre tap and so an odd length
+ * @param length The number of taps, must be odd
+ * @param cutoff The cutoff frequency in Hz, where the gain is -6 dB
+ * @param sampleRate The sample rate in Hz
+ * @param beta The Kaiser window parameter
+ * @return The taps
+ */
+std::vector<float> dibiff::filter::FIRFilter::highPass(int length, float cutoff, float sampleRate, float beta) {
+    if (length % 2 == 0) {
+        throw std::runtime_error("A high-pass FIR filter needs an odd number of taps.");
+    }
+    std::vector<float> h = lowPass(length, cutoff, sampleRate, beta);
+    for (auto& tap : h) {
+        tap = -tap;
+    }
+    h[length / 2] += 1.0f;
+    return h;
+}
+/**
+ * @brief Design a windowed-sinc band-pass kernel
+ * @details The difference of two low-pass kernels
+ * @param length The number of taps
+ * @param low The lower cutoff frequency in Hz
+ * @param high The upper cutoff frequency in Hz
+ * @param sampleRate The sample rate in Hz
+ * @param beta The Kaiser window parameter
+ * @return The taps
+ */
+std::vector<float> dibiff::filter::FIRFilter::bandPass(int length, float low, float high, float sampleRate, float beta) {
+    if (low >= high) {
+        throw std::runtime_error("FIR band-pass cutoffs must be increasing.");
+    }
+    std::vector<float> h = lowPass(length, high, sampleRate, beta);
+    const std::vector<float> l = lowPass(length, low, sampleRate, beta);
+    for (int i = 0; i < length; ++i) {
+        h[i] -= l[i];
+    }
+    return h;
+}
+/**
+ * @brief Design a least-squares linear-phase kernel
+ * @details Samples the bands on a grid of about 16 points per tap across the spectrum
+ * and fits the amplitude response of a symmetric kernel, a sum of cosines, by weighted
+ * least squares with a pivoted QR decomposition. An even length forces a zero at the
+ * Nyquist frequency, so a high-pass response needs an odd length.
+ * @param length The number of taps
+ * @param edges The band edges in Hz, in pairs of increasing frequencies
+ * @param gains The desired gain at each edge, interpolated linearly within a band
+ * @param sampleRate The sample rate in Hz
+ * @param weights The weight of each band, all ones if empty
+ * @return The taps
+ */
+std::vector<float> dibiff::filter::FIRFilter::leastSquares(int length, const std::vector<float>& edges, const std::vector<float>& gains, float sampleRate, const std::vector<float>& weights) {
+    if (length < 1) {
+        throw std::runtime_error("An FIR filter needs at least one tap.");
+    }
+    if (edges.empty() || edges.size() % 2 != 0 || gains.size() != edges.size()) {
+        throw std::runtime_error("FIR band edges must come in pairs with a gain for each edge.");
+    }
+    if (!weights.empty() && weights.size() != edges.size() / 2) {
+        throw std::runtime_error("FIR band weights must have one weight per band.");
+    }
+    const float nyquist = sampleRate / 2.0f;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (edges[i] < 0.0f || edges[i] > nyquist || (i > 0 && edges[i] < edges[i - 1])) {
+            throw std::runtime_error("FIR band edges must increase from 0 to half the sample rate.");
+        }
+    }
+    const bool odd = length % 2 == 1;
+    const int columns = odd ? (length - 1) / 2 + 1 : length / 2;
+    const double step = nyquist / (16.0 * length);
+    std::vector<double> frequencies, desired, scale;
+    for (std::size_t b = 0; b < edges.size() / 2; ++b) {
+        const double f0 = edges[2 * b], f1 = edges[2 * b + 1];
+        const double g0 = gains[2 * b], g1 = gains[2 * b + 1];
+        const double weight = weights.empty() ? 1.0 : weights[b];
+        const int points = std::max(2, static_cast<int>((f1 - f0) / step) + 1);
+        for (int p = 0; p < points; ++p) {
+            const double a = static_cast<double>(p) / (points - 1);
+            frequencies.push_back(f0 + a * (f1 - f0));
+            desired.push_back(g0 + a * (g1 - g0));
+            scale.push_back(std::sqrt(weight));
+        }
+    }
+    const Eigen::Index rows = static_cast<Eigen::Index>(frequencies.size());
+    Eigen::MatrixXd basis(rows, columns);
+    Eigen::VectorXd target(rows);
+    for (Eigen::Index r = 0; r < rows; ++r) {
+        const double w = 2.0 * M_PI * frequencies[r] / sampleRate;
+        for (int k = 0; k < columns; ++k) {
+            basis(r, k) = scale[r] * std::cos((odd ? k : k + 0.5) * w);
+        }
+        target(r) = scale[r] * desired[r];
+    }
+    const Eigen::VectorXd c = basis.colPivHouseholderQr().solve(target);
+    std::vector<float> h(length);
+    if (odd) {
+        const int centre = (length - 1) / 2;
+        h[centre] = static_cast<float>(c(0));
+        for (int k = 1; k < columns; ++k) {
+            h[centre - k] = h[centre + k] = static_cast<float>(c(k) / 2.0);
+        }
+    } else {
+        const int half = length / 2;
+        for (int k = 0; k < columns; ++k) {
+            h[half - 1 - k] = h[half + k] = static_cast<float>(c(k) / 2.0);
+        }
+    }
+    return h;
+}
+/**
+ * @brief Convert a kernel to minimum phase
+ * @details Takes the real cepstrum of the kernel's log magnitude on a transform much
+ * longer than the kernel to limit aliasing, folds the anti-causal half onto the causal
+ * half and exponentiates its spectrum back. The magnitude is floored 100 dB below its
+ * peak so the stopband zeros do not take the log to minus infinity.
+ * @param taps The impulse response
+ * @return The minimum-phase impulse response, of the same length
+ */
+std::vector<float> dibiff::filter::FIRFilter::minimumPhase(const std::vector<float>& taps) {
+    if (taps.empty()) {
+        throw std::runtime_error("An FIR filter needs at least one tap.");
+    }
+    int size = 1024;
+    while (size < 16 * static_cast<int>(taps.size())) {
+        size <<= 1;
+    }
+    dibiff::util::FFT fft(size);
+    std::vector<float> buffer(size, 0.0f);
+    std::vector<dibiff::util::FFT::Complex> spectrum(size / 2 + 1);
+    std::copy(taps.begin(), taps.end(), buffer.begin());
+    fft.forward(buffer.data(), spectrum.data());
+    float peak = 0.0f;
+    for (const auto& bin : spectrum) {
+        peak = std::max(peak, std::abs(bin));
+    }
+    const float floor = std::max(peak * 1.0e-5f, std::numeric_limits<float>::min());
+    for (auto& bin : spectrum) {
+        bin = std::log(std::max(std::abs(bin), floor));
+    }
+    fft.inverse(spectrum.data(), buffer.data());
+    for (int n = 1; n < size / 2; ++n) {
+        buffer[n] *= 2.0f;
+    }
+    std::fill(buffer.begin() + size / 2 + 1, buffer.end(), 0.0f);
+    fft.forward(buffer.data(), spectrum.data());
+    for (auto& bin : spectrum) {
+        bin = std::exp(bin);
+    }
+    fft.inverse(spectrum.data(), buffer.data());
+    return std::vector<float>(buffer.begin(), buffer.begin() + taps.size());
+}
+/**
+ * @brief Create a new filter object
+ * @param taps The impulse response of the filter, h[0] first
+ */
+std::unique_ptr<dibiff::filter::FIRFilter> dibiff::filter::FIRFilter::create(std::vector<float> taps) {
+    auto instance = std::make_unique<dibiff::filter::FIRFilter>(std::move(taps));
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,247 @@
+/// FIRFilter.h
+
+#pragma once
+
+#include "../graph/graph.h"
+#include "filter.h"
+#include "../util/PartitionedConvolution.h"
+
+/**
+ * @brief FIR Filter
+ * @details A finite impulse response filter, applied in direct form to short kernels,
+ * such as crossovers, DC blocking and anti-imaging filters of 16 to a few hundred taps.
+ * The filter is defined by the equation:
+ * y[n] = h[0]*x[n] + h[1]*x[n-1] + ... + h[N-1]*x[n-N+1]
+ * Each channel keeps its last N-1 input samples in front of the current block in one
+ * contiguous buffer, so every output is a dot product with a plain run of memory. With
+ * AVX2 the kernel computes eight consecutive outputs per vector, broadcasting one tap
+ * at a time against an unaligned load of the history.
+ * Longer kernels are cheaper to apply with partitioned FFT convolution, which has no
+ * extra latency when the block size is a power of two. Where the two cost the same
+ * depends on the taps, the block size and the CPU, so by default the filter times both
+ * for its configuration and uses the faster one. The timing runs when the block size
+ * is set with setBlockSize() or the taps or mode change, never on the audio thread: a
+ * block size that was not announced runs in direct form unless it was timed before,
+ * and a block shorter than the announced size, such as the last one, always does.
+ * A filter fed more than one channel should be told so with setChannels(), so the
+ * convolutions of every channel are built ahead of the first block as well.
+ * Static helpers design windowed-sinc and least-squares linear-phase kernels, and
+ * convert a kernel to minimum phase.
+ */
+class dibiff::filter::FIRFilter : public dibiff::graph::AudioObject {
+    public:
+        /**
+         * @brief How the filter is applied
+         */
+        enum class Mode {
+            /// The faster of the two for the taps and block size
+            Automatic,
+            /// Direct-form convolution
+            Direct,
+            /// Partitioned FFT convolution, when the block size is a power of two
+            Partitioned
+        };
+        dibiff::graph::AudioInput* input;
+        dibiff::graph::AudioOutput* output;
+        /**
+         * @brief Constructor
+         * @param taps The impulse response of the filter, h[0] first
+         */
+        FIRFilter(std::vector<float> taps);
+        /**
+         * @brief Initialize
+         * @details Initializes the filter connection points
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Filters every channel of the input with its own history
+         */
+        void process() override;
+        /**
+         * @brief Set the impulse response
+         * @details The history is kept, so a kernel of the same length can be swapped
+         * without a discontinuity beyond the change of response
+         * @param taps The impulse response of the filter, h[0] first
+         */
+        void setTaps(std::vector<float> taps);
+        /**
+         * @brief Get the impulse response
+         * @return The taps, h[0] first
+         */
+        const std::vector<float>& getTaps() const { return taps; }
+        /**
+         * @brief Set how the filter is applied
+         * @param mode The mode
+         */
+        void setMode(Mode mode);
+        /**
+         * @brief Get how the filter is applied
+         * @return The mode
+         */
+        Mode getMode() const { return mode; }
+        /**
+         * @brief Check if the filter currently uses partitioned convolution
+         * @return True if the blocks are convolved with FFTs
+         */
+        bool isPartitioned() const { return !convolutions.empty(); }
+        /**
+         * @brief Reset the filter
+         * @details Clears the history
+         */
+        void reset() override;
+        /**
+         * @brief Clear the filter
+         * @details Clears the history
+         */
+        void clear() override;
+        /**
+         * @brief Check if the filter is finished processing
+         * @return True if the filter is finished processing, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the filter is ready to process
+         * @return True if the filter is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the filter
+         * @return The length of the impulse response in samples
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the filter
+         * @return A versioned blob of the history of every channel
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the filter
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
+        /**
+         * @brief Set the block size
+         * @details Resizes the history buffers and times the new configuration ahead of
+         * the first block of the new size, for the channels set with setChannels()
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
+        /**
+         * @brief Set the number of channels
+         * @details Sizes the history and builds the convolutions of every channel ahead of
+         * the first block. Without it, a filter fed more than one channel builds them on
+         * the audio thread when the first block arrives.
+         * @param channels The number of channels
+         */
+        void setChannels(int channels);
+        /**
+         * @brief Filter a block of one channel
+         * @details The history holds the N-1 samples before the block followed by the
+         * block itself, so it is taps + n - 1 samples long
+         * @param taps The impulse response reversed, h[N-1] first
+         * @param length The number of taps N
+         * @param history The history of the channel
+         * @param out The output, n samples
+         * @param n The number of samples
+         */
+        static void convolve(const float* taps, int length, const float* history, float* out, int n);
+        /**
+         * @brief Check if partitioned convolution is faster
+         * @details Times both implementations on this machine the first time a
+         * configuration is asked for and remembers the answer for the process
+         * @param length The number of taps
+         * @param blockSize The block size
+         * @return True if partitioned convolution is faster, false if it is slower or the
+         * block size is not a power of two
+         */
+        static bool isPartitionedFaster(int length, int blockSize);
+        /**
+         * @brief Design a windowed-sinc low-pass kernel
+         * @param length The number of taps
+         * @param cutoff The cutoff frequency in Hz, where the gain is -6 dB
+         * @param sampleRate The sample rate in Hz
+         * @param beta The Kaiser window parameter, trading transition width for stopband
+         * attenuation, about 0.1102 * (A - 8.7) for an attenuation of A dB
+         * @return The taps, normalized to unity gain at DC
+         */
+        static std::vector<float> lowPass(int length, float cutoff, float sampleRate, float beta = 8.0f);
+        /**
+         * @brief Design a windowed-sinc high-pass kernel
+         * @details Spectral inversion of the low-pass kernel
+         * @param length The number of taps, must be odd
+         * @param cutoff The cutoff frequency in Hz, where the gain is -6 dB
+         * @param sampleRate The sample rate in Hz
+         * @param beta The Kaiser window parameter
+         * @return The taps
+         */
+        static std::vector<float> highPass(int length, float cutoff, float sampleRate, float beta = 8.0f);
+        /**
+         * @brief Design a windowed-sinc band-pass kernel
+         * @param length The number of taps
+         * @param low The lower cutoff frequency in Hz
+         * @param high The upper cutoff frequency in Hz
+         * @param sampleRate The sample rate in Hz
+         * @param beta The Kaiser window parameter
+         * @return The taps
+         */
+        static std::vector<float> bandPass(int length, float low, float high, float sampleRate, float beta = 8.0f);
+        /**
+         * @brief Design a least-squares linear-phase kernel
+         * @details Minimizes the weighted squared error to a piecewise linear magnitude
+         * response over a set of bands, leaving the gaps between them unconstrained
+         * @param length The number of taps
+         * @param edges The band edges in Hz, in pairs of increasing frequencies
+         * @param gains The desired gain at each edge, interpolated linearly within a band
+         * @param sampleRate The sample rate in Hz
+         * @param weights The weight of each band, all ones if empty
+         * @return The taps
+         */
+        static std::vector<float> leastSquares(int length, const std::vector<float>& edges, const std::vector<float>& gains, float sampleRate, const std::vector<float>& weights = {});
+        /**
+         * @brief Convert a kernel to minimum phase
+         * @details Keeps the magnitude response and moves the energy to the start of the
+         * kernel with the folded real cepstrum, trading the symmetric delay of a linear-phase
+         * kernel for a lower latency
+         * @param taps The impulse response
+         * @return The minimum-phase impulse response, of the same length
+         */
+        static std::vector<float> minimumPhase(const std::vector<float>& taps);
+        /**
+         * @brief Create a new filter object
+         * @param taps The impulse response of the filter, h[0] first
+         */
+        static std::unique_ptr<FIRFilter> create(std::vector<float> taps);
+    private:
+        std::vector<float> taps;
+        /// The taps reversed, so the kernel walks the history forwards
+        std::vector<float> reversed;
+        /// The history of every channel, taps + block size - 1 samples each
+        std::vector<std::vector<float>> history = std::vector<std::vector<float>>(1);
+        int blockSize = 0;
+        Mode mode = Mode::Automatic;
+        /// The partitioned convolution of every channel, empty when the filter is direct
+        std::vector<std::unique_ptr<dibiff::util::PartitionedConvolution>> convolutions;
+        /**
+         * @brief Size the history of every channel for a block size
+         * @param channels The number of channels
+         * @param blockSize The block size
+         * @param measure Whether an untimed configuration may be timed now
+         */
+        void resize(int channels, int blockSize, bool measure);
+        /**
+         * @brief Choose between direct and partitioned convolution
+         * @details Builds the partitioned convolutions from the history, so a change of
+         * implementation does not interrupt the output
+         * @param measure Whether an untimed configuration may be timed now
+         */
+        void configure(bool measure);
+        /**
+         * @brief Check if partitioned convolution is known to be faster
+         * @details Never times the configuration, so it is safe on the audio thread
+         * @param length The number of taps
+         * @param blockSize The block size
+         * @return True if the configuration was timed and partitioned convolution was faster
+         */
+        static bool isPartitionedKnownFaster(int length, int blockSize);
+};
@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::HighPassFilter::HighPassFilter(float& cutoff, float& sampleRate, float& qFactor)
+template<typename StateType>
+dibiff::filter::BasicHighPassFilter<StateType>::BasicHighPassFilter(float& cutoff, float& sampleRate, float& qFactor)
 : _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "HighPassFilter";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "HighPassFilter";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -20,22 +21,24 @@ dibiff::filter::HighPassFilter::HighPassFilter(float& cutoff, float& sampleRate,
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::HighPassFilter::calculateCoefficients() {
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float cosw0 = std::cos(w0);
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b1 = -(1.0f + cosw0);
-    float b0 = -b1 / 2.0f;
-    float a0 = 1.0f + alpha;
-    float a1 = -2.0f * cosw0;
-    float a2 = 1.0f - alpha;
-    coeffs = dibiff::filter::Coefficients{b0, b1, b0, a0, a1, a2};
+template<typename StateType>
+void dibiff::filter::BasicHighPassFilter<StateType>::calculateCoefficients() {
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType cosw0 = std::cos(w0);
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b1 = -(1.0f + cosw0);
+    StateType b0 = -b1 / 2.0f;
+    StateType a0 = 1.0f + alpha;
+    StateType a1 = -2.0f * cosw0;
+    StateType a2 = 1.0f - alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, b1, b0, a0, a1, a2};
 }
 /**
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::HighPassFilter::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicHighPassFilter<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -43,7 +46,8 @@ void dibiff::filter::HighPassFilter::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::HighPassFilter::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicHighPassFilter<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -51,7 +55,8 @@ void dibiff::filter::HighPassFilter::setSampleRate(float sampleRate) {
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::HighPassFilter::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicHighPassFilter<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -59,7 +64,8 @@ void dibiff::filter::HighPassFilter::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::HighPassFilter::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicHighPassFilter<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -70,8 +76,12 @@ void dibiff::filter::HighPassFilter::setBandwidth(float bandwidth) {
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::HighPassFilter> dibiff::filter::HighPassFilter::create(float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::HighPassFilter>(cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicHighPassFilter<StateType>> dibiff::filter::BasicHighPassFilter<StateType>::create(float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicHighPassFilter<StateType>>(cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicHighPassFilter<float>;
+template class dibiff::filter::BasicHighPassFilter<double>;
\ No newline at end of file
@@ -15,14 +15,16 @@
  * @param qFactor The quality factor of the filter, default value is 0.7071067811865476, or 1/sqrt(2)
  * @return A high pass filter object
  * @see DigitalBiquadFilter
+ * @tparam StateType The type of the coefficients and the filter state, float or double
  */
-class dibiff::filter::HighPassFilter : public dibiff::filter::DigitalBiquadFilter {
+template<typename StateType>
+class dibiff::filter::BasicHighPassFilter : public dibiff::filter::BasicDigitalBiquadFilter<float, StateType> {
     public:
         /**
          * @brief Constructor
          * @details Initializes the filter with default values
          */
-        HighPassFilter(float& cutoff, float& sampleRate, float& qFactor);
+        BasicHighPassFilter(float& cutoff, float& sampleRate, float& qFactor);
         /**
          * @brief Calculate the filter coefficients
          * @details Calculates the filter coefficients based on the cutoff frequency, sample rate, and quality factor
@@ -58,10 +60,10 @@ class dibiff::filter::HighPassFilter : public dibiff::filter::DigitalBiquadFilte
          * @param sampleRate The sample rate of the input signal
          * @param qFactor The quality factor of the filter
          */
-        static std::unique_ptr<HighPassFilter> create(float& cutoff, float& sampleRate, float& qFactor);
+        static std::unique_ptr<BasicHighPassFilter> create(float& cutoff, float& sampleRate, float& qFactor);
     private:
         float& _cutoff;
         float& _sampleRate;
         float& _qFactor;
-        dibiff::filter::Coefficients coeffs;
+        dibiff::filter::BasicCoefficients<StateType> coeffs;
 };
\ No newline at end of file
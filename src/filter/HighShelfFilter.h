@@ -15,14 +15,16 @@
  * @param qFactor The quality factor of the filter, default value is 0.7071067811865476, or 1/sqrt(2)
  * @return A high shelf filter object
  * @see DigitalBiquadFilter
+ * @tparam StateType The type of the coefficients and the filter state, float or double
  */
-class dibiff::filter::HighShelfFilter : public dibiff::filter::DigitalBiquadFilter {
+template<typename StateType>
+class dibiff::filter::BasicHighShelfFilter : public dibiff::filter::BasicDigitalBiquadFilter<float, StateType> {
     public:
         /**
          * @brief Constructor
          * @details Initializes the filter with default values
          */
-        HighShelfFilter(float& gain, float& cutoff, float& sampleRate, float& qFactor);
+        BasicHighShelfFilter(float& gain, float& cutoff, float& sampleRate, float& qFactor);
         /**
          * @brief Calculate the filter coefficients
          * @details Calculates the filter coefficients based on the gain, cutoff frequency, sample rate, and quality factor
@@ -65,11 +67,11 @@ class dibiff::filter::HighShelfFilter : public dibiff::filter::DigitalBiquadFilt
          * @param sampleRate The sample rate of the input signal
          * @param qFactor The quality factor of the filter
          */
-        static std::unique_ptr<HighShelfFilter> create(float& gain, float& cutoff, float& sampleRate, float& qFactor);
+        static std::unique_ptr<BasicHighShelfFilter> create(float& gain, float& cutoff, float& sampleRate, float& qFactor);
     private:
         float& _gain;
         float& _cutoff;
         float& _sampleRate;
         float& _qFactor;
-        dibiff::filter::Coefficients coeffs;
+        dibiff::filter::BasicCoefficients<StateType> coeffs;
 };
\ No newline at end of file
@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::LowPassFilter::LowPassFilter(float& cutoff, float& sampleRate, float& qFactor) 
+template<typename StateType>
+dibiff::filter::BasicLowPassFilter<StateType>::BasicLowPassFilter(float& cutoff, float& sampleRate, float& qFactor) 
 : _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "LowPassFilter";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "LowPassFilter";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -20,22 +21,24 @@ dibiff::filter::LowPassFilter::LowPassFilter(float& cutoff, float& sampleRate, f
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::LowPassFilter::calculateCoefficients() {
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float cosw0 = std::cos(w0);
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b1 = 1.0f - cosw0;
-    float b0 = b1 / 2.0f;
-    float a0 = 1.0f + alpha;
-    float a1 = -2.0f * cosw0;
-    float a2 = 1.0f - alpha;
-    coeffs = dibiff::filter::Coefficients{b0, b1, b0, a0, a1, a2};
+template<typename StateType>
+void dibiff::filter::BasicLowPassFilter<StateType>::calculateCoefficients() {
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType cosw0 = std::cos(w0);
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b1 = 1.0f - cosw0;
+    StateType b0 = b1 / 2.0f;
+    StateType a0 = 1.0f + alpha;
+    StateType a1 = -2.0f * cosw0;
+    StateType a2 = 1.0f - alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, b1, b0, a0, a1, a2};
 }
 /**
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::LowPassFilter::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicLowPassFilter<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -44,7 +47,8 @@ void dibiff::filter::LowPassFilter::setCutoff(float cutoff) {
  * @param sampleRate The sample rate of the input signal
  
  */
-void dibiff::filter::LowPassFilter::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicLowPassFilter<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -53,7 +57,8 @@ void dibiff::filter::LowPassFilter::setSampleRate(float sampleRate) {
  * @param qFactor The quality factor of the filter
  
  */
-void dibiff::filter::LowPassFilter::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicLowPassFilter<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -61,7 +66,8 @@ void dibiff::filter::LowPassFilter::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::LowPassFilter::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicLowPassFilter<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -72,8 +78,12 @@ void dibiff::filter::LowPassFilter::setBandwidth(float bandwidth) {
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::LowPassFilter> dibiff::filter::LowPassFilter::create(float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::LowPassFilter>(cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicLowPassFilter<StateType>> dibiff::filter::BasicLowPassFilter<StateType>::create(float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicLowPassFilter<StateType>>(cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicLowPassFilter<float>;
+template class dibiff::filter::BasicLowPassFilter<double>;
\ No newline at end of file
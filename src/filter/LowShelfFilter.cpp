@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::LowShelfFilter::LowShelfFilter(float& gain, float& cutoff, float& sampleRate, float& qFactor)
+template<typename StateType>
+dibiff::filter::BasicLowShelfFilter<StateType>::BasicLowShelfFilter(float& gain, float& cutoff, float& sampleRate, float& qFactor)
 : _gain(gain), _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "LowShelfFilter";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "LowShelfFilter";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -21,25 +22,27 @@ dibiff::filter::LowShelfFilter::LowShelfFilter(float& gain, float& cutoff, float
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::LowShelfFilter::calculateCoefficients() {
-    float A = std::pow(10.0f, _gain / 40.0f);
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float cosw0 = std::cos(w0);
-    float sqrtA = std::sqrt(A);
-    float b0 = A * ((A + 1.0f) - (A - 1.0f) * cosw0 + 2.0f * sqrtA * alpha);
-    float b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cosw0);
-    float b2 = A * ((A + 1.0f) - (A - 1.0f) * cosw0 - 2.0f * sqrtA * alpha);
-    float a0 = (A + 1.0f) + (A - 1.0f) * cosw0 + 2.0f * sqrtA * alpha;
-    float a1 = -2.0f * ((A - 1.0f) + (A + 1.0f) * cosw0);
-    float a2 = (A + 1.0f) + (A - 1.0f) * cosw0 - 2.0f * sqrtA * alpha;
-    coeffs = dibiff::filter::Coefficients{b0, b1, b2, a0, a1, a2};
+template<typename StateType>
+void dibiff::filter::BasicLowShelfFilter<StateType>::calculateCoefficients() {
+    StateType A = std::pow(StateType(10), _gain / StateType(40));
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType cosw0 = std::cos(w0);
+    StateType sqrtA = std::sqrt(A);
+    StateType b0 = A * ((A + 1.0f) - (A - 1.0f) * cosw0 + 2.0f * sqrtA * alpha);
+    StateType b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cosw0);
+    StateType b2 = A * ((A + 1.0f) - (A - 1.0f) * cosw0 - 2.0f * sqrtA * alpha);
+    StateType a0 = (A + 1.0f) + (A - 1.0f) * cosw0 + 2.0f * sqrtA * alpha;
+    StateType a1 = -2.0f * ((A - 1.0f) + (A + 1.0f) * cosw0);
+    StateType a2 = (A + 1.0f) + (A - 1.0f) * cosw0 - 2.0f * sqrtA * alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, b1, b2, a0, a1, a2};
 }
 /**
  * @brief Set the gain of the filter
  * @param gain The gain of the filter in dB
  */
-void dibiff::filter::LowShelfFilter::setGain(float gain) {
+template<typename StateType>
+void dibiff::filter::BasicLowShelfFilter<StateType>::setGain(float gain) {
     _gain = gain;
     calculateCoefficients();
 }
@@ -47,7 +50,8 @@ void dibiff::filter::LowShelfFilter::setGain(float gain) {
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::LowShelfFilter::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicLowShelfFilter<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -55,7 +59,8 @@ void dibiff::filter::LowShelfFilter::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::LowShelfFilter::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicLowShelfFilter<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -63,7 +68,8 @@ void dibiff::filter::LowShelfFilter::setSampleRate(float sampleRate) {
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::LowShelfFilter::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicLowShelfFilter<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -71,7 +77,8 @@ void dibiff::filter::LowShelfFilter::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::LowShelfFilter::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicLowShelfFilter<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -83,8 +90,12 @@ void dibiff::filter::LowShelfFilter::setBandwidth(float bandwidth) {
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::LowShelfFilter> dibiff::filter::LowShelfFilter::create(float& gain, float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::LowShelfFilter>(gain, cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicLowShelfFilter<StateType>> dibiff::filter::BasicLowShelfFilter<StateType>::create(float& gain, float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicLowShelfFilter<StateType>>(gain, cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicLowShelfFilter<float>;
+template class dibiff::filter::BasicLowShelfFilter<double>;
\ No newline at end of file
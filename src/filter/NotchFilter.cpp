@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::NotchFilter::NotchFilter(float& cutoff, float& sampleRate, float& qFactor)
+template<typename StateType>
+dibiff::filter::BasicNotchFilter<StateType>::BasicNotchFilter(float& cutoff, float& sampleRate, float& qFactor)
 : _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "NotchFilter";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "NotchFilter";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -20,19 +21,21 @@ dibiff::filter::NotchFilter::NotchFilter(float& cutoff, float& sampleRate, float
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::NotchFilter::calculateCoefficients() {
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b1 = -2.0f * std::cos(w0);
-    float a0 = 1.0f + alpha;
-    float a2 = 1.0f - alpha;
-    coeffs = dibiff::filter::Coefficients{1.0f, b1, 1.0f, a0, b1, a2};
+template<typename StateType>
+void dibiff::filter::BasicNotchFilter<StateType>::calculateCoefficients() {
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b1 = -2.0f * std::cos(w0);
+    StateType a0 = 1.0f + alpha;
+    StateType a2 = 1.0f - alpha;
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{1.0f, b1, 1.0f, a0, b1, a2};
 }
 /**
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::NotchFilter::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicNotchFilter<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -40,7 +43,8 @@ void dibiff::filter::NotchFilter::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::NotchFilter::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicNotchFilter<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -48,7 +52,8 @@ void dibiff::filter::NotchFilter::setSampleRate(float sampleRate) {
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::NotchFilter::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicNotchFilter<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -56,7 +61,8 @@ void dibiff::filter::NotchFilter::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::NotchFilter::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicNotchFilter<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -67,8 +73,12 @@ void dibiff::filter::NotchFilter::setBandwidth(float bandwidth) {
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::NotchFilter> dibiff::filter::NotchFilter::create(float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::NotchFilter>(cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicNotchFilter<StateType>> dibiff::filter::BasicNotchFilter<StateType>::create(float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicNotchFilter<StateType>>(cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicNotchFilter<float>;
+template class dibiff::filter::BasicNotchFilter<double>;
\ No newline at end of file
@@ -6,12 +6,13 @@
  * @brief Constructor
  * @details Initializes the filter with default values
  */
-dibiff::filter::PeakingEQFilter::PeakingEQFilter(float& gain, float& cutoff, float& sampleRate, float& qFactor)
+template<typename StateType>
+dibiff::filter::BasicPeakingEQFilter<StateType>::BasicPeakingEQFilter(float& gain, float& cutoff, float& sampleRate, float& qFactor)
 : _gain(gain), _cutoff(cutoff), _sampleRate(sampleRate), _qFactor(qFactor), 
-  dibiff::filter::DigitalBiquadFilter(nullptr) {
-    name = "PeakingEQFilter";
+  dibiff::filter::BasicDigitalBiquadFilter<float, StateType>(nullptr) {
+    this->name = "PeakingEQFilter";
     calculateCoefficients();
-    setCoefficients(&coeffs);
+    this->setCoefficients(&coeffs);
 }
 /**
  * @brief Calculate the filter coefficients
@@ -21,22 +22,24 @@ dibiff::filter::PeakingEQFilter::PeakingEQFilter(float& gain, float& cutoff, flo
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::PeakingEQFilter::calculateCoefficients() {
-    float A = std::pow(10.0f, _gain / 40.0f);
-    float w0 = 2.0f * M_PI * _cutoff / _sampleRate;
-    float alpha = std::sin(w0) / (2.0f * _qFactor);
-    float b0 = 1.0f + (alpha * A);
-    float b1 = -2.0f * std::cos(w0);
-    float b2 = 1.0f - (alpha * A);
-    float a0 = 1.0f + (alpha / A);
-    float a2 = 1.0f - (alpha / A);
-    coeffs = dibiff::filter::Coefficients{b0, b1, b2, a0, b1, a2};
+template<typename StateType>
+void dibiff::filter::BasicPeakingEQFilter<StateType>::calculateCoefficients() {
+    StateType A = std::pow(StateType(10), _gain / StateType(40));
+    StateType w0 = 2.0f * M_PI * _cutoff / _sampleRate;
+    StateType alpha = std::sin(w0) / (2.0f * _qFactor);
+    StateType b0 = 1.0f + (alpha * A);
+    StateType b1 = -2.0f * std::cos(w0);
+    StateType b2 = 1.0f - (alpha * A);
+    StateType a0 = 1.0f + (alpha / A);
+    StateType a2 = 1.0f - (alpha / A);
+    coeffs = dibiff::filter::BasicCoefficients<StateType>{b0, b1, b2, a0, b1, a2};
 }
 /**
  * @brief Set the gain of the filter
  * @param gain The gain of the filter in dB
  */
-void dibiff::filter::PeakingEQFilter::setGain(float gain) {
+template<typename StateType>
+void dibiff::filter::BasicPeakingEQFilter<StateType>::setGain(float gain) {
     _gain = gain;
     calculateCoefficients();
 }
@@ -44,7 +47,8 @@ void dibiff::filter::PeakingEQFilter::setGain(float gain) {
  * @brief Set the cutoff frequency of the filter
  * @param cutoff The cutoff frequency of the filter
  */
-void dibiff::filter::PeakingEQFilter::setCutoff(float cutoff) {
+template<typename StateType>
+void dibiff::filter::BasicPeakingEQFilter<StateType>::setCutoff(float cutoff) {
     _cutoff = cutoff;
     calculateCoefficients();
 }
@@ -52,7 +56,8 @@ void dibiff::filter::PeakingEQFilter::setCutoff(float cutoff) {
  * @brief Set the sample rate of the input signal
  * @param sampleRate The sample rate of the input signal
  */
-void dibiff::filter::PeakingEQFilter::setSampleRate(float sampleRate) {
+template<typename StateType>
+void dibiff::filter::BasicPeakingEQFilter<StateType>::setSampleRate(float sampleRate) {
     _sampleRate = sampleRate;
     calculateCoefficients();
 }
@@ -60,7 +65,8 @@ void dibiff::filter::PeakingEQFilter::setSampleRate(float sampleRate) {
  * @brief Set the quality factor of the filter
  * @param qFactor The quality factor of the filter
  */
-void dibiff::filter::PeakingEQFilter::setQFactor(float qFactor) {
+template<typename StateType>
+void dibiff::filter::BasicPeakingEQFilter<StateType>::setQFactor(float qFactor) {
     _qFactor = qFactor;
     calculateCoefficients();
 }
@@ -68,7 +74,8 @@ void dibiff::filter::PeakingEQFilter::setQFactor(float qFactor) {
  * @brief Set the bandwidth of the filter
  * @param bandwidth The bandwidth of the filter
  */
-void dibiff::filter::PeakingEQFilter::setBandwidth(float bandwidth) {
+template<typename StateType>
+void dibiff::filter::BasicPeakingEQFilter<StateType>::setBandwidth(float bandwidth) {
     float Q = 1.0f / (2.0f * std::sinh(bandwidth * std::log10(2.0f) / 2.0f));
     setQFactor(Q);
 }
@@ -80,8 +87,12 @@ void dibiff::filter::PeakingEQFilter::setBandwidth(float bandwidth) {
  * @param sampleRate The sample rate of the input signal
  * @param qFactor The quality factor of the filter
  */
-std::unique_ptr<dibiff::filter::PeakingEQFilter> dibiff::filter::PeakingEQFilter::create(float& gain, float& cutoff, float& sampleRate, float& qFactor) {
-    auto instance = std::make_unique<dibiff::filter::PeakingEQFilter>(gain, cutoff, sampleRate, qFactor);
+template<typename StateType>
+std::unique_ptr<dibiff::filter::BasicPeakingEQFilter<StateType>> dibiff::filter::BasicPeakingEQFilter<StateType>::create(float& gain, float& cutoff, float& sampleRate, float& qFactor) {
+    auto instance = std::make_unique<dibiff::filter::BasicPeakingEQFilter<StateType>>(gain, cutoff, sampleRate, qFactor);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::filter::BasicPeakingEQFilter<float>;
+template class dibiff::filter::BasicPeakingEQFilter<double>;
\ No newline at end of file
@@ -10,25 +10,42 @@ namespace dibiff {
      * @see DigitalBiquadFilter
      */
     namespace filter {
-        struct Coefficients;
-        class DigitalBiquadFilter;
-        class LowPassFilter;
-        class HighPassFilter;
-        class BandPassFilterConstantSkirtGain;
-        class BandPassFilterConstantPeakGain;
-        class NotchFilter;
-        class AllPassFilter;
-        class PeakingEQFilter;
-        class LowShelfFilter;
-        class HighShelfFilter;
-        class AdaptiveFilter;
+        template<typename T = float> struct BasicCoefficients;
+        template<typename SampleType = float, typename StateType = SampleType> class BasicDigitalBiquadFilter;
+        template<typename StateType = float> class BasicLowPassFilter;
+        template<typename StateType = float> class BasicHighPassFilter;
+        template<typename StateType = float> class BasicBandPassFilterConstantSkirtGain;
+        template<typename StateType = float> class BasicBandPassFilterConstantPeakGain;
+        template<typename StateType = float> class BasicNotchFilter;
+        template<typename StateType = float> class BasicAllPassFilter;
+        template<typename StateType = float> class BasicPeakingEQFilter;
+        template<typename StateType = float> class BasicLowShelfFilter;
+        template<typename StateType = float> class BasicHighShelfFilter;
+        template<typename SampleType = float, typename StateType = SampleType> class BasicAdaptiveFilter;
         class PinkNoiseFilter;
+        class FIRFilter;
+        using Coefficients = BasicCoefficients<>;
+        using DigitalBiquadFilter = BasicDigitalBiquadFilter<>;
+        using LowPassFilter = BasicLowPassFilter<>;
+        using HighPassFilter = BasicHighPassFilter<>;
+        using BandPassFilterConstantSkirtGain = BasicBandPassFilterConstantSkirtGain<>;
+        using BandPassFilterConstantPeakGain = BasicBandPassFilterConstantPeakGain<>;
+        using NotchFilter = BasicNotchFilter<>;
+        using AllPassFilter = BasicAllPassFilter<>;
+        using PeakingEQFilter = BasicPeakingEQFilter<>;
+        using LowShelfFilter = BasicLowShelfFilter<>;
+        using HighShelfFilter = BasicHighShelfFilter<>;
+        using AdaptiveFilter = BasicAdaptiveFilter<>;
     }
 }
 /**
  * @brief Coefficients Struct
- * @details A struct containing the coefficients of a digital biquad filter
+ * @details A struct containing the coefficients of a digital biquad filter, in the
+ * precision of the filter state, since the poles of low-frequency filters sit so close
+ * to the unit circle that float coefficients move them
+ * @tparam T The type of the coefficients
  */
-struct dibiff::filter::Coefficients {
-    float b0, b1, b2, a0, a1, a2;
+template<typename T>
+struct dibiff::filter::BasicCoefficients {
+    T b0, b1, b2, a0, a1, a2;
 };
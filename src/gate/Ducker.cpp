@@ -1,6 +1,7 @@
 /// Ducker.cpp
 
 #include "Ducker.h"
+#include "../util/EventLog.h"
 #include "../inc/Eigen/Dense"
 
 /**
@@ -80,7 +81,11 @@ void dibiff::gate::Ducker::process() {
         const int inBlockSize = input->getBlockSize();
         const int refBlockSize = reference->getBlockSize();
         if (inBlockSize != refBlockSize) {
-            throw std::runtime_error("Block sizes do not match");
+            /// Pass the input through rather than fail on the audio thread
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Error, name.c_str(), "Block sizes do not match, bypassing", {static_cast<double>(inBlockSize), static_cast<double>(refBlockSize)});
+            output->setData(inData, inBlockSize);
+            markProcessed();
+            return;
         }
         Eigen::VectorXf x(inBlockSize), r(inBlockSize), y(inBlockSize);
         for (int i = 0; i < inBlockSize; ++i) {
@@ -124,6 +129,16 @@ bool dibiff::gate::Ducker::isReadyToProcess() const {
     }
     return input->isReady() && reference->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the ducker
+ * @details The envelope coefficient for a time constant t in ms is exp(-1 / (t * fs / 1000)),
+ * so the envelope settles to within -80 dB after ln(1e4) * t * fs / 1000 samples
+ * @return The settling time of the envelope, in samples
+ */
+long dibiff::gate::Ducker::getStateMemory() const {
+    const float slowest = std::max(_attackTime, _releaseTime);
+    return static_cast<long>(std::ceil(std::log(1.0e4f) * slowest * _sampleRate / 1000.0f));
+}
 /**
  * Create a new ducker object
  * @param threshold The threshold level in dB
@@ -70,6 +70,11 @@ class dibiff::gate::Ducker : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the ducker
+         * @return The settling time of the envelope, in samples
+         */
+        long getStateMemory() const override;
         /**
          * Create a new ducker object
          * @param threshold The threshold level in dB
@@ -109,6 +109,16 @@ bool dibiff::gate::ExpanderGate::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the expander gate
+ * @details The envelope coefficient for a time constant t in ms is exp(-1 / (t * fs / 1000)),
+ * so the envelope settles to within -80 dB after ln(1e4) * t * fs / 1000 samples
+ * @return The settling time of the envelope, in samples
+ */
+long dibiff::gate::ExpanderGate::getStateMemory() const {
+    const float slowest = std::max(_attackTime, _releaseTime);
+    return static_cast<long>(std::ceil(std::log(1.0e4f) * slowest * _sampleRate / 1000.0f));
+}
 /**
  * Create a new expander gate object
  * @param threshold The threshold level in dB
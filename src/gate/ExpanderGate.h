@@ -72,6 +72,11 @@ class dibiff::gate::ExpanderGate : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the expander gate
+         * @return The settling time of the envelope, in samples
+         */
+        long getStateMemory() const override;
         /**
          * Create a new expander gate object
          * @param threshold The threshold level in dB
@@ -69,6 +69,11 @@ class dibiff::gate::LookaheadGate : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the lookahead gate
+         * @return The lookahead plus the settling time of the envelope, in samples
+         */
+        long getStateMemory() const override;
         /**
          * Create a new lookahead gate object
          * @param threshold The threshold level in dB
@@ -48,13 +48,20 @@ float dibiff::gate::NoiseGate::process(float sample) {
     }
     return sample;
 }
+/**
+ * @brief Prepare a block
+ * @details Updates the attack and release coefficients
+ */
+void dibiff::gate::NoiseGate::prepare() {
+    _attackCoefficient = std::exp(-1.0 / (_attackTime * _sampleRate / 1000.0f));
+    _releaseCoefficient = std::exp(-1.0 / (_releaseTime * _sampleRate / 1000.0f));
+}
 /**
  * @brief Process a block of samples
  * @details Processes a block of audio data
  */
 void dibiff::gate::NoiseGate::process() {
-    _attackCoefficient = std::exp(-1.0 / (_attackTime * _sampleRate / 1000.0f));
-    _releaseCoefficient = std::exp(-1.0 / (_releaseTime * _sampleRate / 1000.0f));
+    prepare();
     if (!input->isConnected()) {
         /// If no input is connected, just dump zeros into the output
         std::vector<float> out(input->getBlockSize(), 0.0f);
@@ -102,6 +109,16 @@ bool dibiff::gate::NoiseGate::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the noise gate
+ * @details The envelope coefficient for a time constant t in ms is exp(-1 / (t * fs / 1000)),
+ * so the envelope settles to within -80 dB after ln(1e4) * t * fs / 1000 samples
+ * @return The settling time of the envelope, in samples
+ */
+long dibiff::gate::NoiseGate::getStateMemory() const {
+    const float slowest = std::max(_attackTime, _releaseTime);
+    return static_cast<long>(std::ceil(std::log(1.0e4f) * slowest * _sampleRate / 1000.0f));
+}
 /**
  * Create a new noise gate object
  * @param threshold The threshold level in dB
@@ -40,6 +40,11 @@ class dibiff::gate::NoiseGate : public dibiff::graph::AudioObject {
          * @param input The input sample
          */
         float process(float sample);
+        /**
+         * @brief Prepare a block
+         * @details Updates the attack and release coefficients
+         */
+        void prepare();
         /**
          * @brief Process a block of samples
          * @details Processes a block of audio data
@@ -65,6 +70,11 @@ class dibiff::gate::NoiseGate : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the noise gate
+         * @return The settling time of the envelope, in samples
+         */
+        long getStateMemory() const override;
         /**
          * Create a new noise gate object
          * @param threshold The threshold level in dB
@@ -2,6 +2,8 @@
 
 #include "SampleGenerator.h"
 
+#include <cmath>
+
 dibiff::generator::SampleGenerator::SampleGenerator(std::string filename, int blockSize, int sampleRate)
 : dibiff::generator::Generator(), filename(filename), blockSize(blockSize), sampleRate(sampleRate), currentSample(-1) {
     name = "SampleGenerator";
@@ -63,7 +65,7 @@ void dibiff::generator::SampleGenerator::loadSamples(std::string filename) {
         } else if (std::strncmp(chunkHeader, "data", 4) == 0) {
             uint32_t dataSize = chunkSize;
             uint32_t totalSamples = dataSize / (numChannels * (bitsPerSample / 8));
-            samples.resize(numChannels, Eigen::VectorXf(totalSamples));
+            samples.resize(numChannels, dibiff::util::HugeVector<float>(totalSamples));
             // Read the sample data
             for (int frame = 0; frame < totalSamples; ++frame) {
                 for (int channel = 0; channel < numChannels; ++channel) {
@@ -127,10 +129,20 @@ void dibiff::generator::SampleGenerator::process() {
             noteOnOff += hasNoteOnNoteOff(message);
         }
         if (noteOnOff > 0) {
-            currentSample = 0;
+            start();
         }
     }
-    if (currentSample == -1) {
+    if (currentSample != -1 && vocoding) {
+        while (!ready.empty() && ready[0].size() < blockSize) {
+            vocode();
+        }
+        for (int i = 0; i < outputs.size(); ++i) {
+            std::vector<float> outVec(ready[i].begin(), ready[i].begin() + blockSize);
+            ready[i].erase(ready[i].begin(), ready[i].begin() + blockSize);
+            outputs[i]->setData(outVec, outVec.size());
+        }
+        currentSample += blockSize;
+    } else if (currentSample == -1) {
         /// We're not generating samples, so output zeros
         for (int i = 0; i < outputs.size(); ++i) {
             std::vector<float> out(blockSize, 0.0f);
@@ -142,8 +154,8 @@ void dibiff::generator::SampleGenerator::process() {
             int remainingSamples = samples[i].size() - currentSample;
             if (remainingSamples > 0) {
                 int actualBlockSize = std::min(blockSize, remainingSamples);
-                Eigen::VectorXf out = samples[i].segment(currentSample, actualBlockSize);
-                std::vector<float> outVec(out.data(), out.data() + out.size());
+                const float* out = samples[i].data() + currentSample;
+                std::vector<float> outVec(out, out + actualBlockSize);
                 // Zero-pad if the actual block size is less than the requested block size
                 if (actualBlockSize < blockSize) {
                     outVec.resize(blockSize, 0.0f);
@@ -161,14 +173,91 @@ void dibiff::generator::SampleGenerator::process() {
 }
 
 void dibiff::generator::SampleGenerator::reset() {
-    currentSample = 0;
+    start();
     processed = false;
 }
 
+void dibiff::generator::SampleGenerator::start() {
+    currentSample = 0;
+    vocoding = pitch != 1.0f || stretch != 1.0f;
+    if (!vocoding) {
+        return;
+    }
+    for (auto& vocoder : vocoders) {
+        vocoder->reset();
+    }
+    ready.assign(samples.size(), std::vector<float>());
+    /// The frames that overlap the start of the sample are run ahead and their output,
+    /// which comes before the start, is dropped, so the attack is neither delayed nor faded in
+    const int priming = vocoderSize / vocoderHop - 1;
+    analysisPosition = -static_cast<long>(priming) * analysisHop();
+    for (int f = 0; f < priming; ++f) {
+        vocode();
+    }
+    for (auto& r : ready) {
+        r.clear();
+    }
+}
+
+int dibiff::generator::SampleGenerator::analysisHop() const {
+    return std::max(1, static_cast<int>(std::lround(vocoderHop / stretch)));
+}
+
+void dibiff::generator::SampleGenerator::vocode() {
+    if (vocoders.size() != samples.size()) {
+        vocoders.clear();
+        for (int i = 0; i < samples.size(); ++i) {
+            vocoders.emplace_back(std::make_unique<dibiff::util::PhaseVocoder>(vocoderSize, vocoderHop));
+        }
+        frame.resize(vocoderSize);
+    }
+    const long size = samples.empty() ? 0 : static_cast<long>(samples[0].size());
+    const int hop = analysisHop();
+    for (int i = 0; i < samples.size(); ++i) {
+        std::vector<float>& out = ready[i];
+        const std::size_t end = out.size();
+        out.resize(end + vocoderHop, 0.0f);
+        /// Once the last frame has left the overlap-add there is only silence
+        if (analysisPosition >= size + static_cast<long>(vocoderSize / vocoderHop) * hop) {
+            continue;
+        }
+        for (int n = 0; n < vocoderSize; ++n) {
+            const long at = analysisPosition + n;
+            frame[n] = at >= 0 && at < size ? samples[i][at] : 0.0f;
+        }
+        vocoders[i]->setPitch(pitch);
+        vocoders[i]->process(frame.data(), hop, out.data() + end);
+    }
+    analysisPosition += hop;
+}
+
+void dibiff::generator::SampleGenerator::setPitch(float semitones) {
+    pitch = std::pow(2.0f, semitones / 12.0f);
+}
+
+void dibiff::generator::SampleGenerator::setStretch(float stretch) {
+    if (stretch <= 0.0f) {
+        throw std::runtime_error("Stretch must be positive.");
+    }
+    this->stretch = stretch;
+}
+
+void dibiff::generator::SampleGenerator::setVocoderSize(int fftSize, int hop) {
+    /// Check the layout before the next note needs it
+    dibiff::util::PhaseVocoder(fftSize, hop);
+    vocoderSize = fftSize;
+    vocoderHop = hop;
+    vocoders.clear();
+}
+
 bool dibiff::generator::SampleGenerator::isReadyToProcess() const {
     return !processed;
 }
 
+void dibiff::generator::SampleGenerator::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
+
 bool dibiff::generator::SampleGenerator::isFinished() const {
     return false;
 }
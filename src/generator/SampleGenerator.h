@@ -5,6 +5,8 @@
 #include "generator.h"
 #include "../graph/graph.h"
 #include "../inc/Eigen/Dense"
+#include "../util/HugePages.h"
+#include "../util/PhaseVocoder.h"
 
 class dibiff::generator::SampleGenerator : public dibiff::generator::Generator {
     public:
@@ -16,15 +18,31 @@ class dibiff::generator::SampleGenerator : public dibiff::generator::Generator {
         void reset() override;
         void clear() override {}
         bool isReadyToProcess() const override;
+        void setBlockSize(int blockSize) override;
         bool isFinished() const override;
+        void setPitch(float semitones);
+        void setStretch(float stretch);
+        void setVocoderSize(int fftSize, int hop);
         static std::unique_ptr<SampleGenerator> create(std::string filename, int blockSize, int sampleRate);
     private:
         std::string filename;
         int blockSize;
         int sampleRate;
-        std::vector<Eigen::VectorXf> samples;
+        std::vector<dibiff::util::HugeVector<float>> samples;
         int totalSamples;
         int currentSample;
+        float pitch = 1.0f;
+        float stretch = 1.0f;
+        int vocoderSize = 2048;
+        int vocoderHop = 512;
+        bool vocoding = false;
+        long analysisPosition = 0;
+        std::vector<std::unique_ptr<dibiff::util::PhaseVocoder>> vocoders;
+        std::vector<std::vector<float>> ready;
+        std::vector<float> frame;
         void loadSamples(std::string filename);
         int hasNoteOnNoteOff(std::vector<unsigned char> message);
+        void start();
+        int analysisHop() const;
+        void vocode();
 };
\ No newline at end of file
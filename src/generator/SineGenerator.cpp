@@ -12,7 +12,8 @@
  * @param samples The total number of samples to generate
  * @param blockSize The block size of the sine wave
  */
-dibiff::generator::SineGenerator::SineGenerator(int blockSize, int sampleRate, float frequency, int totalSamples)
+template<typename StateType>
+dibiff::generator::BasicSineGenerator<StateType>::BasicSineGenerator(int blockSize, int sampleRate, float frequency, int totalSamples)
 : dibiff::generator::Generator(), 
   blockSize(blockSize), sampleRate(sampleRate), frequency(frequency), totalSamples(totalSamples), phase(0.0f) {
     name = "SineGenerator";
@@ -21,7 +22,8 @@ dibiff::generator::SineGenerator::SineGenerator(int blockSize, int sampleRate, f
  * @brief Initialize
  * @details Initializes the sine wave source connection points
  */
-void dibiff::generator::SineGenerator::initialize() {
+template<typename StateType>
+void dibiff::generator::BasicSineGenerator<StateType>::initialize() {
     auto i = std::make_unique<dibiff::graph::MidiInput>(dibiff::graph::MidiInput(this, "SineGeneratorMidiInput"));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::MidiInput*>(_inputs.back().get());
@@ -33,7 +35,8 @@ void dibiff::generator::SineGenerator::initialize() {
  * @brief Generate a block of samples
  * @details Generates a block of audio data
  */
-void dibiff::generator::SineGenerator::process() {
+template<typename StateType>
+void dibiff::generator::BasicSineGenerator<StateType>::process() {
     // If there is a duration set, and we've gone past it, stop generating samples
     if (totalSamples != -1 && currentSample >= totalSamples) {
         return;
@@ -48,16 +51,18 @@ void dibiff::generator::SineGenerator::process() {
         freq = midiFrequency;
     }
     // Calculate phase increment based on the current frequency
-    float phaseIncrement = 2.0f * static_cast<float>(M_PI) * freq / sampleRate;
+    using Vector = Eigen::Matrix<StateType, Eigen::Dynamic, 1>;
+    const StateType twoPi = static_cast<StateType>(2.0 * M_PI);
+    StateType phaseIncrement = twoPi * freq / static_cast<StateType>(sampleRate);
     // Generate samples using Eigen vectorized operations
-    Eigen::VectorXf indices = Eigen::VectorXf::LinSpaced(blockSize, 0, blockSize - 1);
-    Eigen::VectorXf phaseArray = (indices.array() * phaseIncrement + phase).cast<float>();
+    Vector indices = Vector::LinSpaced(blockSize, 0, blockSize - 1);
+    Vector phaseArray = indices.array() * phaseIncrement + phase;
     // Wrap phase values within [0, 2π]
-    phaseArray = phaseArray.unaryExpr([](float x) { return std::fmod(x, 2.0f * static_cast<float>(M_PI)); });
-    Eigen::VectorXf audioData = phaseArray.array().sin();
+    phaseArray = phaseArray.unaryExpr([twoPi](StateType x) { return std::fmod(x, twoPi); });
+    Eigen::VectorXf audioData = phaseArray.array().sin().template cast<float>();
     // Update the current sample count and phase
     currentSample += blockSize;
-    phase = std::fmod(phase + blockSize * phaseIncrement, 2.0f * static_cast<float>(M_PI));
+    phase = std::fmod(phase + blockSize * phaseIncrement, twoPi);
     // Update the last frequency to the new frequency
     lastFrequency = freq;
     // Preserve size if we've exceeded the total number of samples
@@ -71,27 +76,39 @@ void dibiff::generator::SineGenerator::process() {
 }
 /**
  * @brief Reset the sine wave source
- * @details Resets the current sample index
+ * @details Resets the current sample index and the phase
  */
-void dibiff::generator::SineGenerator::reset() {
+template<typename StateType>
+void dibiff::generator::BasicSineGenerator<StateType>::reset() {
     currentSample = 0;
+    phase = 0;
     processed = false;
 }
 /**
  * @brief Check if the filter is ready to process
  * @return True if the filter is ready to process, false otherwise
  */
-bool dibiff::generator::SineGenerator::isReadyToProcess() const {
+template<typename StateType>
+bool dibiff::generator::BasicSineGenerator<StateType>::isReadyToProcess() const {
     if (totalSamples == -1) {
         return !processed;
     }
     return currentSample < totalSamples && !processed;
 }
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+template<typename StateType>
+void dibiff::generator::BasicSineGenerator<StateType>::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
 /**
  * @brief Check if the sine wave source is finished
  * @return True if the sine wave source has finished generating samples, false otherwise
  */
-bool dibiff::generator::SineGenerator::isFinished() const {
+template<typename StateType>
+bool dibiff::generator::BasicSineGenerator<StateType>::isFinished() const {
     if (totalSamples == -1) {
         return false;
     }
@@ -104,8 +121,9 @@ bool dibiff::generator::SineGenerator::isFinished() const {
  * @param frequency The frequency of the sine wave, used if the MIDI input is not connected
  * @param totalSamples The total number of samples to generate
  */
-std::unique_ptr<dibiff::generator::SineGenerator> dibiff::generator::SineGenerator::create(int blockSize, float sampleRate, float frequency, int totalSamples) {
-    auto instance = std::make_unique<dibiff::generator::SineGenerator>(blockSize, sampleRate, frequency, totalSamples);
+template<typename StateType>
+std::unique_ptr<dibiff::generator::BasicSineGenerator<StateType>> dibiff::generator::BasicSineGenerator<StateType>::create(int blockSize, float sampleRate, float frequency, int totalSamples) {
+    auto instance = std::make_unique<dibiff::generator::BasicSineGenerator<StateType>>(blockSize, sampleRate, frequency, totalSamples);
     instance->initialize();
     return std::move(instance);
 }
@@ -116,9 +134,13 @@ std::unique_ptr<dibiff::generator::SineGenerator> dibiff::generator::SineGenerat
  * @param frequency The frequency of the sine wave, used if the MIDI input is not connected
  * @param duration The duration of the sine wave
  */
-std::unique_ptr<dibiff::generator::SineGenerator> dibiff::generator::SineGenerator::create(int blockSize, float sampleRate, float frequency, std::chrono::duration<int> duration) {
+template<typename StateType>
+std::unique_ptr<dibiff::generator::BasicSineGenerator<StateType>> dibiff::generator::BasicSineGenerator<StateType>::create(int blockSize, float sampleRate, float frequency, std::chrono::duration<int> duration) {
     int totalSamples = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() * sampleRate / 1000.0f);
-    auto instance = std::make_unique<dibiff::generator::SineGenerator>(blockSize, sampleRate, frequency, totalSamples);
+    auto instance = std::make_unique<dibiff::generator::BasicSineGenerator<StateType>>(blockSize, sampleRate, frequency, totalSamples);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::generator::BasicSineGenerator<float>;
+template class dibiff::generator::BasicSineGenerator<double>;
\ No newline at end of file
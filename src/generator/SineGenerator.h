@@ -14,8 +14,10 @@
  * @param rate The sample rate of the sine wave
  * @param samples The total number of samples to generate
  * @param blockSize The block size of the sine wave
+ * @tparam StateType The type of the phase accumulator, float or double
  */
-class dibiff::generator::SineGenerator : public dibiff::generator::Generator {
+template<typename StateType>
+class dibiff::generator::BasicSineGenerator : public dibiff::generator::Generator {
     public:
         dibiff::graph::MidiInput* input;
         dibiff::graph::AudioOutput* output;
@@ -28,7 +30,7 @@ class dibiff::generator::SineGenerator : public dibiff::generator::Generator {
          * @param frequency The frequency of the sine wave, used if the MIDI input is not connected
          * @param totalSamples The total number of samples to generate
          */
-        SineGenerator(int blockSize, int sampleRate, float frequency = 1000.0f, int totalSamples = -1);
+        BasicSineGenerator(int blockSize, int sampleRate, float frequency = 1000.0f, int totalSamples = -1);
         /**
          * @brief Initialize
          * @details Initializes the sine wave source connection points
@@ -54,6 +56,11 @@ class dibiff::generator::SineGenerator : public dibiff::generator::Generator {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
         /**
          * @brief Check if the sine wave source is finished
          * @return True if the sine wave source has finished generating samples, false otherwise
@@ -66,7 +73,7 @@ class dibiff::generator::SineGenerator : public dibiff::generator::Generator {
          * @param frequency The frequency of the sine wave, used if the MIDI input is not connected
          * @param totalSamples The total number of samples to generate
          */
-        static std::unique_ptr<SineGenerator> create(int blockSize, float sampleRate, float frequency = 1000.0f, int totalSamples = -1);
+        static std::unique_ptr<BasicSineGenerator> create(int blockSize, float sampleRate, float frequency = 1000.0f, int totalSamples = -1);
         /**
          * Create a new sine wave source object
          * @param rate The sample rate of the sine wave
@@ -74,12 +81,12 @@ class dibiff::generator::SineGenerator : public dibiff::generator::Generator {
          * @param frequency The frequency of the sine wave, used if the MIDI input is not connected
          * @param totalSamples The total number of samples to generate
          */
-        static std::unique_ptr<SineGenerator> create(int blockSize, float sampleRate, float frequency, std::chrono::duration<int> duration);
+        static std::unique_ptr<BasicSineGenerator> create(int blockSize, float sampleRate, float frequency, std::chrono::duration<int> duration);
     private:
         int blockSize;
         int sampleRate;
         float frequency;
         int totalSamples;
         int currentSample;
-        float phase;
+        StateType phase;
 };
\ No newline at end of file
@@ -13,7 +13,8 @@
  * @param frequency The frequency of the square wave, used if the MIDI input is not connected
  * @param totalSamples The total number of samples to generate
  */
-dibiff::generator::SquareGenerator::SquareGenerator(int blockSize, int sampleRate, float dutyCycle, float frequency, int totalSamples)
+template<typename StateType>
+dibiff::generator::BasicSquareGenerator<StateType>::BasicSquareGenerator(int blockSize, int sampleRate, float dutyCycle, float frequency, int totalSamples)
 : dibiff::generator::Generator(), 
   blockSize(blockSize), sampleRate(sampleRate), dutyCycle(dutyCycle), frequency(frequency), totalSamples(totalSamples), phase(0.0f) {
     name = "SquareGenerator";
@@ -22,7 +23,8 @@ dibiff::generator::SquareGenerator::SquareGenerator(int blockSize, int sampleRat
  * @brief Initialize
  * @details Initializes the square wave source connection points
  */
-void dibiff::generator::SquareGenerator::initialize() {
+template<typename StateType>
+void dibiff::generator::BasicSquareGenerator<StateType>::initialize() {
     auto i = std::make_unique<dibiff::graph::MidiInput>(dibiff::graph::MidiInput(this, "SquareGeneratorMidiInput"));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::MidiInput*>(_inputs.back().get());
@@ -34,7 +36,8 @@ void dibiff::generator::SquareGenerator::initialize() {
  * @brief Generate a block of samples
  * @details Generates a block of audio data
  */
-void dibiff::generator::SquareGenerator::process() {
+template<typename StateType>
+void dibiff::generator::BasicSquareGenerator<StateType>::process() {
     // If there is a duration set, and we've gone past it, stop generating samples
     if (totalSamples != -1 && currentSample >= totalSamples) {
         return;
@@ -49,18 +52,20 @@ void dibiff::generator::SquareGenerator::process() {
         freq = midiFrequency;
     }
     // Calculate phase increment based on the current frequency
-    float phaseIncrement = 2.0f * static_cast<float>(M_PI) * freq / sampleRate;
+    using Vector = Eigen::Matrix<StateType, Eigen::Dynamic, 1>;
+    const StateType twoPi = static_cast<StateType>(2.0 * M_PI);
+    StateType phaseIncrement = twoPi * freq / static_cast<StateType>(sampleRate);
     // Generate samples using Eigen vectorized operations
-    Eigen::VectorXf indices = Eigen::VectorXf::LinSpaced(blockSize, 0, blockSize - 1);
-    Eigen::VectorXf phaseArray = (indices.array() * phaseIncrement + phase).cast<float>();
+    Vector indices = Vector::LinSpaced(blockSize, 0, blockSize - 1);
+    Vector phaseArray = indices.array() * phaseIncrement + phase;
     // Wrap phase values within [0, 2π]
-    phaseArray = phaseArray.unaryExpr([](float x) { return std::fmod(x, 2.0f * static_cast<float>(M_PI)); });
+    phaseArray = phaseArray.unaryExpr([twoPi](StateType x) { return std::fmod(x, twoPi); });
     // Calculate the square wave values based on the phase and duty cycle
-    Eigen::VectorXf audioData = (phaseArray.array() < dutyCycle * 2.0f * static_cast<float>(M_PI))
+    Eigen::VectorXf audioData = (phaseArray.array() < dutyCycle * twoPi)
         .select(Eigen::VectorXf::Constant(blockSize, 1.0f), Eigen::VectorXf::Constant(blockSize, -1.0f));
     // Update the current sample count and phase
     currentSample += blockSize;
-    phase = std::fmod(phase + blockSize * phaseIncrement, 2.0f * static_cast<float>(M_PI));
+    phase = std::fmod(phase + blockSize * phaseIncrement, twoPi);
     // Update the last frequency to the new frequency
     lastFrequency = freq;
     // Preserve size if we've exceeded the total number of samples
@@ -74,27 +79,39 @@ void dibiff::generator::SquareGenerator::process() {
 }
 /**
  * @brief Reset the square wave source
- * @details Resets the current sample index
+ * @details Resets the current sample index and the phase
  */
-void dibiff::generator::SquareGenerator::reset() {
+template<typename StateType>
+void dibiff::generator::BasicSquareGenerator<StateType>::reset() {
     currentSample = 0;
+    phase = 0;
     processed = false;
 }
 /**
  * @brief Check if the filter is ready to process
  * @return True if the filter is ready to process, false otherwise
  */
-bool dibiff::generator::SquareGenerator::isReadyToProcess() const {
+template<typename StateType>
+bool dibiff::generator::BasicSquareGenerator<StateType>::isReadyToProcess() const {
     if (totalSamples == -1) {
         return !processed;
     }
     return currentSample < totalSamples && !processed;
 }
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+template<typename StateType>
+void dibiff::generator::BasicSquareGenerator<StateType>::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
 /**
  * @brief Check if the square wave source is finished
  * @return True if the square wave source has finished generating samples, false otherwise
  */
-bool dibiff::generator::SquareGenerator::isFinished() const {
+template<typename StateType>
+bool dibiff::generator::BasicSquareGenerator<StateType>::isFinished() const {
     if (totalSamples == -1) {
         return false;
     }
@@ -108,8 +125,9 @@ bool dibiff::generator::SquareGenerator::isFinished() const {
  * @param frequency The frequency of the square wave, used if the MIDI input is not connected
  * @param totalSamples The total number of samples to generate
  */
-std::unique_ptr<dibiff::generator::SquareGenerator> dibiff::generator::SquareGenerator::create(int blockSize, int sampleRate, float dutyCycle, float frequency, int totalSamples) {
-    auto instance = std::make_unique<dibiff::generator::SquareGenerator>(blockSize, sampleRate, dutyCycle, frequency, totalSamples);
+template<typename StateType>
+std::unique_ptr<dibiff::generator::BasicSquareGenerator<StateType>> dibiff::generator::BasicSquareGenerator<StateType>::create(int blockSize, int sampleRate, float dutyCycle, float frequency, int totalSamples) {
+    auto instance = std::make_unique<dibiff::generator::BasicSquareGenerator<StateType>>(blockSize, sampleRate, dutyCycle, frequency, totalSamples);
     instance->initialize();
     return std::move(instance);
 }
@@ -121,9 +139,13 @@ std::unique_ptr<dibiff::generator::SquareGenerator> dibiff::generator::SquareGen
  * @param frequency The frequency of the square wave, used if the MIDI input is not connected
  * @param duration The length of time to generate samples
  */
-std::unique_ptr<dibiff::generator::SquareGenerator> dibiff::generator::SquareGenerator::create(int blockSize, int sampleRate, float dutyCycle, float frequency, std::chrono::duration<int> duration) {
+template<typename StateType>
+std::unique_ptr<dibiff::generator::BasicSquareGenerator<StateType>> dibiff::generator::BasicSquareGenerator<StateType>::create(int blockSize, int sampleRate, float dutyCycle, float frequency, std::chrono::duration<int> duration) {
     int samples = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() * sampleRate / 1000.0f);
-    auto instance = std::make_unique<dibiff::generator::SquareGenerator>(blockSize, sampleRate, dutyCycle, frequency, samples);
+    auto instance = std::make_unique<dibiff::generator::BasicSquareGenerator<StateType>>(blockSize, sampleRate, dutyCycle, frequency, samples);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::generator::BasicSquareGenerator<float>;
+template class dibiff::generator::BasicSquareGenerator<double>;
\ No newline at end of file
@@ -15,8 +15,10 @@
  * @param samples The total number of samples to generate
  * @param blockSize The block size of the square wave
  * @param dutyCycle The duty cycle of the square wave (default is 0.5)
+ * @tparam StateType The type of the phase accumulator, float or double
  */
-class dibiff::generator::SquareGenerator : public dibiff::generator::Generator {
+template<typename StateType>
+class dibiff::generator::BasicSquareGenerator : public dibiff::generator::Generator {
     public:
         dibiff::graph::MidiInput* input;
         dibiff::graph::AudioOutput* output;
@@ -30,7 +32,7 @@ class dibiff::generator::SquareGenerator : public dibiff::generator::Generator {
          * @param frequency The frequency of the square wave, used if the MIDI input is not connected
          * @param totalSamples The total number of samples to generate
          */
-        SquareGenerator(int blockSize, int sampleRate, float dutyCycle = 0.5f, float frequency = 1000.0f, int totalSamples = -1);
+        BasicSquareGenerator(int blockSize, int sampleRate, float dutyCycle = 0.5f, float frequency = 1000.0f, int totalSamples = -1);
         /**
          * @brief Initialize
          * @details Initializes the square wave source connection points
@@ -56,6 +58,11 @@ class dibiff::generator::SquareGenerator : public dibiff::generator::Generator {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
         /**
          * @brief Check if the square wave source is finished
          * @return True if the square wave source has finished generating samples, false otherwise
@@ -69,7 +76,7 @@ class dibiff::generator::SquareGenerator : public dibiff::generator::Generator {
          * @param frequency The frequency of the square wave, used if the MIDI input is not connected
          * @param totalSamples The total number of samples to generate
          */
-        static std::unique_ptr<SquareGenerator> create(int blockSize, int sampleRate, float dutyCycle = 0.5f, float frequency = 1000.0f, int totalSamples = -1);
+        static std::unique_ptr<BasicSquareGenerator> create(int blockSize, int sampleRate, float dutyCycle = 0.5f, float frequency = 1000.0f, int totalSamples = -1);
         /**
          * Create a new square wave source object
          * @param blockSize The block size of the square wave
@@ -78,7 +85,7 @@ class dibiff::generator::SquareGenerator : public dibiff::generator::Generator {
          * @param frequency The frequency of the square wave, used if the MIDI input is not connected
          * @param duration The length of time to generate samples
          */
-        static std::unique_ptr<SquareGenerator> create(int blockSize, int sampleRate, float dutyCycle, float frequency, std::chrono::duration<int> duration);
+        static std::unique_ptr<BasicSquareGenerator> create(int blockSize, int sampleRate, float dutyCycle, float frequency, std::chrono::duration<int> duration);
     private:
         int blockSize;
         int sampleRate;
@@ -86,5 +93,5 @@ class dibiff::generator::SquareGenerator : public dibiff::generator::Generator {
         float frequency;
         int totalSamples;
         int currentSample;
-        float phase;
+        StateType phase;
 };
\ No newline at end of file
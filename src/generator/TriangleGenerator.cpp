@@ -12,7 +12,8 @@
  * @param frequency The frequency of the triangle wave
  * @param totalSamples The total number of samples to generate
  */
-dibiff::generator::TriangleGenerator::TriangleGenerator(int blockSize, int sampleRate, float frequency, int totalSamples)
+template<typename StateType>
+dibiff::generator::BasicTriangleGenerator<StateType>::BasicTriangleGenerator(int blockSize, int sampleRate, float frequency, int totalSamples)
 : dibiff::generator::Generator(), 
   blockSize(blockSize), sampleRate(sampleRate), frequency(frequency), totalSamples(totalSamples), phase(0.0f) {
     name = "TriangleGenerator";
@@ -21,7 +22,8 @@ dibiff::generator::TriangleGenerator::TriangleGenerator(int blockSize, int sampl
  * @brief Initialize
  * @details Initializes the triangle wave source connection points
  */
-void dibiff::generator::TriangleGenerator::initialize() {
+template<typename StateType>
+void dibiff::generator::BasicTriangleGenerator<StateType>::initialize() {
     auto i = std::make_unique<dibiff::graph::MidiInput>(dibiff::graph::MidiInput(this, "TriangleGeneratorMidiInput"));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::MidiInput*>(_inputs.back().get());
@@ -32,10 +34,11 @@ void dibiff::generator::TriangleGenerator::initialize() {
 /**
  * @brief Generate a block of samples
  * @details Generates a block of audio data
- * Unfortunately this requires double precision to prevent floating point errors 
- * contributing to phase misalignment.
+ * Single precision phase accumulation drifts over long runs, so the default
+ * TriangleGenerator accumulates its phase in double precision.
  */
-void dibiff::generator::TriangleGenerator::process() {
+template<typename StateType>
+void dibiff::generator::BasicTriangleGenerator<StateType>::process() {
     // If there is a duration set, and we've gone past it, stop generating samples
     if (totalSamples != -1 && currentSample >= totalSamples) {
         return;
@@ -50,19 +53,22 @@ void dibiff::generator::TriangleGenerator::process() {
         freq = midiFrequency;
     }
     // Calculate phase increment based on the current frequency
-    double phaseIncrement = 2.0 * M_PI * freq / static_cast<double>(sampleRate);
+    using Vector = Eigen::Matrix<StateType, Eigen::Dynamic, 1>;
+    const StateType pi = static_cast<StateType>(M_PI);
+    const StateType twoPi = static_cast<StateType>(2.0 * M_PI);
+    StateType phaseIncrement = twoPi * freq / static_cast<StateType>(sampleRate);
     // Generate samples using Eigen vectorized operations
-    Eigen::VectorXd indices = Eigen::VectorXd::LinSpaced(blockSize, 0, blockSize - 1);
-    Eigen::VectorXd phaseArray = (indices.array() * phaseIncrement + phase + M_PI / 2.0).cast<double>();
+    Vector indices = Vector::LinSpaced(blockSize, 0, blockSize - 1);
+    Vector phaseArray = indices.array() * phaseIncrement + phase + pi / StateType(2);
     // Wrap phase values within [0, 2π]
-    phaseArray = phaseArray.unaryExpr([](double x) { return std::fmod(x, 2.0 * M_PI); });
+    phaseArray = phaseArray.unaryExpr([twoPi](StateType x) { return std::fmod(x, twoPi); });
     // Calculate the triangle wave values based on the phase
-    Eigen::VectorXd audioData = phaseArray.unaryExpr([](double x) {
-        return x < M_PI ? -1.0 + (2.0 / M_PI) * x : 3.0 - (2.0 / M_PI) * x;
-    });
+    Eigen::VectorXf audioData = phaseArray.unaryExpr([pi](StateType x) {
+        return x < pi ? StateType(-1) + (StateType(2) / pi) * x : StateType(3) - (StateType(2) / pi) * x;
+    }).template cast<float>();
     // Update the current sample count and phase
     currentSample += blockSize;
-    phase = std::fmod(phase + blockSize * phaseIncrement, 2.0 * M_PI);
+    phase = std::fmod(phase + blockSize * phaseIncrement, twoPi);
     // Update the last frequency to the new frequency
     lastFrequency = freq;
     // Preserve size if we've exceeded the total number of samples
@@ -76,27 +82,39 @@ void dibiff::generator::TriangleGenerator::process() {
 }
 /**
  * @brief Reset the triangle wave source
- * @details Resets the current sample index
+ * @details Resets the current sample index and the phase
  */
-void dibiff::generator::TriangleGenerator::reset() {
+template<typename StateType>
+void dibiff::generator::BasicTriangleGenerator<StateType>::reset() {
     currentSample = 0;
+    phase = 0;
     processed = false;
 }
 /**
  * @brief Check if the filter is ready to process
  * @return True if the filter is ready to process, false otherwise
  */
-bool dibiff::generator::TriangleGenerator::isReadyToProcess() const {
+template<typename StateType>
+bool dibiff::generator::BasicTriangleGenerator<StateType>::isReadyToProcess() const {
     if (totalSamples == -1) {
         return !processed;
     }
     return currentSample < totalSamples && !processed;
 }
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+template<typename StateType>
+void dibiff::generator::BasicTriangleGenerator<StateType>::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
 /**
  * @brief Check if the triangle wave source is finished
  * @return True if the triangle wave source has finished generating samples, false otherwise
  */
-bool dibiff::generator::TriangleGenerator::isFinished() const {
+template<typename StateType>
+bool dibiff::generator::BasicTriangleGenerator<StateType>::isFinished() const {
     if (totalSamples == -1) {
         return false;
     }
@@ -109,8 +127,9 @@ bool dibiff::generator::TriangleGenerator::isFinished() const {
  * @param frequency The frequency of the triangle wave
  * @param totalSamples The total number of samples to generate
  */
-std::unique_ptr<dibiff::generator::TriangleGenerator> dibiff::generator::TriangleGenerator::create(int blockSize, int sampleRate, float frequency, int totalSamples) {
-    auto instance = std::make_unique<dibiff::generator::TriangleGenerator>(blockSize, sampleRate, frequency, totalSamples);
+template<typename StateType>
+std::unique_ptr<dibiff::generator::BasicTriangleGenerator<StateType>> dibiff::generator::BasicTriangleGenerator<StateType>::create(int blockSize, int sampleRate, float frequency, int totalSamples) {
+    auto instance = std::make_unique<dibiff::generator::BasicTriangleGenerator<StateType>>(blockSize, sampleRate, frequency, totalSamples);
     instance->initialize();
     return std::move(instance);
 }
@@ -121,9 +140,13 @@ std::unique_ptr<dibiff::generator::TriangleGenerator> dibiff::generator::Triangl
  * @param frequency The frequency of the triangle wave
  * @param duration The total duration of samples to generate
  */
-std::unique_ptr<dibiff::generator::TriangleGenerator> dibiff::generator::TriangleGenerator::create(int blockSize, int sampleRate, float frequency, std::chrono::duration<int> duration) {
+template<typename StateType>
+std::unique_ptr<dibiff::generator::BasicTriangleGenerator<StateType>> dibiff::generator::BasicTriangleGenerator<StateType>::create(int blockSize, int sampleRate, float frequency, std::chrono::duration<int> duration) {
     int totalSamples = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() * sampleRate / 1000.0f);
-    auto instance = std::make_unique<dibiff::generator::TriangleGenerator>(blockSize, sampleRate, frequency, totalSamples);
+    auto instance = std::make_unique<dibiff::generator::BasicTriangleGenerator<StateType>>(blockSize, sampleRate, frequency, totalSamples);
     instance->initialize();
     return std::move(instance);
-}
\ No newline at end of file
+}
+
+template class dibiff::generator::BasicTriangleGenerator<float>;
+template class dibiff::generator::BasicTriangleGenerator<double>;
\ No newline at end of file
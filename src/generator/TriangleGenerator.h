@@ -14,8 +14,10 @@
  * @param rate The sample rate of the triangle wave
  * @param samples The total number of samples to generate
  * @param blockSize The block size of the triangle wave
+ * @tparam StateType The type of the phase accumulator, float or double
  */
-class dibiff::generator::TriangleGenerator : public dibiff::generator::Generator {
+template<typename StateType>
+class dibiff::generator::BasicTriangleGenerator : public dibiff::generator::Generator {
     public:
         dibiff::graph::MidiInput* input;
         dibiff::graph::AudioOutput* output;
@@ -28,7 +30,7 @@ class dibiff::generator::TriangleGenerator : public dibiff::generator::Generator
          * @param frequency The frequency of the triangle wave
          * @param totalSamples The total number of samples to generate
          */
-        TriangleGenerator(int blockSize, int sampleRate, float frequency = 1000.0f, int totalSamples = -1);
+        BasicTriangleGenerator(int blockSize, int sampleRate, float frequency = 1000.0f, int totalSamples = -1);
         /**
          * @brief Initialize
          * @details Initializes the triangle wave source connection points
@@ -54,6 +56,11 @@ class dibiff::generator::TriangleGenerator : public dibiff::generator::Generator
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
         /**
          * @brief Check if the triangle wave source is finished
          * @return True if the triangle wave source has finished generating samples, false otherwise
@@ -66,7 +73,7 @@ class dibiff::generator::TriangleGenerator : public dibiff::generator::Generator
          * @param frequency The frequency of the triangle wave
          * @param totalSamples The total number of samples to generate
          */
-        static std::unique_ptr<TriangleGenerator> create(int blockSize, int sampleRate, float frequency = 1000.0f, int totalSamples = -1);
+        static std::unique_ptr<BasicTriangleGenerator> create(int blockSize, int sampleRate, float frequency = 1000.0f, int totalSamples = -1);
         /**
          * Create a new triangle wave source object
          * @param blockSize The block size of the triangle wave
@@ -74,12 +81,12 @@ class dibiff::generator::TriangleGenerator : public dibiff::generator::Generator
          * @param frequency The frequency of the triangle wave
          * @param duration The total duration of samples to generate
          */
-        static std::unique_ptr<TriangleGenerator> create(int blockSize, int sampleRate, float frequency, std::chrono::duration<int> duration);
+        static std::unique_ptr<BasicTriangleGenerator> create(int blockSize, int sampleRate, float frequency, std::chrono::duration<int> duration);
     private:
         int blockSize;
         int sampleRate;
         float frequency;
         int totalSamples;
         int currentSample;
-        float phase;
+        StateType phase;
 };
\ No newline at end of file
@@ -128,6 +128,7 @@ void dibiff::generator::VariableGenerator::generateTriangle(float freq) {
 
 void dibiff::generator::VariableGenerator::reset() {
     currentSample = 0;
+    phase = 0;
     processed = false;
 }
 
@@ -138,6 +139,10 @@ bool dibiff::generator::VariableGenerator::isReadyToProcess() const {
     return currentSample < totalSamples && !processed;
 }
 
+void dibiff::generator::VariableGenerator::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
+
 bool dibiff::generator::VariableGenerator::isFinished() const {
     if (totalSamples == -1) {
         return false;
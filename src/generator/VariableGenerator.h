@@ -20,6 +20,7 @@ class dibiff::generator::VariableGenerator : public dibiff::generator::Generator
         void reset() override;
         void clear() override {}
         bool isReadyToProcess() const override;
+        void setBlockSize(int blockSize) override;
         bool isFinished() const override;
         static std::unique_ptr<VariableGenerator> create(int blockSize, float sampleRate, float& state, float dutyCycle = 0.5f, float frequency = 1000.0f, int totalSamples = -1);
         void generateSine(float freq);
@@ -64,6 +64,13 @@ bool dibiff::generator::WhiteNoiseGenerator::isReadyToProcess() const {
     }
     return currentSample < totalSamples && !processed;
 }
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+void dibiff::generator::WhiteNoiseGenerator::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
 /**
  * @brief Check if the white noise source is finished
  * @return True if the white noise source has finished generating samples, false otherwise
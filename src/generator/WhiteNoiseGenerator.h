@@ -48,6 +48,11 @@ class dibiff::generator::WhiteNoiseGenerator : public dibiff::generator::Generat
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
         /**
          * @brief Check if the white noise source is finished
          * @return True if the white noise source has finished generating samples, false otherwise
@@ -15,9 +15,12 @@ namespace dibiff {
     namespace generator {
         class GeneratorVoice;
         class Generator;
-        class SineGenerator;
-        class TriangleGenerator;
-        class SquareGenerator;
+        template<typename StateType = float> class BasicSineGenerator;
+        template<typename StateType = double> class BasicTriangleGenerator;
+        template<typename StateType = float> class BasicSquareGenerator;
+        using SineGenerator = BasicSineGenerator<>;
+        using TriangleGenerator = BasicTriangleGenerator<>;
+        using SquareGenerator = BasicSquareGenerator<>;
         class WhiteNoiseGenerator;
         class SampleGenerator;
         class VariableGenerator;
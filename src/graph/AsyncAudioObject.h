@@ -0,0 +1,231 @@
+/// AsyncAudioObject.h
+
+#pragma once
+
+#include "graph.h"
+#include "../util/Executor.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace dibiff {
+    namespace graph {
+        template<typename Result> class AsyncAudioObject;
+    }
+}
+
+/**
+ * @brief Asynchronous Audio Object
+ * @details A base for objects that hand heavy work which does not have to finish within
+ * the current tick, such as analysis, spectrum snapshots or coefficient design, to a
+ * background executor. process() submits a job and later receives its result through a
+ * lock-free mailbox. A result is delivered a declared number of blocks after its job was
+ * submitted, never earlier, so the object's timing does not depend on the executor. A
+ * result that is not ready when due is delivered at the first block it is, or, when
+ * waiting is enabled for deterministic offline rendering, is waited for.
+ * Derived objects implement processBlock() instead of process().
+ * @tparam Result The type of the results, which must be default-constructible and movable
+ */
+template<typename Result>
+class dibiff::graph::AsyncAudioObject : public dibiff::graph::AudioObject {
+    public:
+        using Work = std::function<Result()>;
+        /**
+         * @brief Constructor
+         * @param latency The number of blocks between submitting a job and receiving its result
+         * @param capacity The number of jobs that can be in flight
+         * @param executor The executor that runs the jobs
+         */
+        AsyncAudioObject(int latency, std::size_t capacity = 8, dibiff::util::Executor& executor = dibiff::util::Executor::global());
+        /**
+         * @brief Destructor
+         * @details Waits for the jobs in flight, which refer to the object
+         */
+        ~AsyncAudioObject() override;
+        /**
+         * @brief Process a block of samples
+         * @details Advances the block counter and calls processBlock()
+         */
+        void process() final;
+        /**
+         * @brief Get the latency of the results
+         * @return The number of blocks between submitting a job and receiving its result
+         */
+        int getLatency() const { return latency; }
+        /**
+         * @brief Wait for results that are not ready when due
+         * @details Keeps the output identical from run to run at the cost of stalling the
+         * graph, so it is meant for offline rendering
+         * @param wait Whether to wait
+         */
+        void setWaitForResults(bool wait) { waitForResults = wait; }
+        /**
+         * @brief Get the number of jobs refused because too many were in flight
+         * @return The number of refused jobs
+         */
+        std::size_t getRefused() const { return refused; }
+        /**
+         * @brief Get the number of results received after they were due
+         * @return The number of late results
+         */
+        std::size_t getLate() const { return late; }
+    protected:
+        /**
+         * @brief Process a block of samples
+         * @details Called from process() with the block counter advanced
+         */
+        virtual void processBlock() = 0;
+        /**
+         * @brief Submit a job
+         * @details Real-time safe as long as wrapping the work does not allocate, so
+         * keep captures small. Work that refers to members of the derived object must
+         * be waited for in the derived destructor with waitForJobs().
+         * @param work The work, run on the executor
+         * @return True if the job was submitted, false if too many jobs are in flight
+         */
+        bool submit(Work work);
+        /**
+         * @brief Receive the oldest result that is due
+         * @param result Set to the result
+         * @return True if there was a result
+         */
+        bool receive(Result& result);
+        /**
+         * @brief Wait until every submitted job has run
+         */
+        void waitForJobs();
+        /**
+         * @brief Get the number of blocks processed
+         * @return The block counter
+         */
+        std::uint64_t getBlock() const { return block; }
+    private:
+        struct Slot {
+            std::uint64_t due = 0;
+            Work work;
+            Result result = {};
+            std::atomic<bool> ready{false};
+        };
+        int latency;
+        bool waitForResults = false;
+        dibiff::util::Executor& executor;
+        std::unique_ptr<Slot[]> slots;
+        std::size_t capacity;
+        /// Written by the audio thread only
+        std::uint64_t block = 0;
+        std::uint64_t submitted = 0;
+        std::uint64_t received = 0;
+        std::size_t refused = 0;
+        std::size_t late = 0;
+        std::atomic<std::size_t> inFlight{0};
+};
+
+/**
+ * @brief Constructor
+ * @param latency The number of blocks between submitting a job and receiving its result
+ * @param capacity The number of jobs that can be in flight
+ * @param executor The executor that runs the jobs
+ */
+template<typename Result>
+dibiff::graph::AsyncAudioObject<Result>::AsyncAudioObject(int latency, std::size_t capacity, dibiff::util::Executor& executor)
+: dibiff::graph::AudioObject(), latency(latency), executor(executor), slots(new Slot[capacity]), capacity(capacity) {
+    if (latency < 1) {
+        throw std::runtime_error("Asynchronous latency must be at least one block.");
+    }
+    if (capacity < 1) {
+        throw std::runtime_error("Asynchronous capacity must be at least one job.");
+    }
+}
+/**
+ * @brief Destructor
+ * @details Waits for the jobs in flight, which refer to the object
+ */
+template<typename Result>
+dibiff::graph::AsyncAudioObject<Result>::~AsyncAudioObject() {
+    waitForJobs();
+}
+/**
+ * @brief Wait until every submitted job has run
+ */
+template<typename Result>
+void dibiff::graph::AsyncAudioObject<Result>::waitForJobs() {
+    while (inFlight.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
+/**
+ * @brief Process a block of samples
+ * @details Advances the block counter and calls processBlock()
+ */
+template<typename Result>
+void dibiff::graph::AsyncAudioObject<Result>::process() {
+    ++block;
+    processBlock();
+}
+/**
+ * @brief Submit a job
+ * @details Claims the next slot and posts a job that fills it. The slot is only
+ * reused once its result has been received.
+ * @param work The work, run on the executor
+ * @return True if the job was submitted, false if too many jobs are in flight
+ */
+template<typename Result>
+bool dibiff::graph::AsyncAudioObject<Result>::submit(Work work) {
+    if (submitted - received >= capacity) {
+        ++refused;
+        return false;
+    }
+    Slot* slot = &slots[submitted % capacity];
+    slot->due = block + static_cast<std::uint64_t>(latency);
+    slot->work = std::move(work);
+    inFlight.fetch_add(1, std::memory_order_relaxed);
+    /// The work stays in the slot, so the posted job is small enough not to allocate
+    const bool posted = executor.post([this, slot]() {
+        slot->result = slot->work();
+        slot->work = nullptr;
+        slot->ready.store(true, std::memory_order_release);
+        inFlight.fetch_sub(1, std::memory_order_release);
+    });
+    if (!posted) {
+        slot->work = nullptr;
+        inFlight.fetch_sub(1, std::memory_order_relaxed);
+        ++refused;
+        return false;
+    }
+    ++submitted;
+    return true;
+}
+/**
+ * @brief Receive the oldest result that is due
+ * @details Results arrive in the order their jobs were submitted
+ * @param result Set to the result
+ * @return True if there was a result
+ */
+template<typename Result>
+bool dibiff::graph::AsyncAudioObject<Result>::receive(Result& result) {
+    if (received == submitted) {
+        return false;
+    }
+    Slot* slot = &slots[received % capacity];
+    if (slot->due > block) {
+        return false;
+    }
+    if (!slot->ready.load(std::memory_order_acquire)) {
+        if (!waitForResults) {
+            return false;
+        }
+        while (!slot->ready.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    if (slot->due < block) {
+        ++late;
+    }
+    result = std::move(slot->result);
+    slot->ready.store(false, std::memory_order_relaxed);
+    ++received;
+    return true;
+}
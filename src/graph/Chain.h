@@ -0,0 +1,162 @@
+/// Chain.h
+
+#pragma once
+
+#include "graph.h"
+
+#include <tuple>
+#include <utility>
+
+namespace dibiff {
+    namespace graph {
+        template<typename... Stages> class Chain;
+    }
+}
+
+/**
+ * @brief Chain
+ * @details A chain of audio objects composed at compile time, such as a channel
+ * strip of HighPassFilter -> Compressor -> PeakingEQFilter -> Limiter. Each block
+ * is processed in a single loop that calls every stage's per-sample process(float)
+ * directly, so there is no virtual dispatch, no intermediate buffer and no graph
+ * bookkeeping between the stages. The ports of the stages themselves are not used;
+ * the chain is a single audio object with one mono input and one output.
+ * Stages with per-block parameter updates expose a prepare() function, which is
+ * called once at the start of every block.
+ * @param Stages The types of the stages, in processing order
+ */
+template<typename... Stages>
+class dibiff::graph::Chain : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioInput* input;
+        dibiff::graph::AudioOutput* output;
+        /**
+         * @brief Constructor
+         * @details Takes ownership of the stages of the chain
+         * @param stages The stages, in processing order
+         */
+        Chain(std::unique_ptr<Stages>... stages)
+        : dibiff::graph::AudioObject(), stages(std::move(stages)...) {
+            name = "Chain";
+        }
+        /**
+         * @brief Initialize
+         * @details Initializes the chain connection points
+         */
+        void initialize() override {
+            auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "ChainInput", 1));
+            _inputs.emplace_back(std::move(i));
+            input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+            auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "ChainOutput"));
+            _outputs.emplace_back(std::move(o));
+            output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+        }
+        /**
+         * @brief Process a sample
+         * @details Runs a single sample through every stage of the chain
+         * @param sample The input sample
+         */
+        float process(float sample) {
+            return processStages(sample, std::index_sequence_for<Stages...>{});
+        }
+        /**
+         * @brief Process a block of samples
+         * @details Processes a block of audio data through every stage of the chain
+         */
+        void process() override {
+            if (!input->isConnected()) {
+                /// If no input is connected, just dump zeros into the output
+                std::vector<float> out(input->getBlockSize(), 0.0f);
+                output->setData(out, input->getBlockSize());
+                markProcessed();
+            } else if (input->isReady()) {
+                const std::vector<float>& data = input->getData();
+                const int blockSize = input->getBlockSize();
+                prepareStages(std::index_sequence_for<Stages...>{});
+                std::vector<float> out(blockSize);
+                for (int i = 0; i < blockSize; ++i) {
+                    out[i] = processStages(data[i], std::index_sequence_for<Stages...>{});
+                }
+                output->setData(std::move(out), blockSize);
+                markProcessed();
+            }
+        }
+        /**
+         * @brief Reset the chain
+         * @details Resets every stage of the chain
+         */
+        void reset() override {
+            std::apply([](auto&... stage) { (stage->reset(), ...); }, stages);
+        }
+        /**
+         * @brief Clear the chain
+         * @details Clears every stage of the chain
+         */
+        void clear() override {
+            std::apply([](auto&... stage) { (stage->clear(), ...); }, stages);
+        }
+        /**
+         * @brief Check if the chain is finished processing
+         * @return True if the chain is finished processing, false otherwise
+         */
+        bool isFinished() const override {
+            return input->isConnected() && input->isReady() && input->isFinished() && processed;
+        }
+        /**
+         * @brief Check if the chain is ready to process
+         * @return True if the chain is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override {
+            if (!input->isConnected()) {
+                return true;
+            }
+            return input->isReady() && !processed;
+        }
+        /**
+         * @brief Get the state memory of the chain
+         * @return The sum of the state memory of the stages, or -1 if any is unknown
+         */
+        long getStateMemory() const override {
+            long memory = 0;
+            auto add = [&memory](long m) { memory = memory < 0 || m < 0 ? -1 : memory + m; };
+            std::apply([&add](auto&... stage) { (add(stage->getStateMemory()), ...); }, stages);
+            return memory;
+        }
+        /**
+         * @brief Get a stage of the chain
+         * @details Used to change the parameters of a stage
+         * @return The stage at index I
+         */
+        template<std::size_t I>
+        auto* stage() { return std::get<I>(stages).get(); }
+        /**
+         * @brief Create a new chain object
+         * @param stages The stages, in processing order
+         */
+        static std::unique_ptr<Chain> create(std::unique_ptr<Stages>... stages) {
+            auto instance = std::make_unique<Chain>(std::move(stages)...);
+            instance->initialize();
+            return instance;
+        }
+    private:
+        std::tuple<std::unique_ptr<Stages>...> stages;
+        template<typename T, typename = void>
+        struct hasPrepare : std::false_type {};
+        template<typename T>
+        struct hasPrepare<T, std::void_t<decltype(std::declval<T&>().prepare())>> : std::true_type {};
+        template<std::size_t... I>
+        float processStages(float sample, std::index_sequence<I...>) {
+            ((sample = std::get<I>(stages)->process(sample)), ...);
+            return sample;
+        }
+        template<std::size_t... I>
+        void prepareStages(std::index_sequence<I...>) {
+            (prepareStage(*std::get<I>(stages)), ...);
+        }
+        template<typename T>
+        static void prepareStage(T& stage) {
+            if constexpr (hasPrepare<T>::value) {
+                stage.prepare();
+            }
+        }
+};
@@ -0,0 +1,260 @@
+/// Frozen.cpp
+
+#include "Frozen.h"
+#include "../util/EventLog.h"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Frozen Exit
+ * @details Receives the output of the inner graph
+ */
+class dibiff::graph::Frozen::Exit : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioInput* input;
+        Exit() : dibiff::graph::AudioObject() {
+            name = "FrozenExit";
+        }
+        void initialize() override {
+            auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "FrozenExitInput", 0));
+            _inputs.emplace_back(std::move(i));
+            input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+        }
+        void process() override { markProcessed(); }
+        void reset() override {}
+        void clear() override {}
+        bool isFinished() const override { return false; }
+        bool isReadyToProcess() const override {
+            if (!input->isConnected()) {
+                return !processed;
+            }
+            return input->isReady() && !processed;
+        }
+};
+/**
+ * @brief Constructor
+ * @param builder The inner graph builder
+ * @param blockSize The block size of the inner graph and the output
+ * @param length The number of samples to render, one loop period when looping
+ * @param channels The number of channels
+ * @param loop Whether to repeat the render, otherwise the output is silent after it
+ */
+dibiff::graph::Frozen::Frozen(Builder builder, int blockSize, long length, int channels, bool loop)
+: dibiff::graph::AudioObject(), builder(std::move(builder)), blockSize(blockSize), length(length), channels(channels), loop(loop) {
+    name = "Frozen";
+    if (blockSize <= 0 || length <= 0 || channels <= 0) {
+        throw std::runtime_error("Block size, length and channels must be positive.");
+    }
+}
+/**
+ * @brief Destructor
+ * @details Waits for a render in progress, which refers to the frozen graph
+ */
+dibiff::graph::Frozen::~Frozen() {
+    while (rendering.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+/**
+ * @brief Initialize
+ * @details Initializes the connection points and builds the inner graph
+ */
+void dibiff::graph::Frozen::initialize() {
+    auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "FrozenOutput", channels));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+    auto x = std::make_unique<Exit>();
+    x->initialize();
+    exit = graph.add(std::move(x)).get();
+    builder(graph, exit->input);
+}
+/**
+ * @brief Render the inner graph into the cache
+ * @details Ticks the inner graph block by block and keeps the first `length` samples
+ * of each channel. Short blocks are zero-padded to the inner block size, and the rest
+ * of the render is silent once the inner graph has finished. Mono inner graphs are
+ * broadcast to every channel. The render is published for the audio thread to swap in.
+ */
+void dibiff::graph::Frozen::freeze() {
+    std::lock_guard<std::mutex> lock(renderMutex);
+    /// Changes from here on need another render
+    stale.store(false, std::memory_order_release);
+    graph.reset();
+    dibiff::util::HugeVector<float> render(static_cast<std::size_t>(length) * channels, 0.0f);
+    for (long offset = 0; offset < length; offset += blockSize) {
+        graph.tick();
+        if (!exit->input->isConnected() || !exit->isProcessed()) {
+            break;
+        }
+        const long n = std::min(static_cast<long>(std::min(exit->input->getBlockSize(), blockSize)), length - offset);
+        const int innerChannels = exit->input->getChannels();
+        for (int c = 0; c < channels; ++c) {
+            const float* in = exit->input->getChannel(c < innerChannels ? c : 0);
+            std::copy(in, in + n, render.begin() + static_cast<std::size_t>(c) * length + offset);
+        }
+    }
+    /// The back slot is never the one being played, so replacing it here is safe
+    Cache& next = caches.back();
+    if (cacheFile.empty()) {
+        next.heap = std::move(render);
+        next.mapped.reset();
+    } else {
+#ifdef __linux__
+        const std::size_t bytes = render.size() * sizeof(float);
+        /// Written next to the file and renamed over it, so the render being played keeps its mapping
+        const std::string written = cacheFile + ".tmp";
+        {
+            std::ofstream file(written, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(render.data()), bytes);
+            if (!file) {
+                throw std::runtime_error("Failed to write the cache file: " + cacheFile);
+            }
+        }
+        const int fd = open(written.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open the cache file: " + cacheFile);
+        }
+        void* p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Failed to map the cache file: " + cacheFile);
+        }
+        if (std::rename(written.c_str(), cacheFile.c_str()) != 0) {
+            munmap(p, bytes);
+            throw std::runtime_error("Failed to replace the cache file: " + cacheFile);
+        }
+        next.mapped = std::shared_ptr<const float>(static_cast<const float*>(p), [bytes](const float* q) {
+            munmap(const_cast<float*>(q), bytes);
+        });
+        dibiff::util::HugeVector<float>().swap(next.heap);
+#else
+        throw std::runtime_error("Memory-mapped caches are only supported on Linux.");
+#endif
+    }
+    caches.publish();
+    rendered.store(true, std::memory_order_release);
+}
+/**
+ * @brief Process a block of samples
+ * @details Swaps in a finished render, posts a render to the executor if a watched
+ * parameter has changed or the cache is out of date, then copies the next block out
+ * of the cache. The output is silent until the first render is in.
+ */
+void dibiff::graph::Frozen::process() {
+    for (auto& w : watchedFloats) {
+        if (*w.first != w.second) {
+            w.second = *w.first;
+            stale.store(true, std::memory_order_release);
+        }
+    }
+    for (auto& w : watchedInts) {
+        if (*w.first != w.second) {
+            w.second = *w.first;
+            stale.store(true, std::memory_order_release);
+        }
+    }
+    if (stale.load(std::memory_order_acquire) && !rendering.exchange(true, std::memory_order_acq_rel)) {
+        const bool posted = executor.post([this]() {
+            try {
+                freeze();
+            } catch (const std::exception& e) {
+                dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Error, name.c_str(), e.what());
+            }
+            rendering.store(false, std::memory_order_release);
+        });
+        if (!posted) {
+            /// The executor is full, try again next block
+            rendering.store(false, std::memory_order_release);
+        }
+    }
+    cache = caches.read().data();
+    std::vector<float> out(static_cast<std::size_t>(blockSize) * channels, 0.0f);
+    for (int i = 0; i < blockSize && cache != nullptr;) {
+        if (position >= length) {
+            if (!loop) {
+                break;
+            }
+            position = 0;
+        }
+        const long n = std::min(static_cast<long>(blockSize - i), length - position);
+        for (int c = 0; c < channels; ++c) {
+            const float* in = cache + static_cast<std::size_t>(c) * length + position;
+            std::copy(in, in + n, out.begin() + static_cast<std::size_t>(c) * blockSize + i);
+        }
+        position += n;
+        i += static_cast<int>(n);
+    }
+    output->setData(std::move(out), blockSize, channels);
+    markProcessed();
+}
+/**
+ * @brief Reset the frozen graph
+ * @details Rewinds the playback to the start of the render
+ */
+void dibiff::graph::Frozen::reset() {
+    position = 0;
+}
+/**
+ * @brief Check if the frozen graph is finished processing
+ * @return True if the render has been played and does not loop, false otherwise
+ */
+bool dibiff::graph::Frozen::isFinished() const {
+    return !loop && position >= length;
+}
+/**
+ * @brief Check if the frozen graph is ready to process
+ * @return True if the frozen graph is ready to process, false otherwise
+ */
+bool dibiff::graph::Frozen::isReadyToProcess() const {
+    return !processed;
+}
+/**
+ * @brief Set the block size
+ * @details Waits for a render in progress. The cached render is kept.
+ * @param blockSize The new block size
+ */
+void dibiff::graph::Frozen::setBlockSize(int blockSize) {
+    std::lock_guard<std::mutex> lock(renderMutex);
+    this->blockSize = blockSize;
+    graph.setBlockSize(blockSize);
+}
+/**
+ * @brief Watch a parameter of the inner graph
+ * @param parameter The parameter, which must outlive the frozen graph
+ */
+void dibiff::graph::Frozen::watch(const float& parameter) {
+    watchedFloats.emplace_back(&parameter, parameter);
+}
+void dibiff::graph::Frozen::watch(const int& parameter) {
+    watchedInts.emplace_back(&parameter, parameter);
+}
+/**
+ * @brief Memory-map the cache from a file
+ * @param filename The cache file, or an empty string to keep the cache on the heap
+ */
+void dibiff::graph::Frozen::setCacheFile(std::string filename) {
+    std::lock_guard<std::mutex> lock(renderMutex);
+    cacheFile = std::move(filename);
+    stale.store(true, std::memory_order_release);
+}
+/**
+ * @brief Create a new frozen graph object
+ * @param builder The inner graph builder
+ * @param blockSize The block size of the inner graph and the output
+ * @param length The number of samples to render, one loop period when looping
+ * @param channels The number of channels
+ * @param loop Whether to repeat the render, otherwise the output is silent after it
+ */
+std::unique_ptr<dibiff::graph::Frozen> dibiff::graph::Frozen::create(Builder builder, int blockSize, long length, int channels, bool loop) {
+    auto instance = std::make_unique<Frozen>(std::move(builder), blockSize, length, channels, loop);
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,184 @@
+/// Frozen.h
+
+#pragma once
+
+#include "graph.h"
+#include "../util/Executor.h"
+#include "../util/HugePages.h"
+#include "../util/TripleBuffer.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dibiff {
+    namespace graph {
+        class Frozen;
+    }
+}
+
+/**
+ * @brief Frozen
+ * @details A container that renders a deterministic, input-free inner graph once and
+ * plays the cached render back in its place, so generator, filter and effect chains
+ * driven by fixed parameters cost a copy per block instead of their full processing.
+ * The cache holds one loop period, or the whole render when not looping, and can be
+ * memory-mapped from a file instead of held on the heap. Watched parameters are
+ * compared every block, and the inner graph is rendered again from the start when one
+ * changes. The audio thread never renders: freeze() renders on the calling thread, and
+ * a stale cache is rendered on the executor while the previous render keeps playing,
+ * then swapped in at a block boundary. The output is silent until the first render is
+ * in, so call freeze() before ticking for the render to play from the first block.
+ */
+class dibiff::graph::Frozen : public dibiff::graph::AudioObject {
+    public:
+        /**
+         * @brief Inner graph builder
+         * @details Builds the inner graph and connects its output to the given input
+         */
+        using Builder = std::function<void(dibiff::graph::AudioGraph& graph, dibiff::graph::AudioInput* output)>;
+        dibiff::graph::AudioOutput* output;
+        /**
+         * @brief Constructor
+         * @param builder The inner graph builder
+         * @param blockSize The block size of the inner graph and the output
+         * @param length The number of samples to render, one loop period when looping
+         * @param channels The number of channels
+         * @param loop Whether to repeat the render, otherwise the output is silent after it
+         */
+        Frozen(Builder builder, int blockSize, long length, int channels = 1, bool loop = true);
+        /**
+         * @brief Destructor
+         * @details Waits for a render in progress, which refers to the frozen graph
+         */
+        ~Frozen();
+        /**
+         * @brief Initialize
+         * @details Initializes the connection points and builds the inner graph
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Swaps in a finished render, starts a background render if the cache
+         * is out of date, then publishes the next block of the cache
+         */
+        void process() override;
+        /**
+         * @brief Reset the frozen graph
+         * @details Rewinds the playback to the start of the render
+         */
+        void reset() override;
+        /**
+         * @brief Clear the frozen graph
+         * @details Not used
+         */
+        void clear() override {}
+        /**
+         * @brief Check if the frozen graph is finished processing
+         * @return True if the render has been played and does not loop, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the frozen graph is ready to process
+         * @return True if the frozen graph is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @details Changes the block size of the playback and of the inner graph, waiting
+         * for a render in progress. The cached render is kept.
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
+        /**
+         * @brief Render the inner graph into the cache
+         * @details Resets the inner graph and ticks it for the render length on the
+         * calling thread, which must not be the audio thread. The render is swapped in
+         * at the next block.
+         */
+        void freeze();
+        /**
+         * @brief Mark the cache out of date
+         * @details The inner graph is rendered again in the background, starting at the
+         * next block
+         */
+        void invalidate() { stale.store(true, std::memory_order_release); }
+        /**
+         * @brief Check if the cache is up to date
+         * @return True if a render has finished and no newer one is due or in progress
+         */
+        bool isFrozen() const {
+            return rendered.load(std::memory_order_acquire) && !stale.load(std::memory_order_acquire) && !rendering.load(std::memory_order_acquire);
+        }
+        /**
+         * @brief Watch a parameter of the inner graph
+         * @details The cache is rendered again when the value changes
+         * @param parameter The parameter, which must outlive the frozen graph
+         */
+        void watch(const float& parameter);
+        void watch(const int& parameter);
+        /**
+         * @brief Memory-map the cache from a file
+         * @details Each render is written to the file and mapped read-only, so the
+         * cache lives in the page cache rather than on the heap. Only supported on Linux.
+         * @param filename The cache file, or an empty string to keep the cache on the heap
+         */
+        void setCacheFile(std::string filename);
+        /**
+         * @brief Get the cached render
+         * @details The render being played, swapped at block boundaries, so read it
+         * between ticks
+         * @return The planar render, `length` samples per channel, or nullptr before the first render
+         */
+        const float* getCache() const { return cache; }
+        long getLength() const { return length; }
+        long getPosition() const { return position; }
+        /**
+         * @brief Get the inner graph
+         * @return The graph being frozen
+         */
+        dibiff::graph::AudioGraph& getGraph() { return graph; }
+        /**
+         * @brief Create a new frozen graph object
+         * @param builder The inner graph builder
+         * @param blockSize The block size of the inner graph and the output
+         * @param length The number of samples to render, one loop period when looping
+         * @param channels The number of channels
+         * @param loop Whether to repeat the render, otherwise the output is silent after it
+         */
+        static std::unique_ptr<Frozen> create(Builder builder, int blockSize, long length, int channels = 1, bool loop = true);
+    private:
+        class Exit;
+        /// A render, held on the heap or in a read-only mapping of the cache file
+        struct Cache {
+            dibiff::util::HugeVector<float> heap;
+            std::shared_ptr<const float> mapped;
+            const float* data() const { return mapped ? mapped.get() : (heap.empty() ? nullptr : heap.data()); }
+        };
+        Builder builder;
+        int blockSize;
+        long length;
+        int channels;
+        bool loop;
+        long position = 0;
+        dibiff::graph::AudioGraph graph;
+        Exit* exit = nullptr;
+        /// Watched parameters and their values as last seen by the audio thread
+        std::vector<std::pair<const float*, float>> watchedFloats;
+        std::vector<std::pair<const int*, int>> watchedInts;
+        std::string cacheFile;
+        /// Serializes renders, and guards the inner graph and the cache file against them
+        std::mutex renderMutex;
+        /// Renders are written by the renderer and swapped in by the audio thread, which
+        /// never frees or unmaps one
+        dibiff::util::TripleBuffer<Cache> caches;
+        /// The render being played, audio thread only
+        const float* cache = nullptr;
+        std::atomic<bool> stale{true};
+        std::atomic<bool> rendering{false};
+        std::atomic<bool> rendered{false};
+        dibiff::util::Executor& executor = dibiff::util::Executor::global();
+};
@@ -0,0 +1,309 @@
+/// GraphDescription.cpp
+
+#include "GraphDescription.h"
+#include "../util/StateBlob.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Split a line into whitespace-separated tokens
+     * @details Double quotes group a token containing spaces, and a # outside quotes starts a comment
+     */
+    std::vector<std::string> tokenize(const std::string& line) {
+        std::vector<std::string> tokens;
+        std::string token;
+        bool quoted = false;
+        bool inToken = false;
+        for (char c : line) {
+            if (c == '"') {
+                quoted = !quoted;
+                inToken = true;
+            } else if (!quoted && c == '#') {
+                break;
+            } else if (!quoted && std::isspace(static_cast<unsigned char>(c))) {
+                if (inToken) {
+                    tokens.push_back(token);
+                    token.clear();
+                    inToken = false;
+                }
+            } else {
+                token += c;
+                inToken = true;
+            }
+        }
+        if (quoted) {
+            throw std::runtime_error("Unterminated quote.");
+        }
+        if (inToken) {
+            tokens.push_back(token);
+        }
+        return tokens;
+    }
+    /**
+     * @brief Parse a number
+     * @return True if the whole token is a number
+     */
+    bool parseNumber(const std::string& token, float& value) {
+        if (token.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        value = std::strtof(token.c_str(), &end);
+        return *end == '\0';
+    }
+    /**
+     * @brief Split a port reference of the form name or name:index
+     */
+    void parsePort(const dibiff::graph::GraphDescription& description, const std::string& token, std::uint32_t& node, std::uint32_t& port) {
+        const auto colon = token.find(':');
+        node = static_cast<std::uint32_t>(description.find(token.substr(0, colon)));
+        port = 0;
+        if (colon != std::string::npos) {
+            float index;
+            if (!parseNumber(token.substr(colon + 1), index) || index < 0 || index != static_cast<std::uint32_t>(index)) {
+                throw std::runtime_error("Invalid port index in '" + token + "'.");
+            }
+            port = static_cast<std::uint32_t>(index);
+        }
+    }
+}
+
+/**
+ * @brief Find a node by name
+ * @param name The name of the node
+ * @return The index of the node
+ */
+std::size_t dibiff::graph::GraphDescription::find(const std::string& name) const {
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].name == name) {
+            return i;
+        }
+    }
+    throw std::runtime_error("Unknown node '" + name + "'.");
+}
+/**
+ * @brief Parse the text format
+ * @param text The description
+ * @return The description
+ */
+dibiff::graph::GraphDescription dibiff::graph::GraphDescription::parse(const std::string& text) {
+    dibiff::graph::GraphDescription description;
+    std::istringstream stream(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line)) {
+        ++lineNumber;
+        try {
+            auto tokens = tokenize(line);
+            if (tokens.empty()) {
+                continue;
+            }
+            const std::string& statement = tokens[0];
+            if (statement == "set") {
+                float value;
+                if (tokens.size() != 3 || !parseNumber(tokens[2], value)) {
+                    throw std::runtime_error("Expected 'set <parameter> <number>'.");
+                }
+                description.defaults[tokens[1]] = value;
+            } else if (statement == "node") {
+                if (tokens.size() < 3) {
+                    throw std::runtime_error("Expected 'node <name> <type> [parameter=value ...]'.");
+                }
+                for (auto& node : description.nodes) {
+                    if (node.name == tokens[1]) {
+                        throw std::runtime_error("Duplicate node '" + tokens[1] + "'.");
+                    }
+                }
+                Node node;
+                node.name = tokens[1];
+                node.type = tokens[2];
+                for (std::size_t i = 3; i < tokens.size(); ++i) {
+                    const auto equals = tokens[i].find('=');
+                    if (equals == std::string::npos || equals == 0) {
+                        throw std::runtime_error("Expected parameter=value, got '" + tokens[i] + "'.");
+                    }
+                    const std::string key = tokens[i].substr(0, equals);
+                    const std::string value = tokens[i].substr(equals + 1);
+                    float number;
+                    if (parseNumber(value, number)) {
+                        node.values[key] = number;
+                    } else {
+                        node.strings[key] = value;
+                    }
+                }
+                description.nodes.push_back(std::move(node));
+            } else if (statement == "connect") {
+                if (tokens.size() != 3) {
+                    throw std::runtime_error("Expected 'connect <node>[:output] <node>[:input]'.");
+                }
+                Connection connection;
+                parsePort(description, tokens[1], connection.from, connection.output);
+                parsePort(description, tokens[2], connection.to, connection.input);
+                description.connections.push_back(connection);
+            } else {
+                throw std::runtime_error("Unknown statement '" + statement + "'.");
+            }
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Graph description line " + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    return description;
+}
+/**
+ * @brief Encode the description in the binary format
+ * @details Uses the versioned blob layout of the state snapshots. Type names and
+ * parameter names are stored once in a symbol table and referred to by index.
+ * @return The binary description
+ */
+std::vector<unsigned char> dibiff::graph::GraphDescription::serialize() const {
+    std::vector<std::string> symbols;
+    std::map<std::string, std::uint16_t> indices;
+    auto symbol = [&](const std::string& name) {
+        auto it = indices.find(name);
+        if (it != indices.end()) {
+            return it->second;
+        }
+        if (symbols.size() > UINT16_MAX) {
+            throw std::runtime_error("Too many distinct names in the graph description.");
+        }
+        symbols.push_back(name);
+        return indices[name] = static_cast<std::uint16_t>(symbols.size() - 1);
+    };
+    for (auto& [key, value] : defaults) {
+        symbol(key);
+    }
+    for (auto& node : nodes) {
+        symbol(node.type);
+        for (auto& [key, value] : node.values) {
+            symbol(key);
+        }
+        for (auto& [key, value] : node.strings) {
+            symbol(key);
+        }
+    }
+    dibiff::util::StateWriter writer("GraphDescription", 1);
+    writer.write(static_cast<std::uint32_t>(symbols.size()));
+    for (auto& name : symbols) {
+        writer.writeString(name);
+    }
+    writer.write(static_cast<std::uint32_t>(defaults.size()));
+    for (auto& [key, value] : defaults) {
+        writer.write(symbol(key));
+        writer.write(value);
+    }
+    writer.write(static_cast<std::uint32_t>(nodes.size()));
+    for (auto& node : nodes) {
+        writer.write(symbol(node.type));
+        writer.writeString(node.name);
+        writer.write(static_cast<std::uint16_t>(node.values.size()));
+        for (auto& [key, value] : node.values) {
+            writer.write(symbol(key));
+            writer.write(value);
+        }
+        writer.write(static_cast<std::uint16_t>(node.strings.size()));
+        for (auto& [key, value] : node.strings) {
+            writer.write(symbol(key));
+            writer.writeString(value);
+        }
+    }
+    writer.write(static_cast<std::uint32_t>(connections.size()));
+    writer.writeVector(connections);
+    return writer.finish();
+}
+/**
+ * @brief Decode the binary format
+ * @param data The binary description
+ * @return The description
+ */
+dibiff::graph::GraphDescription dibiff::graph::GraphDescription::deserialize(const std::vector<unsigned char>& data) {
+    dibiff::util::StateReader reader(data, "GraphDescription", 1);
+    dibiff::graph::GraphDescription description;
+    /// Bound corrupt counts by the size of the data before allocating for them
+    auto readCount = [&]() {
+        const std::uint32_t count = reader.read<std::uint32_t>();
+        if (count > data.size()) {
+            throw std::runtime_error("State blob is truncated.");
+        }
+        return count;
+    };
+    std::vector<std::string> symbols(readCount());
+    for (auto& name : symbols) {
+        name = reader.readString();
+    }
+    auto symbol = [&]() -> const std::string& {
+        const std::uint16_t index = reader.read<std::uint16_t>();
+        if (index >= symbols.size()) {
+            throw std::runtime_error("Graph description refers to an unknown name.");
+        }
+        return symbols[index];
+    };
+    const std::uint32_t defaultCount = readCount();
+    for (std::uint32_t i = 0; i < defaultCount; ++i) {
+        const std::string& key = symbol();
+        description.defaults[key] = reader.read<float>();
+    }
+    const std::uint32_t nodeCount = readCount();
+    description.nodes.resize(nodeCount);
+    for (auto& node : description.nodes) {
+        node.type = symbol();
+        node.name = reader.readString();
+        const std::uint16_t valueCount = reader.read<std::uint16_t>();
+        for (std::uint16_t i = 0; i < valueCount; ++i) {
+            const std::string& key = symbol();
+            node.values[key] = reader.read<float>();
+        }
+        const std::uint16_t stringCount = reader.read<std::uint16_t>();
+        for (std::uint16_t i = 0; i < stringCount; ++i) {
+            const std::string& key = symbol();
+            node.strings[key] = reader.readString();
+        }
+    }
+    const std::uint32_t connectionCount = readCount();
+    description.connections.resize(connectionCount);
+    reader.readVector(description.connections);
+    for (auto& c : description.connections) {
+        if (c.from >= nodeCount || c.to >= nodeCount) {
+            throw std::runtime_error("Connection refers to an unknown node.");
+        }
+    }
+    return description;
+}
+/**
+ * @brief Load a description from a file
+ * @param filename The path of the file
+ * @return The description
+ */
+dibiff::graph::GraphDescription dibiff::graph::GraphDescription::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Error opening the graph description.");
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::uint32_t magic = 0;
+    if (data.size() >= sizeof(magic)) {
+        std::memcpy(&magic, data.data(), sizeof(magic));
+    }
+    if (magic == dibiff::util::StateWriter::magic) {
+        return deserialize(data);
+    }
+    return parse(std::string(data.begin(), data.end()));
+}
+/**
+ * @brief Save the description to a file in the binary format
+ * @param filename The path of the file
+ */
+void dibiff::graph::GraphDescription::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Error opening the graph description.");
+    }
+    const auto data = serialize();
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
@@ -0,0 +1,86 @@
+/// GraphDescription.h
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dibiff {
+    namespace graph {
+        class GraphDescription;
+    }
+}
+
+/**
+ * @brief Graph Description
+ * @details A declarative description of an audio graph: its nodes by type and name,
+ * their parameters and the connections between their ports. Descriptions are read
+ * from a line-based text format or a compact binary format, and are built into a
+ * graph by a GraphLoader. The text format has one statement per line:
+ *
+ *     # A comment
+ *     set sampleRate 48000
+ *     node osc SineGenerator blockSize=512 frequency=440
+ *     node out WavWriter filename="out.wav"
+ *     connect osc:0 out:0
+ *
+ * `set` gives a default for a parameter of every node, `node` declares a node with a
+ * unique name, and `connect` joins an output of one node to an input of another,
+ * by port index, defaulting to port 0.
+ */
+class dibiff::graph::GraphDescription {
+    public:
+        struct Node {
+            std::string type;
+            std::string name;
+            std::map<std::string, float> values;
+            std::map<std::string, std::string> strings;
+        };
+        struct Connection {
+            std::uint32_t from;
+            std::uint32_t output;
+            std::uint32_t to;
+            std::uint32_t input;
+        };
+        /// Parameters shared by every node unless a node sets them itself
+        std::map<std::string, float> defaults;
+        std::vector<Node> nodes;
+        std::vector<Connection> connections;
+        /**
+         * @brief Find a node by name
+         * @param name The name of the node
+         * @return The index of the node
+         */
+        std::size_t find(const std::string& name) const;
+        /**
+         * @brief Parse the text format
+         * @param text The description
+         * @return The description
+         */
+        static GraphDescription parse(const std::string& text);
+        /**
+         * @brief Encode the description in the binary format
+         * @return The binary description
+         */
+        std::vector<unsigned char> serialize() const;
+        /**
+         * @brief Decode the binary format
+         * @param data The binary description
+         * @return The description
+         */
+        static GraphDescription deserialize(const std::vector<unsigned char>& data);
+        /**
+         * @brief Load a description from a file
+         * @details Reads the binary format if the file starts with its header, and the text format otherwise
+         * @param filename The path of the file
+         * @return The description
+         */
+        static GraphDescription load(const std::string& filename);
+        /**
+         * @brief Save the description to a file in the binary format
+         * @param filename The path of the file
+         */
+        void save(const std::string& filename) const;
+};
@@ -0,0 +1,81 @@
+/// HealthMonitor.cpp
+
+#include "HealthMonitor.h"
+#include "../util/EventLog.h"
+#include "../util/SignalHealth.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constructor
+ * @param port The output to monitor
+ * @param options The thresholds and action
+ */
+dibiff::graph::HealthMonitor::HealthMonitor(dibiff::graph::AudioOutput* port, const dibiff::graph::HealthOptions& options)
+: port(port), options(options) {}
+/**
+ * @brief Check the current block of the output
+ * @details Analyzes the whole block at once, then applies the action if the block is
+ * unhealthy. Outputs aliased by a bypass are not checked.
+ * @return True if the block is healthy
+ */
+bool dibiff::graph::HealthMonitor::check() {
+    if (port->alias != nullptr || port->data.empty()) {
+        return true;
+    }
+    const dibiff::util::SignalHealth::Report report = dibiff::util::SignalHealth::analyze(port->data.data(), port->data.size());
+    const bool finite = report.nonFinite == 0;
+    const bool peakOk = report.peak <= options.peak;
+    const bool dcOk = std::abs(report.dc) <= options.dc;
+    blocks.fetch_add(1, std::memory_order_relaxed);
+    if (!finite) {
+        nonFinite.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (report.denormals > 0) {
+        denormals.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!peakOk) {
+        overPeak.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!dcOk) {
+        overDc.fetch_add(1, std::memory_order_relaxed);
+    }
+    const bool ok = finite && peakOk && dcOk;
+    using Action = dibiff::graph::HealthOptions::Action;
+    if (options.action == Action::Sanitize && (!finite || report.denormals > 0)) {
+        dibiff::util::SignalHealth::sanitize(port->data.data(), port->data.size());
+    }
+    if (!ok) {
+        if (options.action == Action::Reset) {
+            port->parent->reset();
+        }
+        if (options.action == Action::Mute || options.action == Action::Reset) {
+            std::fill(port->data.begin(), port->data.end(), 0.0f);
+        }
+    }
+    /// Log changes of state rather than every block, so a stuck node cannot flood the log
+    if (healthy.exchange(ok, std::memory_order_relaxed) != ok) {
+        const std::string& source = port->parent->name;
+        if (ok) {
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Info, source.c_str(), "Output recovered");
+        } else {
+            const char* message = !finite ? "Non-finite samples" : !peakOk ? "Peak above threshold" : "DC offset above threshold";
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Warning, source.c_str(), message, {static_cast<double>(report.nonFinite), report.peak, report.dc});
+        }
+    }
+    return ok;
+}
+/**
+ * @brief Get the counters
+ * @return The number of blocks checked and of each kind of problem
+ */
+dibiff::graph::HealthMonitor::Counters dibiff::graph::HealthMonitor::getCounters() const {
+    return Counters{
+        blocks.load(std::memory_order_relaxed),
+        nonFinite.load(std::memory_order_relaxed),
+        denormals.load(std::memory_order_relaxed),
+        overPeak.load(std::memory_order_relaxed),
+        overDc.load(std::memory_order_relaxed)
+    };
+}
@@ -0,0 +1,86 @@
+/// HealthMonitor.h
+
+#pragma once
+
+#include "graph.h"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
+/**
+ * @brief Health Options
+ * @details What a health monitor treats as unhealthy and what it does about it
+ */
+struct dibiff::graph::HealthOptions {
+    enum class Action {
+        /// Count and log only
+        Report,
+        /// Replace non-finite samples and denormals with zero
+        Sanitize,
+        /// Zero the block
+        Mute,
+        /// Reset the node and zero the block
+        Reset
+    };
+    /// The largest healthy magnitude
+    float peak = std::numeric_limits<float>::infinity();
+    /// The largest healthy magnitude of the block mean
+    float dc = std::numeric_limits<float>::infinity();
+    /// The action taken on an unhealthy block
+    Action action = Action::Report;
+};
+
+/**
+ * @brief Health Monitor
+ * @details Checks an output once per block, after its node has processed, for
+ * non-finite samples, denormals, a peak above a threshold and a DC offset. Unhealthy
+ * blocks are counted and acted on, and changes between healthy and unhealthy are
+ * logged to the global event log, so a blown-up filter is caught at the port instead
+ * of spreading through mixers into every sink. Denormals are counted but only
+ * flushed by the sanitize action; they do not make a block unhealthy.
+ */
+class dibiff::graph::HealthMonitor {
+    public:
+        struct Counters {
+            std::size_t blocks;
+            /// Blocks with NaN or infinite samples
+            std::size_t nonFinite;
+            /// Blocks with denormal samples
+            std::size_t denormals;
+            /// Blocks with a peak above the threshold
+            std::size_t peak;
+            /// Blocks with a DC offset above the threshold
+            std::size_t dc;
+        };
+        /**
+         * @brief Constructor
+         * @param port The output to monitor
+         * @param options The thresholds and action
+         */
+        HealthMonitor(dibiff::graph::AudioOutput* port, const dibiff::graph::HealthOptions& options);
+        /**
+         * @brief Check the current block of the output
+         * @details Called by the graph after the node has processed
+         * @return True if the block is healthy
+         */
+        bool check();
+        /**
+         * @brief Get the counters
+         * @details Safe to call from any thread
+         * @return The number of blocks checked and of each kind of problem
+         */
+        Counters getCounters() const;
+        bool isHealthy() const { return healthy.load(std::memory_order_relaxed); }
+        dibiff::graph::AudioOutput* getPort() const { return port; }
+        const dibiff::graph::HealthOptions& getOptions() const { return options; }
+    private:
+        dibiff::graph::AudioOutput* port;
+        dibiff::graph::HealthOptions options;
+        std::atomic<bool> healthy{true};
+        std::atomic<std::size_t> blocks{0};
+        std::atomic<std::size_t> nonFinite{0};
+        std::atomic<std::size_t> denormals{0};
+        std::atomic<std::size_t> overPeak{0};
+        std::atomic<std::size_t> overDc{0};
+};
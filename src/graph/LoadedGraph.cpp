@@ -0,0 +1,124 @@
+/// LoadedGraph.cpp
+
+#include "LoadedGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Get a node by name
+ * @param name The name of the node in the description
+ * @return The node
+ */
+dibiff::graph::AudioObject* dibiff::graph::LoadedGraph::getNode(const std::string& name) const {
+    return objects[find(name)];
+}
+/**
+ * @brief Get the parameters of a node
+ * @param name The name of the node in the description
+ * @return The parameters
+ */
+dibiff::graph::NodeParameters& dibiff::graph::LoadedGraph::getParameters(const std::string& name) {
+    return *parameters[find(name)];
+}
+std::size_t dibiff::graph::LoadedGraph::find(const std::string& name) const {
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) {
+        throw std::runtime_error("Unknown node '" + name + "'.");
+    }
+    return it - names.begin();
+}
+/**
+ * @brief Load a graph
+ * @param description The description of the graph
+ * @param registry The node types the description may use
+ * @param threads The number of initialization threads, or 0 for one per hardware thread
+ * @return The loaded graph
+ */
+std::unique_ptr<dibiff::graph::LoadedGraph> dibiff::graph::LoadedGraph::load(const dibiff::graph::GraphDescription& description, const dibiff::graph::NodeRegistry& registry, int threads) {
+    std::unique_ptr<LoadedGraph> instance(new LoadedGraph());
+    const std::size_t count = description.nodes.size();
+    /// Resolve every type before allocating anything
+    std::vector<const dibiff::graph::NodeRegistry::Entry*> entries;
+    entries.reserve(count);
+    std::size_t bytes = 0;
+    for (auto& node : description.nodes) {
+        entries.push_back(&registry.get(node.type));
+        bytes += entries.back()->size + entries.back()->alignment;
+    }
+    /// Construct the nodes contiguously
+    instance->graph.reserve(bytes, count);
+    instance->names.reserve(count);
+    instance->parameters.reserve(count);
+    instance->objects.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& node = description.nodes[i];
+        instance->names.push_back(node.name);
+        instance->parameters.push_back(std::make_unique<dibiff::graph::NodeParameters>(node, description.defaults));
+        auto& p = *instance->parameters.back();
+        auto handle = instance->graph.place(entries[i]->size, entries[i]->alignment, [&](void* at) {
+            return entries[i]->construct(at, p);
+        });
+        instance->objects.push_back(handle.get());
+    }
+    /// Initialize the nodes concurrently
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    threads = static_cast<int>(std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                instance->objects[i]->initialize();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto& t : pool) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        instance->objects[i]->setName(instance->names[i]);
+    }
+    /// Connect the ports
+    for (auto& c : description.connections) {
+        auto* from = instance->objects[c.from];
+        auto* to = instance->objects[c.to];
+        if (c.output >= from->_outputs.size()) {
+            throw std::runtime_error("Node '" + instance->names[c.from] + "' has no output " + std::to_string(c.output) + ".");
+        }
+        if (c.input >= to->_inputs.size()) {
+            throw std::runtime_error("Node '" + instance->names[c.to] + "' has no input " + std::to_string(c.input) + ".");
+        }
+        dibiff::graph::AudioGraph::connect(from->getOutput(c.output), to->getInput(c.input));
+    }
+    return instance;
+}
+/**
+ * @brief Load a graph from a file
+ * @param filename The path of a text or binary description
+ * @param registry The node types the description may use
+ * @param threads The number of initialization threads, or 0 for one per hardware thread
+ * @return The loaded graph
+ */
+std::unique_ptr<dibiff::graph::LoadedGraph> dibiff::graph::LoadedGraph::load(const std::string& filename, const dibiff::graph::NodeRegistry& registry, int threads) {
+    return load(dibiff::graph::GraphDescription::load(filename), registry, threads);
+}
@@ -0,0 +1,82 @@
+/// LoadedGraph.h
+
+#pragma once
+
+#include "graph.h"
+#include "GraphDescription.h"
+#include "NodeRegistry.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dibiff {
+    namespace graph {
+        class LoadedGraph;
+    }
+}
+
+/**
+ * @brief Loaded Graph
+ * @details An audio graph built from a graph description, together with the parameter
+ * storage its nodes refer to. Loading resolves every node type first, reserves the
+ * memory of all nodes in one arena chunk and constructs them in place, then runs the
+ * nodes' initializations, which allocate buffers and load files, concurrently on a pool
+ * of threads before connecting the ports.
+ */
+class dibiff::graph::LoadedGraph {
+    public:
+        LoadedGraph(const LoadedGraph&) = delete;
+        LoadedGraph& operator=(const LoadedGraph&) = delete;
+        /**
+         * @brief Get the graph
+         * @return The graph
+         */
+        dibiff::graph::AudioGraph& getGraph() { return graph; }
+        /**
+         * @brief Get a node by name
+         * @param name The name of the node in the description
+         * @return The node
+         */
+        dibiff::graph::AudioObject* getNode(const std::string& name) const;
+        /**
+         * @brief Get a node by name
+         * @param name The name of the node in the description
+         * @return The node, or nullptr if it is not a T
+         */
+        template<typename T>
+        T* getNode(const std::string& name) const {
+            return dynamic_cast<T*>(getNode(name));
+        }
+        /**
+         * @brief Get the parameters of a node
+         * @details Nodes holding their parameters by reference follow changes made here
+         * @param name The name of the node in the description
+         * @return The parameters
+         */
+        dibiff::graph::NodeParameters& getParameters(const std::string& name);
+        /**
+         * @brief Load a graph
+         * @param description The description of the graph
+         * @param registry The node types the description may use
+         * @param threads The number of initialization threads, or 0 for one per hardware thread
+         * @return The loaded graph
+         */
+        static std::unique_ptr<LoadedGraph> load(const dibiff::graph::GraphDescription& description, const dibiff::graph::NodeRegistry& registry = dibiff::graph::NodeRegistry::defaults(), int threads = 0);
+        /**
+         * @brief Load a graph from a file
+         * @param filename The path of a text or binary description
+         * @param registry The node types the description may use
+         * @param threads The number of initialization threads, or 0 for one per hardware thread
+         * @return The loaded graph
+         */
+        static std::unique_ptr<LoadedGraph> load(const std::string& filename, const dibiff::graph::NodeRegistry& registry = dibiff::graph::NodeRegistry::defaults(), int threads = 0);
+    private:
+        LoadedGraph() {}
+        std::vector<std::string> names;
+        /// Declared before the graph, so the nodes are destroyed before the values they refer to
+        std::vector<std::unique_ptr<dibiff::graph::NodeParameters>> parameters;
+        std::vector<dibiff::graph::AudioObject*> objects;
+        dibiff::graph::AudioGraph graph;
+        std::size_t find(const std::string& name) const;
+};
@@ -0,0 +1,284 @@
+/// NodeRegistry.cpp
+
+#include "NodeRegistry.h"
+
+#include "../adaptive/AcousticEchoCanceller.h"
+#include "../dynamic/Compressor.h"
+#include "../dynamic/Envelope.h"
+#include "../dynamic/Expander.h"
+#include "../dynamic/Limiter.h"
+#include "../effect/Chorus.h"
+#include "../effect/Flanger.h"
+#include "../effect/Phaser.h"
+#include "../effect/PitchShifter.h"
+#include "../effect/Reverb.h"
+#include "../effect/Tremolo.h"
+#include "../effect/Vibrato.h"
+#include "../filter/AdaptiveFilter.h"
+#include "../filter/AllPassFilter.h"
+#include "../filter/BandPassFilter.h"
+#include "../filter/FIRFilter.h"
+#include "../filter/HighPassFilter.h"
+#include "../filter/HighShelfFilter.h"
+#include "../filter/LowPassFilter.h"
+#include "../filter/LowShelfFilter.h"
+#include "../filter/NotchFilter.h"
+#include "../filter/PeakingEQFilter.h"
+#include "../gate/Ducker.h"
+#include "../gate/ExpanderGate.h"
+#include "../gate/LookaheadGate.h"
+#include "../gate/NoiseGate.h"
+#include "../generator/SampleGenerator.h"
+#include "../generator/SineGenerator.h"
+#include "../generator/SquareGenerator.h"
+#include "../generator/TriangleGenerator.h"
+#include "../generator/VariableGenerator.h"
+#include "../generator/WhiteNoiseGenerator.h"
+#include "../level/AutomaticGainControl.h"
+#include "../level/Gain.h"
+#include "../level/Meter.h"
+#include "../level/Mixer.h"
+#include "../level/SpectrumAnalyzer.h"
+#include "../midi/MidiFilePlayer.h"
+#include "../midi/MidiInput.h"
+#include "../midi/VoiceSelector.h"
+#include "../sink/BufferSink.h"
+#include "../sink/GraphSink.h"
+#include "../sink/WavWriter.h"
+#include "../source/GraphSource.h"
+#include "../time/Delay.h"
+
+#include <cmath>
+
+/**
+ * @brief Constructor
+ * @param node The node of the description
+ * @param defaults The parameters shared by every node
+ */
+dibiff::graph::NodeParameters::NodeParameters(const dibiff::graph::GraphDescription::Node& node, const std::map<std::string, float>& defaults)
+: values(defaults), strings(node.strings) {
+    for (auto& [key, value] : node.values) {
+        values[key] = value;
+    }
+}
+/**
+ * @brief Get a numeric parameter
+ * @param key The name of the parameter
+ * @param fallback The value if neither the node nor the defaults set it
+ * @return A reference to the stored value
+ */
+float& dibiff::graph::NodeParameters::number(const std::string& key, float fallback) {
+    return values.emplace(key, fallback).first->second;
+}
+/**
+ * @brief Get an integer parameter
+ * @param key The name of the parameter
+ * @param fallback The value if neither the node nor the defaults set it
+ * @return A reference to the stored value
+ */
+int& dibiff::graph::NodeParameters::integer(const std::string& key, int fallback) {
+    auto it = integers.find(key);
+    if (it == integers.end()) {
+        auto v = values.find(key);
+        it = integers.emplace(key, v != values.end() ? static_cast<int>(std::lround(v->second)) : fallback).first;
+    }
+    return it->second;
+}
+/**
+ * @brief Get an optional numeric parameter
+ * @param key The name of the parameter
+ * @return A reference to the stored value, or nothing if neither the node nor the defaults set it
+ */
+std::optional<std::reference_wrapper<float>> dibiff::graph::NodeParameters::optional(const std::string& key) {
+    auto it = values.find(key);
+    if (it == values.end()) {
+        return std::nullopt;
+    }
+    return std::ref(it->second);
+}
+/**
+ * @brief Get a string parameter
+ * @param key The name of the parameter
+ * @return The value
+ */
+std::string dibiff::graph::NodeParameters::text(const std::string& key) const {
+    auto it = strings.find(key);
+    if (it == strings.end()) {
+        throw std::runtime_error("Missing parameter '" + key + "'.");
+    }
+    return it->second;
+}
+/**
+ * @brief Get the entry of a type
+ * @param type The type name
+ * @return The entry
+ */
+const dibiff::graph::NodeRegistry::Entry& dibiff::graph::NodeRegistry::get(const std::string& type) const {
+    auto it = entries.find(type);
+    if (it == entries.end()) {
+        throw std::runtime_error("Unknown node type '" + type + "'.");
+    }
+    return it->second;
+}
+/**
+ * @brief Get the registry of the built-in nodes
+ * @details Parameters take the names of the constructor arguments, and every node
+ * reads sampleRate and blockSize, so they are usually given once with `set`
+ * @return The registry
+ */
+const dibiff::graph::NodeRegistry& dibiff::graph::NodeRegistry::defaults() {
+    static const NodeRegistry registry = [] {
+        using P = dibiff::graph::NodeParameters;
+        NodeRegistry r;
+        /// Adaptive
+        r.add<dibiff::adaptive::AcousticEchoCanceller>("AcousticEchoCanceller", [](void* at, P& p) {
+            return new (at) dibiff::adaptive::AcousticEchoCanceller(p.integer("filterLength", 256), p.number("stepSize", 0.01f));
+        });
+        /// Dynamics
+        r.add<dibiff::dynamic::Compressor>("Compressor", [](void* at, P& p) {
+            return new (at) dibiff::dynamic::Compressor(p.number("threshold", -20.0f), p.number("sampleRate", 48000.0f), p.number("attack", 0.01f), p.number("release", 0.1f), p.number("ratio", 2.0f), p.optional("makeupGain"), p.optional("kneeWidth"));
+        });
+        r.add<dibiff::dynamic::Envelope>("Envelope", [](void* at, P& p) {
+            return new (at) dibiff::dynamic::Envelope(p.number("attackTime", 0.01f), p.number("decayTime", 0.1f), p.number("sustainLevel", 0.7f), p.number("releaseTime", 0.2f), p.number("sampleRate", 48000.0f));
+        });
+        r.add<dibiff::dynamic::Expander>("Expander", [](void* at, P& p) {
+            return new (at) dibiff::dynamic::Expander(p.number("threshold", -40.0f), p.number("sampleRate", 48000.0f), p.number("attack", 0.01f), p.number("release", 0.1f), p.number("ratio", 2.0f), p.optional("kneeWidth"));
+        });
+        r.add<dibiff::dynamic::Limiter>("Limiter", [](void* at, P& p) {
+            return new (at) dibiff::dynamic::Limiter(p.number("threshold", -1.0f), p.number("sampleRate", 48000.0f), p.number("attack", 0.001f), p.number("release", 0.1f), p.optional("makeupGain"), p.optional("kneeWidth"));
+        });
+        /// Effects
+        r.add<dibiff::effect::Chorus>("Chorus", [](void* at, P& p) {
+            return new (at) dibiff::effect::Chorus(p.number("modulationDepth", 5.0f), p.number("modulationRate", 0.5f), p.number("sampleRate", 48000.0f), p.number("wetLevel", 0.5f));
+        });
+        r.add<dibiff::effect::Flanger>("Flanger", [](void* at, P& p) {
+            return new (at) dibiff::effect::Flanger(p.number("modulationDepth", 2.0f), p.number("modulationRate", 0.25f), p.number("sampleRate", 48000.0f), p.number("feedback", 0.5f), p.number("wetLevel", 0.5f));
+        });
+        r.add<dibiff::effect::Phaser>("Phaser", [](void* at, P& p) {
+            return new (at) dibiff::effect::Phaser(p.number("modulationDepth", 500.0f), p.number("modulationRate", 0.5f), p.number("sampleRate", 48000.0f), p.number("baseCutoff", 1000.0f), p.number("mix", 0.5f), p.integer("numStages", 4));
+        });
+        r.add<dibiff::effect::PitchShifter>("PitchShifter", [](void* at, P& p) {
+            return new (at) dibiff::effect::PitchShifter(p.number("semitones", 0.0f), p.integer("fftSize", 2048), p.integer("hop", 512));
+        });
+        r.add<dibiff::effect::Reverb>("Reverb", [](void* at, P& p) {
+            return new (at) dibiff::effect::Reverb(p.number("decayTime", 1.0f), p.number("roomSize", 10.0f), p.number("sampleRate", 48000.0f), p.integer("numDelays", 8), p.number("wetLevel", 0.3f));
+        });
+        r.add<dibiff::effect::Tremolo>("Tremolo", [](void* at, P& p) {
+            return new (at) dibiff::effect::Tremolo(p.number("modulationDepth", 0.5f), p.number("modulationRate", 5.0f), p.number("sampleRate", 48000.0f));
+        });
+        r.add<dibiff::effect::Vibrato>("Vibrato", [](void* at, P& p) {
+            return new (at) dibiff::effect::Vibrato(p.number("modulationDepth", 2.0f), p.number("modulationRate", 5.0f), p.number("sampleRate", 48000.0f));
+        });
+        /// Filters
+        r.add<dibiff::filter::AdaptiveFilter>("AdaptiveFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::AdaptiveFilter(p.integer("filterLength", 256), p.number("stepSize", 0.01f));
+        });
+        r.add<dibiff::filter::AllPassFilter>("AllPassFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::AllPassFilter(p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::BandPassFilterConstantSkirtGain>("BandPassFilterConstantSkirtGain", [](void* at, P& p) {
+            return new (at) dibiff::filter::BandPassFilterConstantSkirtGain(p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::BandPassFilterConstantPeakGain>("BandPassFilterConstantPeakGain", [](void* at, P& p) {
+            return new (at) dibiff::filter::BandPassFilterConstantPeakGain(p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::FIRFilter>("FIRFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::FIRFilter(dibiff::filter::FIRFilter::lowPass(p.integer("taps", 63), p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f)));
+        });
+        r.add<dibiff::filter::HighPassFilter>("HighPassFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::HighPassFilter(p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::HighShelfFilter>("HighShelfFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::HighShelfFilter(p.number("gain", 0.0f), p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::LowPassFilter>("LowPassFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::LowPassFilter(p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::LowShelfFilter>("LowShelfFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::LowShelfFilter(p.number("gain", 0.0f), p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::NotchFilter>("NotchFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::NotchFilter(p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        r.add<dibiff::filter::PeakingEQFilter>("PeakingEQFilter", [](void* at, P& p) {
+            return new (at) dibiff::filter::PeakingEQFilter(p.number("gain", 0.0f), p.number("cutoff", 1000.0f), p.number("sampleRate", 48000.0f), p.number("qFactor", 0.707f));
+        });
+        /// Gates
+        r.add<dibiff::gate::Ducker>("Ducker", [](void* at, P& p) {
+            return new (at) dibiff::gate::Ducker(p.number("threshold", -30.0f), p.number("ratio", 4.0f), p.number("attackTime", 10.0f), p.number("releaseTime", 100.0f), p.number("sampleRate", 48000.0f));
+        });
+        r.add<dibiff::gate::ExpanderGate>("ExpanderGate", [](void* at, P& p) {
+            return new (at) dibiff::gate::ExpanderGate(p.number("threshold", -40.0f), p.number("ratio", 2.0f), p.number("attackTime", 10.0f), p.number("releaseTime", 100.0f), p.number("sampleRate", 48000.0f));
+        });
+        r.add<dibiff::gate::LookaheadGate>("LookaheadGate", [](void* at, P& p) {
+            return new (at) dibiff::gate::LookaheadGate(p.number("threshold", -40.0f), p.number("attackTime", 10.0f), p.number("releaseTime", 100.0f), p.number("lookaheadTime", 5.0f), p.number("sampleRate", 48000.0f));
+        });
+        r.add<dibiff::gate::NoiseGate>("NoiseGate", [](void* at, P& p) {
+            return new (at) dibiff::gate::NoiseGate(p.number("threshold", -40.0f), p.number("attackTime", 10.0f), p.number("releaseTime", 100.0f), p.number("sampleRate", 48000.0f));
+        });
+        /// Generators
+        r.add<dibiff::generator::SampleGenerator>("SampleGenerator", [](void* at, P& p) {
+            return new (at) dibiff::generator::SampleGenerator(p.text("filename"), p.integer("blockSize", 512), p.integer("sampleRate", 48000));
+        });
+        r.add<dibiff::generator::SineGenerator>("SineGenerator", [](void* at, P& p) {
+            return new (at) dibiff::generator::SineGenerator(p.integer("blockSize", 512), p.integer("sampleRate", 48000), p.number("frequency", 1000.0f), p.integer("totalSamples", -1));
+        });
+        r.add<dibiff::generator::SquareGenerator>("SquareGenerator", [](void* at, P& p) {
+            return new (at) dibiff::generator::SquareGenerator(p.integer("blockSize", 512), p.integer("sampleRate", 48000), p.number("dutyCycle", 0.5f), p.number("frequency", 1000.0f), p.integer("totalSamples", -1));
+        });
+        r.add<dibiff::generator::TriangleGenerator>("TriangleGenerator", [](void* at, P& p) {
+            return new (at) dibiff::generator::TriangleGenerator(p.integer("blockSize", 512), p.integer("sampleRate", 48000), p.number("frequency", 1000.0f), p.integer("totalSamples", -1));
+        });
+        r.add<dibiff::generator::VariableGenerator>("VariableGenerator", [](void* at, P& p) {
+            return new (at) dibiff::generator::VariableGenerator(p.integer("blockSize", 512), p.integer("sampleRate", 48000), p.number("state", 0.0f), p.number("dutyCycle", 0.5f), p.number("frequency", 1000.0f), p.integer("totalSamples", -1));
+        });
+        r.add<dibiff::generator::WhiteNoiseGenerator>("WhiteNoiseGenerator", [](void* at, P& p) {
+            return new (at) dibiff::generator::WhiteNoiseGenerator(p.integer("blockSize", 512), p.integer("sampleRate", 48000), p.integer("totalSamples", -1));
+        });
+        /// Level
+        r.add<dibiff::level::AutomaticGainControl>("AutomaticGainControl", [](void* at, P& p) {
+            return new (at) dibiff::level::AutomaticGainControl(p.number("targetLevel", -20.0f), p.number("sampleRate", 48000.0f), p.number("attack", 0.01f), p.number("release", 0.1f), p.number("rmsCoefficient", 0.999f));
+        });
+        r.add<dibiff::level::Gain>("Gain", [](void* at, P& p) {
+            return new (at) dibiff::level::Gain(p.number("value", 1.0f));
+        });
+        r.add<dibiff::level::Meter>("Meter", [](void* at, P& p) {
+            return new (at) dibiff::level::Meter(p.number("sampleRate", 48000.0f), p.number("peakDecay", 20.0f));
+        });
+        r.add<dibiff::level::Mixer>("Mixer", [](void* at, P& p) {
+            return new (at) dibiff::level::Mixer(p.integer("numInputs", 1));
+        });
+        r.add<dibiff::level::SpectrumAnalyzer>("SpectrumAnalyzer", [](void* at, P& p) {
+            return new (at) dibiff::level::SpectrumAnalyzer(p.number("sampleRate", 48000.0f), p.integer("fftSize", 2048), p.integer("interval", 4), p.number("smoothing", 0.1f));
+        });
+        /// MIDI
+        r.add<dibiff::midi::MidiFilePlayer>("MidiFilePlayer", [](void* at, P& p) {
+            return new (at) dibiff::midi::MidiFilePlayer(p.text("filename"), p.integer("blockSize", 512), p.number("sampleRate", 48000.0f), p.integer("loop", 0) != 0);
+        });
+        r.add<dibiff::midi::MidiInput>("MidiInput", [](void* at, P& p) {
+            return new (at) dibiff::midi::MidiInput(p.integer("blockSize", 512));
+        });
+        r.add<dibiff::midi::VoiceSelector>("VoiceSelector", [](void* at, P& p) {
+            return new (at) dibiff::midi::VoiceSelector(p.integer("blockSize", 512), p.integer("numVoices", 3));
+        });
+        /// Sinks and sources
+        r.add<dibiff::sink::BufferSink>("BufferSink", [](void* at, P& p) {
+            return new (at) dibiff::sink::BufferSink(p.integer("channels", 1));
+        });
+        r.add<dibiff::sink::GraphSink>("GraphSink", [](void* at, P& p) {
+            return new (at) dibiff::sink::GraphSink(p.integer("channels", 1), p.integer("sampleRate", 48000), p.integer("blockSize", 512));
+        });
+        r.add<dibiff::sink::WavWriter>("WavWriter", [](void* at, P& p) {
+            return new (at) dibiff::sink::WavWriter(p.text("filename"), p.integer("sampleRate", 48000));
+        });
+        r.add<dibiff::source::GraphSource>("GraphSource", [](void* at, P& p) {
+            return new (at) dibiff::source::GraphSource(p.integer("channels", 1), p.integer("sampleRate", 48000), p.integer("blockSize", 512));
+        });
+        /// Time
+        r.add<dibiff::time::Delay>("Delay", [](void* at, P& p) {
+            return new (at) dibiff::time::Delay(p.number("delayTime", 100.0f), p.number("sampleRate", 48000.0f));
+        });
+        return r;
+    }();
+    return registry;
+}
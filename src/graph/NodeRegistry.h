@@ -0,0 +1,114 @@
+/// NodeRegistry.h
+
+#pragma once
+
+#include "graph.h"
+#include "GraphDescription.h"
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace dibiff {
+    namespace graph {
+        class NodeParameters;
+        class NodeRegistry;
+    }
+}
+
+/**
+ * @brief Node Parameters
+ * @details The parameters of one node of a graph description. Most nodes hold their
+ * parameters by reference, so the values live here for as long as the node does, and
+ * changing them later changes the node. A parameter the node does not set is taken
+ * from the description's defaults, then from the fallback the constructor asks for.
+ */
+class dibiff::graph::NodeParameters {
+    public:
+        /**
+         * @brief Constructor
+         * @param node The node of the description
+         * @param defaults The parameters shared by every node
+         */
+        NodeParameters(const dibiff::graph::GraphDescription::Node& node, const std::map<std::string, float>& defaults);
+        /**
+         * @brief Get a numeric parameter
+         * @param key The name of the parameter
+         * @param fallback The value if neither the node nor the defaults set it
+         * @return A reference to the stored value
+         */
+        float& number(const std::string& key, float fallback);
+        /**
+         * @brief Get an integer parameter
+         * @param key The name of the parameter
+         * @param fallback The value if neither the node nor the defaults set it
+         * @return A reference to the stored value
+         */
+        int& integer(const std::string& key, int fallback);
+        /**
+         * @brief Get an optional numeric parameter
+         * @param key The name of the parameter
+         * @return A reference to the stored value, or nothing if neither the node nor the defaults set it
+         */
+        std::optional<std::reference_wrapper<float>> optional(const std::string& key);
+        /**
+         * @brief Get a string parameter
+         * @param key The name of the parameter
+         * @return The value
+         */
+        std::string text(const std::string& key) const;
+    private:
+        /// Map nodes never move, so references to the values stay valid
+        std::map<std::string, float> values;
+        std::map<std::string, int> integers;
+        std::map<std::string, std::string> strings;
+};
+/**
+ * @brief Node Registry
+ * @details Maps the type names of a graph description to the node classes. Each entry
+ * records the size and alignment of its class, so a loader can reserve the memory of a
+ * whole graph up front, and a constructor that builds the node in place without
+ * initializing it, so the expensive initializations can run together.
+ */
+class dibiff::graph::NodeRegistry {
+    public:
+        /**
+         * @brief Node constructor
+         * @details Constructs the node at the given address from its parameters
+         */
+        using Constructor = std::function<dibiff::graph::AudioObject*(void* at, dibiff::graph::NodeParameters& parameters)>;
+        struct Entry {
+            std::size_t size;
+            std::size_t alignment;
+            Constructor construct;
+        };
+        /**
+         * @brief Register a node class
+         * @param type The type name used in descriptions
+         * @param construct Constructs the node at the given address with placement new
+         */
+        template<typename T>
+        void add(const std::string& type, std::function<T*(void* at, dibiff::graph::NodeParameters& parameters)> construct) {
+            static_assert(std::is_base_of<dibiff::graph::AudioObject, T>::value, "Nodes must derive from AudioObject");
+            entries[type] = Entry{sizeof(T), alignof(T), [construct](void* at, dibiff::graph::NodeParameters& parameters) -> dibiff::graph::AudioObject* {
+                return construct(at, parameters);
+            }};
+        }
+        /**
+         * @brief Get the entry of a type
+         * @param type The type name
+         * @return The entry
+         */
+        const Entry& get(const std::string& type) const;
+        /**
+         * @brief Get the registry of the built-in nodes
+         * @details Registered under their class names, such as "Reverb" and "LowPassFilter".
+         * Nodes that need pointers to external data, such as the buffer source and the
+         * biquad with external coefficients, and composites are left out.
+         * @return The registry
+         */
+        static const NodeRegistry& defaults();
+    private:
+        std::map<std::string, Entry> entries;
+};
@@ -0,0 +1,143 @@
+/// OfflineRenderer.cpp
+
+#include "OfflineRenderer.h"
+#include "../source/BufferSource.h"
+#include "../sink/BufferSink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Constructor
+ * @param builder The graph builder
+ * @param channels The number of channels of the input and output
+ * @param blockSize The block size of the graph
+ * @param threads The number of render threads, or 0 for one per hardware thread
+ * @param crossfade The length of the crossfade between chunks in samples
+ */
+dibiff::graph::OfflineRenderer::OfflineRenderer(Builder builder, int channels, int blockSize, int threads, long crossfade)
+: builder(std::move(builder)), channels(channels), blockSize(blockSize),
+  threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())), crossfade(crossfade) {}
+/**
+ * @brief Get the warm-up length
+ * @details Builds a probe instance of the graph and rounds its state memory up to whole blocks
+ * @return The pre-roll of each chunk in samples, or -1 if the graph must render serially
+ */
+long dibiff::graph::OfflineRenderer::getWarmup() {
+    dibiff::graph::AudioGraph graph;
+    auto source = graph.add(dibiff::source::BufferSource::create(nullptr, channels, 0, blockSize));
+    auto sink = graph.add(dibiff::sink::BufferSink::create(channels));
+    builder(graph, source->output, sink->input);
+    long memory = graph.getStateMemory();
+    if (memory < 0) {
+        return -1;
+    }
+    return (memory + blockSize - 1) / blockSize * blockSize;
+}
+/**
+ * @brief Render a range of the input on a fresh instance of the graph
+ * @param input The planar input
+ * @param frames The number of samples per channel of the input
+ * @param from The first sample to render
+ * @param to The sample to stop before
+ * @return The planar output of the range, `to - from` samples per channel
+ */
+std::vector<float> dibiff::graph::OfflineRenderer::renderRange(const std::vector<float>& input, long frames, long from, long to) {
+    dibiff::graph::AudioGraph graph;
+    auto source = graph.add(dibiff::source::BufferSource::create(input.data(), channels, frames, blockSize, from, to));
+    auto sink = graph.add(dibiff::sink::BufferSink::create(channels));
+    builder(graph, source->output, sink->input);
+    const long length = to - from;
+    const long ticks = (length + blockSize - 1) / blockSize;
+    for (long t = 0; t < ticks; ++t) {
+        graph.tick();
+    }
+    std::vector<float> out(static_cast<std::size_t>(length) * channels, 0.0f);
+    for (int c = 0; c < channels; ++c) {
+        const std::vector<float>& data = sink->getChannelData(c);
+        const long available = std::min(length, static_cast<long>(data.size()));
+        std::copy(data.begin(), data.begin() + available, out.begin() + static_cast<std::size_t>(c) * length);
+    }
+    return out;
+}
+/**
+ * @brief Render a buffer
+ * @details Chunk k covers [start, end) of the timeline. Unless it is the first chunk, it
+ * is rendered from start - crossfade - warmup, and its first `crossfade` samples are
+ * blended into the tail of the previous chunk.
+ * @param input The planar input, `frames` samples per channel
+ * @param frames The number of samples per channel
+ * @return The planar output, `frames` samples per channel
+ */
+std::vector<float> dibiff::graph::OfflineRenderer::render(const std::vector<float>& input, long frames) {
+    if (frames <= 0) {
+        return {};
+    }
+    if (input.size() < static_cast<std::size_t>(frames) * channels) {
+        throw std::runtime_error("Input buffer is smaller than frames * channels.");
+    }
+    const long warmup = getWarmup();
+    /// Only split when every chunk is long enough to amortize its pre-roll
+    long numChunks = 1;
+    if (warmup >= 0 && threads > 1) {
+        const long overhead = warmup + crossfade;
+        numChunks = std::max(1L, std::min(static_cast<long>(threads), frames / std::max(4 * overhead, 4L * blockSize)));
+    }
+    if (numChunks == 1) {
+        return renderRange(input, frames, 0, frames);
+    }
+    long chunkLength = (frames + numChunks - 1) / numChunks;
+    chunkLength = (chunkLength + blockSize - 1) / blockSize * blockSize;
+    numChunks = (frames + chunkLength - 1) / chunkLength;
+    std::vector<long> from(numChunks), start(numChunks), end(numChunks);
+    for (long k = 0; k < numChunks; ++k) {
+        start[k] = k * chunkLength;
+        end[k] = std::min(frames, start[k] + chunkLength);
+        from[k] = k == 0 ? 0 : std::max(0L, start[k] - crossfade - warmup);
+    }
+    /// Render the chunks on a pool of threads
+    std::vector<std::vector<float>> chunks(numChunks);
+    std::atomic<long> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < std::min(static_cast<long>(threads), numChunks); ++t) {
+        workers.emplace_back([&]() {
+            for (long k = next++; k < numChunks; k = next++) {
+                try {
+                    chunks[k] = renderRange(input, frames, from[k], end[k]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    error = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    /// Splice the chunks, crossfading each into the tail of the previous one
+    std::vector<float> out(static_cast<std::size_t>(frames) * channels, 0.0f);
+    for (long k = 0; k < numChunks; ++k) {
+        const long length = end[k] - from[k];
+        const long fade = k == 0 ? 0 : std::min(crossfade, start[k] - from[k]);
+        for (int c = 0; c < channels; ++c) {
+            const float* chunk = chunks[k].data() + static_cast<std::size_t>(c) * length;
+            float* dst = out.data() + static_cast<std::size_t>(c) * frames;
+            const long offset = start[k] - fade - from[k];
+            for (long i = 0; i < fade; ++i) {
+                const float w = (i + 0.5f) / fade;
+                float& y = dst[start[k] - fade + i];
+                y = y * (1.0f - w) + chunk[offset + i] * w;
+            }
+            std::copy(chunk + (start[k] - from[k]), chunk + length, dst + start[k]);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,66 @@
+/// OfflineRenderer.h
+
+#pragma once
+
+#include "graph.h"
+
+#include <functional>
+#include <vector>
+
+namespace dibiff {
+    namespace graph {
+        class OfflineRenderer;
+    }
+}
+
+/**
+ * @brief Offline Renderer
+ * @details Renders a buffer through a processing graph faster than real time by
+ * splitting the timeline into chunks and rendering the chunks concurrently, each on
+ * its own instance of the graph. Every chunk is pre-rolled by the graph's state
+ * memory, so its nodes have settled by the time its output is used, and neighbouring
+ * chunks are spliced with a short linear crossfade. Graphs containing a node with
+ * unbounded state memory, such as an adaptive filter, are rendered serially.
+ */
+class dibiff::graph::OfflineRenderer {
+    public:
+        /**
+         * @brief Graph builder
+         * @details Builds one instance of the graph between the renderer's source output and
+         * sink input. Called once per chunk, possibly from several threads at once, so every
+         * call must create its own nodes.
+         */
+        using Builder = std::function<void(dibiff::graph::AudioGraph& graph, dibiff::graph::AudioOutput* input, dibiff::graph::AudioInput* output)>;
+        /**
+         * @brief Constructor
+         * @param builder The graph builder
+         * @param channels The number of channels of the input and output
+         * @param blockSize The block size of the graph
+         * @param threads The number of render threads, or 0 for one per hardware thread
+         * @param crossfade The length of the crossfade between chunks in samples
+         */
+        OfflineRenderer(Builder builder, int channels, int blockSize, int threads = 0, long crossfade = 256);
+        /**
+         * @brief Render a buffer
+         * @param input The planar input, `frames` samples per channel
+         * @param frames The number of samples per channel
+         * @return The planar output, `frames` samples per channel
+         */
+        std::vector<float> render(const std::vector<float>& input, long frames);
+        /**
+         * @brief Get the warm-up length
+         * @return The pre-roll of each chunk in samples, or -1 if the graph must render serially
+         */
+        long getWarmup();
+    private:
+        Builder builder;
+        int channels;
+        int blockSize;
+        int threads;
+        long crossfade;
+        /**
+         * @brief Render a range of the input on a fresh instance of the graph
+         * @return The planar output of the range
+         */
+        std::vector<float> renderRange(const std::vector<float>& input, long frames, long from, long to);
+};
@@ -0,0 +1,218 @@
+/// Oversampled.cpp
+
+#include "Oversampled.h"
+
+/**
+ * @brief Oversampled Entry
+ * @details Publishes the upsampled input inside the inner graph
+ */
+class dibiff::graph::Oversampled::Entry : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioOutput* output;
+        Entry(int channels) : dibiff::graph::AudioObject(), channels(channels) {
+            name = "OversampledEntry";
+        }
+        void initialize() override {
+            auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "OversampledEntryOutput", channels));
+            _outputs.emplace_back(std::move(o));
+            output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+        }
+        /// The data is published by the owner before the inner graph ticks
+        void process() override { markProcessed(); }
+        void reset() override {}
+        void clear() override {}
+        bool isFinished() const override { return false; }
+        bool isReadyToProcess() const override { return !processed; }
+    private:
+        int channels;
+};
+/**
+ * @brief Oversampled Exit
+ * @details Receives the output of the inner graph
+ */
+class dibiff::graph::Oversampled::Exit : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioInput* input;
+        Exit() : dibiff::graph::AudioObject() {
+            name = "OversampledExit";
+        }
+        void initialize() override {
+            auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "OversampledExitInput", 0));
+            _inputs.emplace_back(std::move(i));
+            input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+        }
+        void process() override { markProcessed(); }
+        void reset() override {}
+        void clear() override {}
+        bool isFinished() const override { return false; }
+        bool isReadyToProcess() const override {
+            if (!input->isConnected()) {
+                return !processed;
+            }
+            return input->isReady() && !processed;
+        }
+};
+/**
+ * @brief Constructor
+ * @param builder The inner graph builder
+ * @param factor The oversampling factor, 2, 4 or 8
+ * @param channels The number of channels
+ */
+dibiff::graph::Oversampled::Oversampled(Builder builder, int factor, int channels)
+: dibiff::graph::AudioObject(), builder(std::move(builder)), factor(factor), channels(channels) {
+    name = "Oversampled";
+    if (factor != 2 && factor != 4 && factor != 8) {
+        throw std::runtime_error("Oversampling factor must be 2, 4 or 8.");
+    }
+    stages = factor == 2 ? 1 : factor == 4 ? 2 : 3;
+}
+/**
+ * @brief Initialize
+ * @details Initializes the connection points, the resampling filters and the inner graph.
+ * The first stage sees content up to the base Nyquist frequency and needs the steepest
+ * filter; later stages only have to reject images of an already band-limited signal.
+ */
+void dibiff::graph::Oversampled::initialize() {
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "OversampledInput", channels));
+    _inputs.emplace_back(std::move(i));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+    auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "OversampledOutput", channels));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+    const int orders[3] = {16, 8, 4};
+    for (int c = 0; c < channels; ++c) {
+        for (int s = 0; s < stages; ++s) {
+            upsamplers.emplace_back(orders[s]);
+            downsamplers.emplace_back(orders[s]);
+        }
+    }
+    auto e = std::make_unique<Entry>(channels);
+    e->initialize();
+    entry = graph.add(std::move(e)).get();
+    auto x = std::make_unique<Exit>();
+    x->initialize();
+    exit = graph.add(std::move(x)).get();
+    builder(graph, entry->output, exit->input);
+}
+/**
+ * @brief Process a block of samples
+ * @details Upsamples the input, ticks the inner graph and downsamples its output
+ */
+void dibiff::graph::Oversampled::process() {
+    if (!input->isConnected()) {
+        /// If no input is connected, just dump zeros into the output
+        std::vector<float> out(static_cast<std::size_t>(input->getBlockSize()) * channels, 0.0f);
+        output->setData(out, input->getBlockSize(), channels);
+        markProcessed();
+    } else if (input->isReady()) {
+        const int blockSize = input->getBlockSize();
+        const int highBlockSize = blockSize * factor;
+        scratchA.resize(highBlockSize);
+        scratchB.resize(highBlockSize);
+        std::vector<float> up(static_cast<std::size_t>(highBlockSize) * channels);
+        for (int c = 0; c < channels; ++c) {
+            const float* in = input->getChannel(c);
+            int N = blockSize;
+            for (int s = 0; s < stages; ++s) {
+                float* dst = s == stages - 1 ? up.data() + static_cast<std::size_t>(c) * highBlockSize : (s % 2 == 0 ? scratchA.data() : scratchB.data());
+                upsamplers[c * stages + s].upsample(in, N, dst);
+                in = dst;
+                N *= 2;
+            }
+        }
+        entry->output->setData(std::move(up), highBlockSize, channels);
+        graph.tick();
+        std::vector<float> out(static_cast<std::size_t>(blockSize) * channels, 0.0f);
+        if (exit->input->isConnected() && exit->input->getBlockSize() == highBlockSize) {
+            const int innerChannels = exit->input->getChannels();
+            for (int c = 0; c < channels; ++c) {
+                const float* in = exit->input->getChannel(c < innerChannels ? c : 0);
+                int N = highBlockSize / 2;
+                for (int s = stages - 1; s >= 0; --s) {
+                    float* dst = s == 0 ? out.data() + static_cast<std::size_t>(c) * blockSize : (s % 2 == 0 ? scratchA.data() : scratchB.data());
+                    downsamplers[c * stages + s].downsample(in, N, dst);
+                    in = dst;
+                    N /= 2;
+                }
+            }
+        }
+        output->setData(std::move(out), blockSize, channels);
+        markProcessed();
+    }
+}
+/**
+ * @brief Reset the oversampler
+ * @details Resets the resampling filters and every node of the inner graph
+ */
+void dibiff::graph::Oversampled::reset() {
+    for (auto& f : upsamplers) {
+        f.reset();
+    }
+    for (auto& f : downsamplers) {
+        f.reset();
+    }
+    graph.reset();
+}
+/**
+ * @brief Check if the oversampler is finished processing
+ * @return True if the oversampler is finished processing, false otherwise
+ */
+bool dibiff::graph::Oversampled::isFinished() const {
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
+}
+/**
+ * @brief Check if the oversampler is ready to process
+ * @return True if the oversampler is ready to process, false otherwise
+ */
+bool dibiff::graph::Oversampled::isReadyToProcess() const {
+    if (!input->isConnected()) {
+        return true;
+    }
+    return input->isReady() && !processed;
+}
+/**
+ * @brief Set the block size
+ * @details Resizes the scratch buffers and passes the oversampled block size to the inner graph
+ * @param blockSize The new block size
+ */
+void dibiff::graph::Oversampled::setBlockSize(int blockSize) {
+    scratchA.resize(static_cast<std::size_t>(blockSize) * factor);
+    scratchB.resize(static_cast<std::size_t>(blockSize) * factor);
+    graph.setBlockSize(blockSize * factor);
+}
+/**
+ * @brief Get the latency of the resampling filters
+ * @details Stage s runs between 2^s and 2^(s+1) times the base rate, and its up and
+ * down filters each delay the signal by getLatency() samples at the higher rate
+ * @return The round-trip delay of the filters in samples at the base rate
+ */
+float dibiff::graph::Oversampled::getLatency() const {
+    float latency = 0.0f;
+    for (int s = 0; s < stages; ++s) {
+        latency += 2.0f * upsamplers[s].getLatency() / static_cast<float>(2 << s);
+    }
+    return latency;
+}
+/**
+ * @brief Get the state memory of the oversampler
+ * @return The inner graph's memory at the base rate plus the filter latency,
+ * or -1 if the inner graph has unbounded memory
+ */
+long dibiff::graph::Oversampled::getStateMemory() const {
+    long inner = graph.getStateMemory();
+    if (inner < 0) {
+        return -1;
+    }
+    return (inner + factor - 1) / factor + static_cast<long>(std::ceil(getLatency()));
+}
+/**
+ * @brief Create a new oversampler object
+ * @param builder The inner graph builder
+ * @param factor The oversampling factor, 2, 4 or 8
+ * @param channels The number of channels
+ */
+std::unique_ptr<dibiff::graph::Oversampled> dibiff::graph::Oversampled::create(Builder builder, int factor, int channels) {
+    auto instance = std::make_unique<dibiff::graph::Oversampled>(std::move(builder), factor, channels);
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,117 @@
+/// Oversampled.h
+
+#pragma once
+
+#include "graph.h"
+#include "../util/Halfband.h"
+
+#include <functional>
+#include <vector>
+
+namespace dibiff {
+    namespace graph {
+        class Oversampled;
+    }
+}
+
+/**
+ * @brief Oversampled
+ * @details A container that runs an inner graph at 2x, 4x or 8x the sample rate. Input
+ * blocks are upsampled through cascaded polyphase halfband FIRs, processed by the inner
+ * graph at the higher rate and block size, and downsampled again, so nonlinear processing
+ * such as saturation, hard-knee limiting or naive oscillators can run without aliasing
+ * while the rest of the graph stays at the base rate.
+ * The inner nodes must be set up for the oversampled rate.
+ */
+class dibiff::graph::Oversampled : public dibiff::graph::AudioObject {
+    public:
+        /**
+         * @brief Inner graph builder
+         * @details Builds the inner graph between the oversampled input and output
+         */
+        using Builder = std::function<void(dibiff::graph::AudioGraph& graph, dibiff::graph::AudioOutput* input, dibiff::graph::AudioInput* output)>;
+        dibiff::graph::AudioInput* input;
+        dibiff::graph::AudioOutput* output;
+        /**
+         * @brief Constructor
+         * @param builder The inner graph builder
+         * @param factor The oversampling factor, 2, 4 or 8
+         * @param channels The number of channels
+         */
+        Oversampled(Builder builder, int factor, int channels = 1);
+        /**
+         * @brief Initialize
+         * @details Initializes the connection points, the resampling filters and the inner graph
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Upsamples the input, ticks the inner graph and downsamples its output
+         */
+        void process() override;
+        /**
+         * @brief Reset the oversampler
+         * @details Resets the resampling filters and every node of the inner graph
+         */
+        void reset() override;
+        /**
+         * @brief Clear the oversampler
+         * @details Not used
+         */
+        void clear() override {}
+        /**
+         * @brief Check if the oversampler is finished processing
+         * @return True if the oversampler is finished processing, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the oversampler is ready to process
+         * @return True if the oversampler is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @details Resizes the scratch buffers and passes the oversampled block size to
+         * the inner graph
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
+        /**
+         * @brief Get the latency of the resampling filters
+         * @return The round-trip delay of the filters in samples at the base rate
+         */
+        float getLatency() const;
+        /**
+         * @brief Get the state memory of the oversampler
+         * @return The inner graph's memory at the base rate plus the filter latency,
+         * or -1 if the inner graph has unbounded memory
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Get the inner graph
+         * @return The graph running at the oversampled rate
+         */
+        dibiff::graph::AudioGraph& getGraph() { return graph; }
+        /**
+         * @brief Create a new oversampler object
+         * @param builder The inner graph builder
+         * @param factor The oversampling factor, 2, 4 or 8
+         * @param channels The number of channels
+         */
+        static std::unique_ptr<Oversampled> create(Builder builder, int factor, int channels = 1);
+    private:
+        class Entry;
+        class Exit;
+        Builder builder;
+        int factor;
+        int stages;
+        int channels;
+        dibiff::graph::AudioGraph graph;
+        Entry* entry = nullptr;
+        Exit* exit = nullptr;
+        /// Resampling filters, indexed by channel * stages + stage
+        std::vector<dibiff::util::Halfband> upsamplers;
+        std::vector<dibiff::util::Halfband> downsamplers;
+        std::vector<float> scratchA;
+        std::vector<float> scratchB;
+};
@@ -0,0 +1,73 @@
+/// RuntimeOptions.cpp
+
+#include "RuntimeOptions.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+/**
+ * @brief Check if the options change anything
+ * @return True if every option has its default value
+ */
+bool dibiff::graph::RuntimeOptions::isDefault() const {
+    return priority == 0 && cpus.empty() && !lockMemory && stackPrefault == 0;
+}
+/**
+ * @brief Apply the process-wide options
+ * @details Locks memory if requested. Throws if the system refuses.
+ */
+void dibiff::graph::RuntimeOptions::applyToProcess() const {
+#ifdef __linux__
+    if (lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        throw std::runtime_error(std::string("Failed to lock memory: ") + std::strerror(errno));
+    }
+#else
+    if (!isDefault()) {
+        throw std::runtime_error("Runtime options are only supported on Linux.");
+    }
+#endif
+}
+/**
+ * @brief Apply the per-thread options to the calling thread
+ * @details Sets the scheduling and affinity and prefaults the stack
+ * @return True if the system accepted every option
+ */
+bool dibiff::graph::RuntimeOptions::applyToThread() const noexcept {
+#ifdef __linux__
+    bool ok = true;
+    if (priority > 0) {
+        sched_param param = {};
+        param.sched_priority = priority;
+        ok &= pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        ok &= pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+    if (stackPrefault > 0) {
+        /// Touch the pages below the current frame so the thread never faults on its stack
+        volatile unsigned char* stack = static_cast<volatile unsigned char*>(alloca(stackPrefault));
+        for (std::size_t i = 0; i < stackPrefault; i += 4096) {
+            stack[i] = 0;
+        }
+    }
+    return ok;
+#else
+    return isDefault();
+#endif
+}
@@ -0,0 +1,49 @@
+/// RuntimeOptions.h
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace dibiff {
+    namespace graph {
+        struct RuntimeOptions;
+    }
+}
+
+/**
+ * @brief Runtime Options
+ * @details The low-latency settings of the threads that run a graph: real-time
+ * scheduling, CPU affinity, locked memory and prefaulted stacks. Locking memory maps
+ * in every page the process has allocated and every page it allocates later, so node
+ * buffers created by initialize() are resident before the first tick rather than
+ * faulting in during it. The default options change nothing. Only supported on Linux;
+ * real-time priorities need CAP_SYS_NICE or an rtprio limit, and locking memory needs
+ * CAP_IPC_LOCK or a large enough memlock limit.
+ */
+struct dibiff::graph::RuntimeOptions {
+    /// The SCHED_FIFO priority from 1 to 99, or 0 to keep the default scheduling
+    int priority = 0;
+    /// The CPUs to run on, or empty to run anywhere
+    std::vector<int> cpus = {};
+    /// Lock all current and future memory of the process into RAM
+    bool lockMemory = false;
+    /// The number of bytes of stack to touch in each thread, or 0 to leave stacks alone
+    std::size_t stackPrefault = 0;
+    /**
+     * @brief Check if the options change anything
+     * @return True if every option has its default value
+     */
+    bool isDefault() const;
+    /**
+     * @brief Apply the process-wide options
+     * @details Locks memory if requested. Throws if the system refuses.
+     */
+    void applyToProcess() const;
+    /**
+     * @brief Apply the per-thread options to the calling thread
+     * @details Sets the scheduling and affinity and prefaults the stack
+     * @return True if the system accepted every option
+     */
+    bool applyToThread() const noexcept;
+};
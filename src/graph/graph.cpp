@@ -1,6 +1,10 @@
 /// graph.cpp
 
 #include "graph.h"
+#include "HealthMonitor.h"
+#include "../inc/Eigen/Dense"
+#include "../util/EventLog.h"
+#include "../util/StateBlob.h"
 
 #include <queue>
 #include <unordered_set>
@@ -13,15 +17,78 @@
 
 std::vector<float> dibiff::graph::AudioInput::empty = {};
 std::vector<std::vector<unsigned char>> dibiff::graph::MidiInput::empty = {};
+std::vector<int> dibiff::graph::MidiInput::emptyOffsets = {};
 
+/**
+ * @brief Enable or disable the object
+ * @param enabled Whether the object is enabled
+ */
+void dibiff::graph::AudioObject::setEnabled(bool enabled) {
+    if (this->enabled != enabled) {
+        this->enabled = enabled;
+        dibiff::graph::AudioGraph::topologyChanged(this);
+    }
+}
+
+namespace {
+    /**
+     * @brief Check that a signal can cross between two rates
+     * @details The graph decimates or interpolates by whole factors only
+     * @param from The rate divisor of the output
+     * @param to The rate divisor of the input
+     */
+    void checkRates(int from, int to) {
+        if (from % to != 0 && to % from != 0) {
+            throw std::runtime_error("Incompatible rate divisors.");
+        }
+    }
+}
+/**
+ * @brief Set the rate divisor
+ * @details Checked against every connected object and the block size of the graph
+ * before it is changed. In a graph whose block size is known, the object is given
+ * the divided block size at once.
+ * @param divisor The rate divisor, 1 for full rate
+ */
+void dibiff::graph::AudioObject::setRateDivisor(int divisor) {
+    if (divisor < 1) {
+        throw std::runtime_error("Rate divisor must be at least 1.");
+    }
+    for (auto& input : _inputs) {
+        if (auto i = dynamic_cast<dibiff::graph::AudioInput*>(input.get())) {
+            if (i->connectedOutput != nullptr) {
+                checkRates(i->connectedOutput->parent->getRateDivisor(), divisor);
+            }
+        }
+    }
+    for (auto& output : _outputs) {
+        if (auto o = dynamic_cast<dibiff::graph::AudioOutput*>(output.get())) {
+            for (auto& i : o->connectedInputs) {
+                checkRates(divisor, i->parent->getRateDivisor());
+            }
+        }
+    }
+    const int graphBlockSize = owner != nullptr ? owner->getBlockSize() : 0;
+    if (graphBlockSize % divisor != 0) {
+        throw std::runtime_error("Block size is not a multiple of the rate divisor.");
+    }
+    rateDivisor = divisor;
+    if (graphBlockSize > 0) {
+        setBlockSize(graphBlockSize / divisor);
+    }
+}
 /**
  * Audio Input implementation
  */
 void dibiff::graph::AudioInput::connect(dibiff::graph::AudioOutput* output) {
     connectedOutput = output;
+    dibiff::graph::AudioGraph::topologyChanged(parent);
 }
 void dibiff::graph::AudioInput::disconnect() {
     connectedOutput = nullptr;
+    dibiff::graph::AudioGraph::topologyChanged(parent);
+    rateAdapted = false;
+    history.clear();
 }
 bool dibiff::graph::AudioInput::isConnected() {
     return (connectedOutput != nullptr);
@@ -39,25 +106,115 @@ bool dibiff::graph::AudioInput::isFinished() const {
     return false;
 }
 const std::vector<float>& dibiff::graph::AudioInput::getData() const {
+    if (rateAdapted) {
+        return adapted;
+    }
     if (connectedOutput != nullptr) {
         return connectedOutput->getData();
     }
     return empty;
 }
 const int dibiff::graph::AudioInput::getBlockSize() const {
+    if (rateAdapted) {
+        return adaptedBlockSize;
+    }
     if (connectedOutput != nullptr) {
         return connectedOutput->getBlockSize();
     }
     return 0;
 }
+const int dibiff::graph::AudioInput::getChannels() const {
+    if (channels != 0) {
+        return channels;
+    }
+    if (connectedOutput != nullptr) {
+        return connectedOutput->getChannels();
+    }
+    return 1;
+}
+const float* dibiff::graph::AudioInput::getChannel(int channel) const {
+    if (connectedOutput == nullptr) {
+        return nullptr;
+    }
+    if (rateAdapted) {
+        int c = adaptedChannels == 1 ? 0 : channel;
+        return adapted.data() + static_cast<std::size_t>(c) * adaptedBlockSize;
+    }
+    /// Mono outputs are broadcast to every channel
+    if (connectedOutput->getChannels() == 1) {
+        return connectedOutput->getChannel(0);
+    }
+    return connectedOutput->getChannel(channel);
+}
+void dibiff::graph::AudioInput::adaptRate() {
+    if (connectedOutput == nullptr || !connectedOutput->isProcessed()) {
+        return;
+    }
+    /// The output may have changed its channel count, or be aliased to another, since it was connected
+    if (!accepts(connectedOutput->getChannels())) {
+        throw std::runtime_error("Channel count mismatch.");
+    }
+    const int from = connectedOutput->parent->getRateDivisor();
+    const int to = parent->getRateDivisor();
+    if (from == to) {
+        rateAdapted = false;
+        return;
+    }
+    const int numChannels = connectedOutput->getChannels();
+    const int N = connectedOutput->getBlockSize();
+    if (to > from) {
+        /// Decimate: average each group of samples down to one
+        if (to % from != 0) {
+            throw std::runtime_error("Incompatible rate divisors.");
+        }
+        const int factor = to / from;
+        if (N % factor != 0) {
+            throw std::runtime_error("Block size is not a multiple of the rate divisor.");
+        }
+        const int M = N / factor;
+        adapted.resize(static_cast<std::size_t>(M) * numChannels);
+        for (int c = 0; c < numChannels; ++c) {
+            Eigen::Map<const Eigen::MatrixXf> groups(connectedOutput->getChannel(c), factor, M);
+            Eigen::Map<Eigen::RowVectorXf>(adapted.data() + static_cast<std::size_t>(c) * M, M) = groups.colwise().mean();
+        }
+        adaptedBlockSize = M;
+    } else {
+        /// Interpolate: ramp linearly from the previous sample to each new one
+        if (from % to != 0) {
+            throw std::runtime_error("Incompatible rate divisors.");
+        }
+        const int factor = from / to;
+        const int M = N * factor;
+        adapted.resize(static_cast<std::size_t>(M) * numChannels);
+        history.resize(numChannels, 0.0f);
+        for (int c = 0; c < numChannels; ++c) {
+            const float* in = connectedOutput->getChannel(c);
+            float* out = adapted.data() + static_cast<std::size_t>(c) * M;
+            float prev = history[c];
+            for (int i = 0; i < N; ++i) {
+                const float step = (in[i] - prev) / factor;
+                for (int k = 0; k < factor; ++k) {
+                    out[i * factor + k] = prev + step * (k + 1);
+                }
+                prev = in[i];
+            }
+            history[c] = prev;
+        }
+        adaptedBlockSize = M;
+    }
+    adaptedChannels = numChannels;
+    rateAdapted = true;
+}
 /**
  * MIDI Input implementation
  */
 void dibiff::graph::MidiInput::connect(dibiff::graph::MidiOutput* output) {
     connectedOutput = output;
+    dibiff::graph::AudioGraph::topologyChanged(parent);
 }
 void dibiff::graph::MidiInput::disconnect() {
     connectedOutput = nullptr;
+    dibiff::graph::AudioGraph::topologyChanged(parent);
 }
 bool dibiff::graph::MidiInput::isConnected() {
     return (connectedOutput != nullptr);
@@ -80,6 +237,12 @@ const std::vector<std::vector<unsigned char>>& dibiff::graph::MidiInput::getData
     }
     return empty;
 }
+const std::vector<int>& dibiff::graph::MidiInput::getOffsets() const {
+    if (connectedOutput != nullptr) {
+        return connectedOutput->getOffsets();
+    }
+    return emptyOffsets;
+}
 const int dibiff::graph::MidiInput::getBlockSize() const {
     if (connectedOutput != nullptr) {
         return connectedOutput->getBlockSize();
@@ -99,13 +262,49 @@ void dibiff::graph::AudioOutput::setData(std::vector<float> audioData, int N) {
     data = audioData;
     blockSize = N;
 }
+void dibiff::graph::AudioOutput::setData(std::vector<float> audioData, int N, int numChannels) {
+    if (numChannels != channels) {
+        for (auto& inChannel : connectedInputs) {
+            if (!inChannel->accepts(numChannels)) {
+                throw std::runtime_error("Channel count mismatch.");
+            }
+        }
+    }
+    data = std::move(audioData);
+    blockSize = N;
+    channels = numChannels;
+}
 const std::vector<float>& dibiff::graph::AudioOutput::getData() const {
+    if (alias != nullptr) {
+        return alias->getData();
+    }
     return data;
 }
 const int dibiff::graph::AudioOutput::getBlockSize() const {
+    if (alias != nullptr) {
+        return alias->getBlockSize();
+    }
     return blockSize;
 }
+const int dibiff::graph::AudioOutput::getChannels() const {
+    if (alias != nullptr) {
+        return alias->getChannels();
+    }
+    return channels;
+}
+const float* dibiff::graph::AudioOutput::getChannel(int channel) const {
+    if (alias != nullptr) {
+        return alias->getChannel(channel);
+    }
+    return data.data() + static_cast<std::size_t>(channel) * blockSize;
+}
 void dibiff::graph::AudioOutput::connect(dibiff::graph::AudioInput* inChannel) {
+    /// Negotiate the channel count: mono outputs are broadcast, and inputs
+    /// accepting any channel count follow the output
+    if (!inChannel->accepts(channels)) {
+        throw std::runtime_error("Channel count mismatch.");
+    }
+    checkRates(parent->getRateDivisor(), inChannel->parent->getRateDivisor());
     if (!inChannel->isConnected()) {
         inChannel->connect(this);
         connectedInputs.push_back(inChannel);
@@ -146,11 +345,23 @@ bool dibiff::graph::MidiOutput::isFinished() const {
 }
 void dibiff::graph::MidiOutput::setData(std::vector<std::vector<unsigned char>> audioData, int N) {
     data = audioData;
+    offsets.clear();
+    blockSize = N;
+}
+void dibiff::graph::MidiOutput::setData(std::vector<std::vector<unsigned char>> midiData, int N, std::vector<int> messageOffsets) {
+    if (messageOffsets.size() != midiData.size()) {
+        throw std::runtime_error("Every MIDI message needs an offset.");
+    }
+    data = std::move(midiData);
+    offsets = std::move(messageOffsets);
     blockSize = N;
 }
 const std::vector<std::vector<unsigned char>>& dibiff::graph::MidiOutput::getData() const {
     return data;
 }
+const std::vector<int>& dibiff::graph::MidiOutput::getOffsets() const {
+    return offsets;
+}
 const int dibiff::graph::MidiOutput::getBlockSize() const {
     return blockSize;
 }
@@ -189,13 +400,129 @@ bool dibiff::graph::MidiOutput::isConnected() {
  * together to form a processing graph. The audio graph processes the audio
  * objects in the correct order to generate the final output.
  */
+dibiff::graph::AudioGraph::AudioGraph() {}
+dibiff::graph::AudioGraph::~AudioGraph() {
+    /// Nodes that outlive the graph, or disconnect as they are destroyed, must not reach it
+    for (auto& obj : objects) {
+        if (obj->owner == this) {
+            obj->owner = nullptr;
+        }
+    }
+    /// Destroy owned nodes in reverse order of creation
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+        destroy(i);
+    }
+}
+void dibiff::graph::AudioGraph::makeRoom() {
+    auto room = [](auto& table) {
+        if (table.size() == table.capacity()) {
+            table.reserve(table.size() * 2 + 1);
+        }
+    };
+    room(objects);
+    room(nodes);
+    room(inArena);
+}
+std::size_t dibiff::graph::AudioGraph::track(dibiff::graph::AudioObject* obj, bool arenaAllocated) {
+    nodes.push_back(obj);
+    inArena.push_back(arenaAllocated);
+    return nodes.size() - 1;
+}
+void dibiff::graph::AudioGraph::destroy(std::size_t index) {
+    dibiff::graph::AudioObject* obj = nodes[index];
+    if (obj == nullptr) {
+        return;
+    }
+    /// Don't leave neighbours pointing at a destroyed node
+    obj->disconnectAll();
+    if (inArena[index]) {
+        obj->~AudioObject();
+    } else {
+        delete obj;
+    }
+    nodes[index] = nullptr;
+}
+/**
+ * @brief Reserve memory for a number of nodes
+ * @param bytes The total size of the nodes, including alignment padding
+ * @param count The number of nodes
+ */
+void dibiff::graph::AudioGraph::reserve(std::size_t bytes, std::size_t count) {
+    arena.reserve(bytes);
+    objects.reserve(objects.size() + count);
+    nodes.reserve(nodes.size() + count);
+    inArena.reserve(inArena.size() + count);
+}
+/**
+ * @brief Place a node in the graph without initializing it
+ * @param size The size of the node
+ * @param alignment The alignment of the node
+ * @param construct Constructs the node at the given address
+ * @return A handle to the node
+ */
+dibiff::graph::NodeHandle<dibiff::graph::AudioObject> dibiff::graph::AudioGraph::place(std::size_t size, std::size_t alignment, const std::function<dibiff::graph::AudioObject*(void*)>& construct) {
+    makeRoom();
+    dibiff::graph::AudioObject* obj = construct(arena.allocate(size, alignment));
+    enlist(obj);
+    return dibiff::graph::NodeHandle<dibiff::graph::AudioObject>(this, track(obj, true));
+}
+dibiff::graph::AudioObject* dibiff::graph::AudioGraph::node(std::size_t index) const {
+    return index < nodes.size() ? nodes[index] : nullptr;
+}
+long dibiff::graph::AudioGraph::getStateMemory() const {
+    long memory = 0;
+    for (auto& obj : objects) {
+        long m = obj->getStateMemory();
+        if (m < 0) {
+            return -1;
+        }
+        memory += m;
+    }
+    return memory;
+}
+void dibiff::graph::AudioGraph::reset() {
+    for (auto& obj : objects) {
+        obj->reset();
+    }
+}
+std::vector<unsigned char> dibiff::graph::AudioGraph::saveState() const {
+    dibiff::util::StateWriter writer("AudioGraph", 1);
+    writer.write(static_cast<std::uint64_t>(objects.size()));
+    for (auto& obj : objects) {
+        writer.writeVector(std::vector<char>(obj->name.begin(), obj->name.end()));
+        writer.writeVector(obj->saveState());
+    }
+    return writer.finish();
+}
+void dibiff::graph::AudioGraph::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "AudioGraph", 1);
+    if (reader.read<std::uint64_t>() != objects.size()) {
+        throw std::runtime_error("State was saved from a graph with a different number of objects.");
+    }
+    /// Check every entry before restoring any object
+    std::vector<std::vector<unsigned char>> blobs(objects.size());
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        const std::vector<char> name = reader.readVector<char>();
+        if (std::string(name.begin(), name.end()) != objects[i]->name) {
+            throw std::runtime_error("State was saved from a graph with different objects.");
+        }
+        /// Each entry keeps the length it was saved with, which can differ from what the
+        /// object would save now, such as a filter that has not seen its channels yet
+        blobs[i] = reader.readVector<unsigned char>();
+    }
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        if (!blobs[i].empty()) {
+            objects[i]->restoreState(blobs[i]);
+        }
+    }
+}
 dibiff::graph::AudioObject* dibiff::graph::AudioGraph::add(dibiff::graph::AudioObject* obj) {
-    objects.push_back(obj);
+    enlist(obj);
     return obj;
 }
 dibiff::graph::AudioCompositeObject* dibiff::graph::AudioGraph::add(dibiff::graph::AudioCompositeObject* obj) {
     for (auto& o : obj->objects) {
-        objects.push_back(o.get());
+        enlist(o.get());
     }
     return obj;
 }
@@ -204,19 +531,174 @@ void dibiff::graph::AudioGraph::remove(dibiff::graph::AudioObject* obj) {
     objects.erase(std::remove_if(objects.begin(), objects.end(), [&](const dibiff::graph::AudioObject* o) {
         return o == obj;
     }), objects.end());
+    if (obj->owner == this) {
+        obj->owner = nullptr;
+    }
+    compileSchedule();
 }
 void dibiff::graph::AudioGraph::remove(dibiff::graph::AudioCompositeObject* obj) {
     for (auto& o : obj->objects) {
         remove(o.get());
     }
 }
+/**
+ * @brief Set the runtime options of the graph
+ * @param options The runtime options
+ */
+void dibiff::graph::AudioGraph::setRuntimeOptions(const dibiff::graph::RuntimeOptions& options) {
+    options.applyToProcess();
+    if (!options.applyToThread()) {
+        throw std::runtime_error("Failed to apply the real-time scheduling or CPU affinity.");
+    }
+    runtimeOptions = options;
+    optionsThread = std::this_thread::get_id();
+}
+/**
+ * @brief Change the block size of the graph
+ * @details Each object is given the block size divided by its rate divisor
+ * @param blockSize The new block size
+ */
+void dibiff::graph::AudioGraph::setBlockSize(int blockSize) {
+    if (blockSize <= 0) {
+        throw std::runtime_error("Block size must be positive.");
+    }
+    /// Check every object before resizing any, so a bad size leaves the graph as it was
+    for (auto& obj : objects) {
+        if (blockSize % obj->getRateDivisor() != 0) {
+            throw std::runtime_error("Block size is not a multiple of the rate divisor.");
+        }
+    }
+    this->blockSize = blockSize;
+    for (auto& obj : objects) {
+        obj->setBlockSize(blockSize / obj->getRateDivisor());
+    }
+}
+/**
+ * @brief Monitor the health of an output
+ * @param port The output to monitor
+ * @param options The thresholds and the action taken on unhealthy blocks
+ * @return The monitor, owned by the graph
+ */
+dibiff::graph::HealthMonitor* dibiff::graph::AudioGraph::monitor(dibiff::graph::AudioOutput* port, const dibiff::graph::HealthOptions& options) {
+    unmonitor(port);
+    monitors.push_back(std::make_unique<dibiff::graph::HealthMonitor>(port, options));
+    port->monitor = monitors.back().get();
+    return port->monitor;
+}
+dibiff::graph::HealthMonitor* dibiff::graph::AudioGraph::monitor(dibiff::graph::AudioOutput* port) {
+    return monitor(port, dibiff::graph::HealthOptions());
+}
+/**
+ * @brief Stop monitoring an output
+ * @param port The monitored output
+ */
+void dibiff::graph::AudioGraph::unmonitor(dibiff::graph::AudioOutput* port) {
+    port->monitor = nullptr;
+    monitors.erase(std::remove_if(monitors.begin(), monitors.end(), [&](const std::unique_ptr<dibiff::graph::HealthMonitor>& m) {
+        return m->getPort() == port;
+    }), monitors.end());
+}
+/**
+ * @brief Check the monitored outputs of an object
+ * @param obj The object that has just processed
+ */
+void dibiff::graph::AudioGraph::checkHealth(dibiff::graph::AudioObject* obj) {
+    for (auto& output : obj->_outputs) {
+        if (auto o = dynamic_cast<dibiff::graph::AudioOutput*>(output.get())) {
+            if (o->monitor != nullptr) {
+                o->monitor->check();
+            }
+        }
+    }
+}
+/**
+ * @brief Set the evaluation mode
+ * @param evaluation The evaluation mode
+ */
+void dibiff::graph::AudioGraph::setEvaluation(Evaluation evaluation) {
+    this->evaluation = evaluation;
+    compileSchedule();
+}
+/**
+ * @brief Get the objects processed each tick
+ * @return Every object in push evaluation, or the compiled schedule in pull evaluation
+ */
+const std::vector<dibiff::graph::AudioObject*>& dibiff::graph::AudioGraph::getSchedule() {
+    return evaluation == Evaluation::Push ? objects : schedule;
+}
+/**
+ * @brief Recompile the schedule of the graph an object belongs to
+ * @param obj The object whose connections or state changed
+ */
+void dibiff::graph::AudioGraph::topologyChanged(dibiff::graph::AudioObject* obj) {
+    if (obj != nullptr && obj->owner != nullptr) {
+        obj->owner->compileSchedule();
+    }
+}
+/**
+ * @brief Add an object to the list of objects processed
+ * @details Claims the object for this graph and recompiles the schedule
+ * @param obj The object
+ */
+void dibiff::graph::AudioGraph::enlist(dibiff::graph::AudioObject* obj) {
+    objects.push_back(obj);
+    try {
+        compileSchedule();
+    } catch (...) {
+        objects.pop_back();
+        throw;
+    }
+    obj->owner = this;
+}
+/**
+ * @brief Compile the pull schedule
+ * @details Walks the connections backwards from every enabled sink and keeps the
+ * objects it reaches, in graph order. Connections to objects outside the graph are
+ * not followed. Nothing is compiled in push evaluation, which processes every object.
+ */
+void dibiff::graph::AudioGraph::compileSchedule() {
+    if (evaluation == Evaluation::Push) {
+        schedule.clear();
+        return;
+    }
+    std::unordered_set<dibiff::graph::AudioObject*> inGraph(objects.begin(), objects.end());
+    std::unordered_set<dibiff::graph::AudioObject*> reached;
+    std::vector<dibiff::graph::AudioObject*> pending;
+    for (auto& obj : objects) {
+        if (obj->isSink() && obj->isEnabled() && reached.insert(obj).second) {
+            pending.push_back(obj);
+        }
+    }
+    while (!pending.empty()) {
+        dibiff::graph::AudioObject* obj = pending.back();
+        pending.pop_back();
+        for (auto& input : obj->_inputs) {
+            dibiff::graph::AudioObject* upstream = nullptr;
+            if (auto i = dynamic_cast<dibiff::graph::AudioInput*>(input.get())) {
+                upstream = i->connectedOutput ? i->connectedOutput->parent : nullptr;
+            } else if (auto mi = dynamic_cast<dibiff::graph::MidiInput*>(input.get())) {
+                upstream = mi->connectedOutput ? mi->connectedOutput->parent : nullptr;
+            }
+            if (upstream && inGraph.count(upstream) && reached.insert(upstream).second) {
+                pending.push_back(upstream);
+            }
+        }
+    }
+    schedule.clear();
+    for (auto& obj : objects) {
+        if (reached.count(obj)) {
+            schedule.push_back(obj);
+        }
+    }
+}
 /**
  * @brief Process the audio graph
  * @details Processes the audio graph by running the audio objects in the correct order
  * and connecting the audio objects together. The audio graph processes the audio objects
  * in a block-based manner, where each audio object processes a block of samples at a time.
  * This is a multi-threaded implementation where each audio object is processed in a separate
- * thread.
+ * thread. Inputs crossing a rate boundary are adapted just before their object is processed.
+ * In pull evaluation only the compiled schedule is processed.
  */
 void dibiff::graph::AudioGraph::tick() {
     std::queue<dibiff::graph::AudioObject*> readyQueue;
@@ -224,13 +706,22 @@ void dibiff::graph::AudioGraph::tick() {
     std::unordered_set<dibiff::graph::AudioObject*> inQueueOrProcessed;
     std::mutex queueMutex;
     std::mutex processedMutex;
+    /// Workers inherit the scheduling and affinity of this thread, so only a new ticking
+    /// thread needs the options applied
+    if (!runtimeOptions.isDefault() && optionsThread != std::this_thread::get_id()) {
+        optionsThread = std::this_thread::get_id();
+        if (!runtimeOptions.applyToThread()) {
+            dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Error, "AudioGraph", "Failed to apply the real-time scheduling or CPU affinity.");
+        }
+    }
+    const std::vector<dibiff::graph::AudioObject*>& active = getSchedule();
     // Initialize the queue with objects that are ready to process
-    for (auto& obj : objects) {
+    for (auto& obj : active) {
         // Mark all objects as not processed at the start of each block
         obj->markProcessed(false);
     }
     /// Must do this twice to prevent out-of-order processing
-    for (auto& obj : objects) {
+    for (auto& obj : active) {
         if (obj->isReadyToProcess()) {
             readyQueue.push(obj);
             inQueueOrProcessed.insert(obj);
@@ -246,8 +737,23 @@ void dibiff::graph::AudioGraph::tick() {
             auto obj = readyQueue.front();
             readyQueue.pop();
             // Create a thread to process the object
-            threads.push_back(std::thread([obj, &processedMutex, &processed, &inQueueOrProcessed]() {
-                obj->process();
+            threads.push_back(std::thread([this, obj, &processedMutex, &processed, &inQueueOrProcessed]() {
+                try {
+                    applyBypass(obj);
+                    if (obj->bypassed || obj->bypassFade > 0 || obj->bypassAliased) {
+                        processBypassed(obj);
+                    } else {
+                        adaptInputs(obj);
+                        obj->process();
+                    }
+                    if (!monitors.empty()) {
+                        checkHealth(obj);
+                    }
+                } catch (const std::exception& e) {
+                    /// An exception escaping a worker would terminate the process, so silence the node instead
+                    dibiff::util::EventLog::global().log(dibiff::util::EventLog::Level::Error, obj->getName().c_str(), e.what());
+                    silence(obj);
+                }
                 std::lock_guard<std::mutex> lock(processedMutex);
                 processed.insert(obj);
                 inQueueOrProcessed.insert(obj);
@@ -258,7 +764,7 @@ void dibiff::graph::AudioGraph::tick() {
             thread.join();
         }
         // Check connected objects to see if they are now ready to process
-        for (auto& connectedObj : objects) {
+        for (auto& connectedObj : active) {
             std::lock_guard<std::mutex> lock(processedMutex);
             if (processed.find(connectedObj) == processed.end() &&
                 connectedObj->isReadyToProcess() &&
@@ -269,6 +775,142 @@ void dibiff::graph::AudioGraph::tick() {
         }
     }
 }
+/**
+ * @brief Silence the outputs of an object
+ * @details The fallback for an object that failed to process: its audio outputs keep
+ * their shape filled with zeros, its MIDI outputs are emptied, and it is marked processed
+ * so the rest of the graph carries on
+ * @param obj The object that failed
+ */
+void dibiff::graph::AudioGraph::silence(dibiff::graph::AudioObject* obj) {
+    for (auto& output : obj->_outputs) {
+        if (auto o = dynamic_cast<dibiff::graph::AudioOutput*>(output.get())) {
+            if (o->data.empty()) {
+                o->blockSize = 0;
+            }
+            std::fill(o->data.begin(), o->data.end(), 0.0f);
+        } else if (auto mo = dynamic_cast<dibiff::graph::MidiOutput*>(output.get())) {
+            mo->data.clear();
+            mo->offsets.clear();
+        }
+    }
+    obj->markProcessed();
+}
+/**
+ * @brief Pick up the bypass requested for an object
+ * @details Runs on the tick thread at the block boundary, so the crossfade state is
+ * only ever touched while the object is processed
+ * @param obj The object about to be processed
+ */
+void dibiff::graph::AudioGraph::applyBypass(dibiff::graph::AudioObject* obj) {
+    const int crossfade = obj->bypassCrossfadeRequest.load(std::memory_order_acquire);
+    if (crossfade != obj->bypassCrossfade) {
+        obj->bypassCrossfade = crossfade;
+        obj->bypassFade = std::min(obj->bypassFade, crossfade);
+    }
+    const bool bypassed = obj->bypassRequest.load(std::memory_order_acquire);
+    if (bypassed != obj->bypassed) {
+        obj->bypassed = bypassed;
+        /// Reversing part way through a crossfade continues from the current mix
+        obj->bypassFade = obj->bypassCrossfade - obj->bypassFade;
+    }
+}
+/**
+ * @brief Process an object that is bypassed or crossfading
+ * @details Pairs the n-th audio output with the n-th audio input. Once bypassed, each
+ * output is aliased to its input and the object only runs if it keeps its state. During
+ * a crossfade the object is processed and its output is mixed with the input in place.
+ * MIDI outputs are emptied while bypassed.
+ * @param obj The object to process
+ */
+void dibiff::graph::AudioGraph::processBypassed(dibiff::graph::AudioObject* obj) {
+    adaptInputs(obj);
+    const bool fading = obj->bypassFade > 0;
+    if (!obj->bypassed && !fading) {
+        /// The bypass was switched off without a crossfade: drop the aliases and run normally
+        for (auto& output : obj->_outputs) {
+            if (auto o = dynamic_cast<dibiff::graph::AudioOutput*>(output.get())) {
+                o->alias = nullptr;
+            }
+        }
+        obj->bypassAliased = false;
+        obj->process();
+        return;
+    }
+    if (fading || obj->bypassKeepsState.load(std::memory_order_acquire)) {
+        obj->process();
+    }
+    std::vector<const dibiff::graph::AudioInput*> inputs;
+    for (auto& input : obj->_inputs) {
+        if (auto i = dynamic_cast<const dibiff::graph::AudioInput*>(input.get())) {
+            inputs.push_back(i);
+        }
+    }
+    std::size_t k = 0;
+    int fadeLength = 0;
+    for (auto& output : obj->_outputs) {
+        if (auto mo = dynamic_cast<dibiff::graph::MidiOutput*>(output.get())) {
+            if (!fading) {
+                mo->data.clear();
+                mo->offsets.clear();
+            }
+            continue;
+        }
+        auto o = dynamic_cast<dibiff::graph::AudioOutput*>(output.get());
+        if (o == nullptr) {
+            continue;
+        }
+        const dibiff::graph::AudioInput* in = k < inputs.size() && inputs[k]->connectedOutput != nullptr ? inputs[k] : nullptr;
+        ++k;
+        if (!fading) {
+            o->alias = in;
+            if (in == nullptr) {
+                std::fill(o->data.begin(), o->data.end(), 0.0f);
+            }
+            continue;
+        }
+        o->alias = nullptr;
+        const int N = o->blockSize;
+        if (in == nullptr || in->getBlockSize() != N || o->data.size() < static_cast<std::size_t>(N) * o->channels) {
+            continue;
+        }
+        /// The dry gain ramps towards 1 when bypassing and towards 0 when resuming
+        const float L = static_cast<float>(obj->bypassCrossfade);
+        const int n = std::min(N, obj->bypassFade);
+        Eigen::ArrayXf dry = (obj->bypassFade - Eigen::ArrayXf::LinSpaced(n, 0.0f, static_cast<float>(n - 1))) / L;
+        if (obj->bypassed) {
+            dry = 1.0f - dry;
+        }
+        for (int c = 0; c < o->channels; ++c) {
+            Eigen::Map<Eigen::ArrayXf> wet(o->data.data() + static_cast<std::size_t>(c) * N, N);
+            Eigen::Map<const Eigen::ArrayXf> input(in->getChannel(c), N);
+            wet.head(n) = dry * input.head(n) + (1.0f - dry) * wet.head(n);
+            if (obj->bypassed) {
+                wet.tail(N - n) = input.tail(N - n);
+            }
+        }
+        fadeLength = std::max(fadeLength, N);
+    }
+    if (fading) {
+        /// Objects with nothing to crossfade switch at once
+        obj->bypassFade = fadeLength > 0 ? std::max(0, obj->bypassFade - fadeLength) : 0;
+    }
+    obj->bypassAliased = !fading;
+    obj->markProcessed();
+}
+/**
+ * @brief Adapt the inputs of an object to its rate
+ * @details Resamples every audio input whose connected output runs at a
+ * different rate divisor than the object
+ * @param obj The object about to be processed
+ */
+void dibiff::graph::AudioGraph::adaptInputs(dibiff::graph::AudioObject* obj) {
+    for (auto& input : obj->_inputs) {
+        if (auto i = dynamic_cast<dibiff::graph::AudioInput*>(input.get())) {
+            i->adaptRate();
+        }
+    }
+}
 
 /**
  * @brief Connect two audio objects
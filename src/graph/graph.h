@@ -4,9 +4,14 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
+#include <algorithm>
 #include <optional>
 #include <functional>
 #include <memory>
+#include <thread>
+#include <new>
+#include <type_traits>
 #include <cmath>
 #include <chrono>
 #include <iostream>
@@ -14,6 +19,9 @@
 #include <cstdint>
 #include <math.h>
 
+#include "../util/Arena.h"
+#include "RuntimeOptions.h"
+
 /// TODO: Put these in separate files
 
 namespace dibiff {
@@ -30,6 +38,9 @@ namespace dibiff {
         class MidiOutput;
         class AudioConnectionPoint;
         class AudioGraph;
+        class HealthMonitor;
+        struct HealthOptions;
+        template<typename T> class NodeHandle;
     }
 }
 /**
@@ -53,10 +64,23 @@ class dibiff::graph::AudioInput : public dibiff::graph::AudioConnectionPoint {
     public:
         dibiff::graph::AudioOutput* connectedOutput = nullptr;
         dibiff::graph::AudioObject* parent;
+        /**
+         * @brief The number of channels this input accepts
+         * @details A value of 0 accepts any channel count, for objects that process
+         * every plane. The default of 1 is for objects that process a single channel.
+         * Mono outputs can always be connected and are broadcast to every channel.
+         */
+        int channels;
         static std::vector<float> empty;
-        AudioInput(dibiff::graph::AudioObject* parent, std::string name) 
+        AudioInput(dibiff::graph::AudioObject* parent, std::string name, int channels = 1) 
         : dibiff::graph::AudioConnectionPoint(name), 
-          parent(parent) {};
+          parent(parent), channels(channels) {};
+        /**
+         * @brief Check if the input accepts a channel count
+         * @param numChannels The channel count of an output
+         * @return True if the count matches, the input accepts any, or the output is mono
+         */
+        bool accepts(int numChannels) const { return channels == 0 || numChannels == 1 || numChannels == channels; }
         void connect(dibiff::graph::AudioOutput* output);
         void disconnect();
         bool isConnected() override;
@@ -64,6 +88,23 @@ class dibiff::graph::AudioInput : public dibiff::graph::AudioConnectionPoint {
         bool isFinished() const;
         const std::vector<float>& getData() const;
         const int getBlockSize() const;
+        const int getChannels() const;
+        const float* getChannel(int channel) const;
+        /**
+         * @brief Adapt the connected output to the rate of this input
+         * @details Called by the graph before the parent is processed. When the
+         * connected output runs at a different rate divisor than the parent,
+         * its data is decimated with a box filter or linearly interpolated, and
+         * getData(), getBlockSize() and getChannel() return the adapted block.
+         */
+        void adaptRate();
+    private:
+        bool rateAdapted = false;
+        std::vector<float> adapted = {};
+        int adaptedBlockSize = 0;
+        int adaptedChannels = 1;
+        /// The last sample of the previous block per channel, for interpolation
+        std::vector<float> history = {};
 };
 /**
  * @brief MIDI Input Connection Point
@@ -74,6 +115,7 @@ class dibiff::graph::MidiInput : public dibiff::graph::AudioConnectionPoint {
         dibiff::graph::MidiOutput* connectedOutput = nullptr;
         dibiff::graph::AudioObject* parent;
         static std::vector<std::vector<unsigned char>> empty;
+        static std::vector<int> emptyOffsets;
         MidiInput(dibiff::graph::AudioObject* parent, std::string name) 
         : dibiff::graph::AudioConnectionPoint(name), 
           parent(parent) {};
@@ -83,6 +125,11 @@ class dibiff::graph::MidiInput : public dibiff::graph::AudioConnectionPoint {
         bool isReady() const;
         bool isFinished() const;
         const std::vector<std::vector<unsigned char>>& getData() const;
+        /**
+         * @brief Get the sample offsets of the messages
+         * @return The offset of each message within the block, or an empty vector if every message applies from the start of the block
+         */
+        const std::vector<int>& getOffsets() const;
         const int getBlockSize() const;
 };
 /**
@@ -93,16 +140,40 @@ class dibiff::graph::AudioOutput : public dibiff::graph::AudioConnectionPoint {
     public:
         dibiff::graph::AudioObject* parent;
         std::vector<dibiff::graph::AudioInput*> connectedInputs = {};
+        /**
+         * @brief Planar audio data
+         * @details Holds `channels` consecutive planes of `blockSize` samples each
+         */
         std::vector<float> data = {};
         int blockSize;
-        AudioOutput(dibiff::graph::AudioObject* parent, std::string name)
+        int channels;
+        /**
+         * @brief The input this output forwards
+         * @details Set by the graph while the parent is bypassed, so readers see the
+         * input's block in place of the output's own data without a copy
+         */
+        const dibiff::graph::AudioInput* alias = nullptr;
+        /// The health monitor checking this output, if any
+        dibiff::graph::HealthMonitor* monitor = nullptr;
+        AudioOutput(dibiff::graph::AudioObject* parent, std::string name, int channels = 1)
         : dibiff::graph::AudioConnectionPoint(name), 
-          parent(parent) {};
+          parent(parent), channels(channels) {};
         bool isProcessed() const;
         bool isFinished() const;
         void setData(std::vector<float> audioData, int N);
+        /**
+         * @brief Set the data with a channel count
+         * @details A change of channel count is checked against every connected input,
+         * and throws rather than letting an input read planes that are not there
+         * @param audioData The planar data
+         * @param N The block size
+         * @param numChannels The number of channels
+         */
+        void setData(std::vector<float> audioData, int N, int numChannels);
         const std::vector<float>& getData() const;
         const int getBlockSize() const;
+        const int getChannels() const;
+        const float* getChannel(int channel) const;
         void connect(dibiff::graph::AudioInput* inChannel);
         void disconnect(dibiff::graph::AudioInput* inChannel);
         void disconnect();
@@ -117,6 +188,12 @@ class dibiff::graph::MidiOutput : public dibiff::graph::AudioConnectionPoint {
         dibiff::graph::AudioObject* parent;
         std::vector<dibiff::graph::MidiInput*> connectedInputs = {};
         std::vector<std::vector<unsigned char>> data = {};
+        /**
+         * @brief Sample offsets of the messages
+         * @details The offset of each message within the block when the source is
+         * sample accurate, empty otherwise
+         */
+        std::vector<int> offsets = {};
         int blockSize;
         MidiOutput(dibiff::graph::AudioObject* parent, std::string name)
         : dibiff::graph::AudioConnectionPoint(name), 
@@ -124,7 +201,15 @@ class dibiff::graph::MidiOutput : public dibiff::graph::AudioConnectionPoint {
         bool isProcessed() const;
         bool isFinished() const;
         void setData(std::vector<std::vector<unsigned char>> midiData, int N);
+        /**
+         * @brief Set the data with the sample offset of each message
+         * @param midiData The messages, in time order
+         * @param N The block size
+         * @param messageOffsets The offset of each message within the block
+         */
+        void setData(std::vector<std::vector<unsigned char>> midiData, int N, std::vector<int> messageOffsets);
         const std::vector<std::vector<unsigned char>>& getData() const;
+        const std::vector<int>& getOffsets() const;
         const int getBlockSize() const;
         void connect(dibiff::graph::MidiInput* inChannel);
         void disconnect(dibiff::graph::MidiInput* inChannel);
@@ -155,16 +240,117 @@ class dibiff::graph::AudioObject {
         virtual ~AudioObject() {};
         void markProcessed(bool processed = true) { this->processed = processed; }
         bool isProcessed() const { return processed; }
+        /**
+         * @brief Check if the object is a sink
+         * @details Sinks are where pull evaluation starts: by default, any object
+         * without outputs, such as a graph sink, a file writer or a meter
+         * @return True if the object is a sink
+         */
+        virtual bool isSink() const { return _outputs.empty(); }
+        /**
+         * @brief Enable or disable the object
+         * @details A disabled sink does not pull its inputs, so in pull evaluation
+         * the nodes feeding only disabled sinks are not processed
+         * @param enabled Whether the object is enabled
+         */
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return enabled; }
+        /**
+         * @brief Bypass the object
+         * @details A bypassed object is not processed. The graph aliases each audio
+         * output to the audio input at the same index, so downstream objects read the
+         * input directly, and silences outputs without a matching input. Toggling the
+         * bypass crossfades between the processed and the dry signal, processing the
+         * object until the crossfade ends. Safe to call from any thread while the graph
+         * ticks: the request is picked up at the start of the object's next block.
+         * @param bypassed Whether the object is bypassed
+         */
+        void setBypassed(bool bypassed) { bypassRequest.store(bypassed, std::memory_order_release); }
+        /**
+         * @brief Check if the object is bypassed
+         * @return The bypass last requested, which may not have reached the audio yet
+         */
+        bool isBypassed() const { return bypassRequest.load(std::memory_order_acquire); }
+        /**
+         * @brief Set the length of the crossfade when toggling the bypass
+         * @details Safe to call from any thread; takes effect at the object's next block
+         * @param samples The crossfade length in samples, 0 to switch at once
+         */
+        void setBypassCrossfade(int samples) {
+            if (samples < 0) {
+                throw std::runtime_error("Bypass crossfade must not be negative.");
+            }
+            bypassCrossfadeRequest.store(samples, std::memory_order_release);
+        }
+        int getBypassCrossfade() const { return bypassCrossfadeRequest.load(std::memory_order_acquire); }
+        /**
+         * @brief Keep processing while bypassed
+         * @details The output is still replaced by the input, but filters, delay lines
+         * and reverb tails stay current, so the object resumes without a jump
+         * @param keep Whether to keep processing
+         */
+        void setBypassKeepsState(bool keep) { bypassKeepsState.store(keep, std::memory_order_release); }
+        bool getBypassKeepsState() const { return bypassKeepsState.load(std::memory_order_acquire); }
+        /**
+         * @brief Set the rate divisor
+         * @details A node with a rate divisor of D runs at 1/D of the graph's sample
+         * rate. It is still processed every tick, but on blocks of blockSize / D
+         * samples, and the graph decimates and interpolates the signals crossing into
+         * and out of it. The object is given the divided block size by
+         * AudioGraph::setBlockSize, or here if it is in a graph whose block size has
+         * been set, so sources produce reduced-rate blocks too. Suited to control
+         * signals such as envelopes, LFOs, gain estimates and meters. Parameters given
+         * in samples or a sample rate must be set for the reduced rate. The divisors of
+         * connected objects must divide one another, and the graph's block size must be
+         * a multiple of the divisor; this throws if they do not.
+         * @param divisor The rate divisor, 1 for full rate
+         */
+        void setRateDivisor(int divisor);
+        int getRateDivisor() const { return rateDivisor; }
+        /**
+         * @brief Get the state memory of the object
+         * @details The number of input samples after which the output no longer depends
+         * on anything that came before, such as a delay length, a reverb tail or a filter's
+         * settling time. Used to pre-roll chunks of a parallel offline render, which is
+         * only done when every object's memory is known, so objects must override this to
+         * claim a bound; stateless objects return 0.
+         * @return The state memory in samples, or -1 if it is unknown or the state depends
+         * on the whole history, such as an oscillator's phase
+         */
+        virtual long getStateMemory() const { return -1; }
+        /**
+         * @brief Save the runtime state of the object
+         * @details Captures what the object has learned or buffered, such as adaptive
+         * filter taps, envelopes and delay lines, so a replacement object can start warm
+         * @return A versioned binary blob, or an empty blob if the object has no runtime state
+         */
+        virtual std::vector<unsigned char> saveState() const { return {}; }
+        /**
+         * @brief Restore the runtime state of the object
+         * @details The object must be configured the same way as the one that saved the
+         * state. Throws if the blob does not match, leaving the object unchanged.
+         * @param state A blob returned by saveState()
+         */
+        virtual void restoreState(const std::vector<unsigned char>& state) {}
+        /**
+         * @brief Set the block size
+         * @details Overridden by objects that produce blocks on their own, such as
+         * generators and sources, and by objects holding buffers sized by the block.
+         * Objects that follow the block size of their inputs need nothing. Only buffers
+         * are resized; coefficients and runtime state are kept. Called between ticks.
+         * @param blockSize The new block size
+         */
+        virtual void setBlockSize(int blockSize) {}
         void disconnectAll() {
             for (auto& input : _inputs) {
                 if (input) {
-                    if (auto i = static_cast<dibiff::graph::AudioInput*>(input.get())) {
+                    if (auto i = dynamic_cast<dibiff::graph::AudioInput*>(input.get())) {
                         if (i->isConnected()) {
                             if (auto& ii = i->connectedOutput) {
                                 ii->disconnect(i);
                             }
                         }
-                    } else if (auto mi = static_cast<dibiff::graph::MidiInput*>(input.get())) {
+                    } else if (auto mi = dynamic_cast<dibiff::graph::MidiInput*>(input.get())) {
                         if (mi->isConnected()) {
                             if (auto& mmi = mi->connectedOutput) {
                                 mmi->disconnect(mi);
@@ -175,28 +361,33 @@ class dibiff::graph::AudioObject {
             }
             for (auto& output : _outputs) {
                 if (output) {
-                    if (auto o = static_cast<dibiff::graph::AudioOutput*>(output.get())) {
-                        if (!o->connectedInputs.empty()) {
-                            for (auto& input : o->connectedInputs) {
-                                if (input) {
-                                    o->disconnect(input);
-                                }
-                            }
-                        }
-                    } else if (auto mo = static_cast<dibiff::graph::MidiOutput*>(output.get())) {
-                        if (!mo->connectedInputs.empty()) {
-                            for (auto& input : mo->connectedInputs) {
-                                if (input) {
-                                    mo->disconnect(input);
-                                }
-                            }
-                        }
+                    if (auto o = dynamic_cast<dibiff::graph::AudioOutput*>(output.get())) {
+                        o->disconnect();
+                    } else if (auto mo = dynamic_cast<dibiff::graph::MidiOutput*>(output.get())) {
+                        mo->disconnect();
                     }
                 }
             }
         }
     protected:
         bool processed = false;
+        bool enabled = true;
+        int rateDivisor = 1;
+    private:
+        friend class dibiff::graph::AudioGraph;
+        /// The graph the object was added to, if any
+        dibiff::graph::AudioGraph* owner = nullptr;
+        /// Written by the control thread, read by the graph at the start of each block
+        std::atomic<bool> bypassRequest{false};
+        std::atomic<int> bypassCrossfadeRequest{0};
+        std::atomic<bool> bypassKeepsState{false};
+        /// The bypass state of the current block, only touched by the graph while it ticks
+        bool bypassed = false;
+        /// Whether the graph has aliased the outputs
+        bool bypassAliased = false;
+        int bypassCrossfade = 0;
+        /// The samples left in the current crossfade
+        int bypassFade = 0;
 };
 /**
  * @brief Audio Composite Object
@@ -209,6 +400,15 @@ class dibiff::graph::AudioCompositeObject {
         virtual dibiff::graph::AudioConnectionPoint* getReference() = 0;
         virtual void initialize() = 0;
         virtual std::string getName() const = 0;
+        /**
+         * @brief Set the rate divisor of every object in the composite
+         * @param divisor The rate divisor, 1 for full rate
+         */
+        void setRateDivisor(int divisor) {
+            for (auto& o : objects) {
+                o->setRateDivisor(divisor);
+            }
+        }
         std::vector<std::unique_ptr<dibiff::graph::AudioObject>> objects;
 };
 /**
@@ -219,12 +419,161 @@ class dibiff::graph::AudioCompositeObject {
  */
 class dibiff::graph::AudioGraph {
     public:
-        AudioGraph() {}
-        ~AudioGraph() {}
+        enum class Evaluation {
+            /// Process every object in the graph
+            Push,
+            /// Process only the objects upstream of an enabled sink
+            Pull
+        };
+        AudioGraph();
+        ~AudioGraph();
+        AudioGraph(const AudioGraph&) = delete;
+        AudioGraph& operator=(const AudioGraph&) = delete;
+        /**
+         * @brief Construct a node in the graph
+         * @details Constructs and initializes a node in the graph's arena, so
+         * nodes created one after another are laid out contiguously in the
+         * order they are scheduled. The graph owns the node.
+         * @param args The arguments forwarded to the node's constructor
+         * @return A handle to the node
+         */
+        template<typename T, typename... Args>
+        dibiff::graph::NodeHandle<T> emplace(Args&&... args);
+        /**
+         * @brief Add a node to the graph
+         * @details Takes ownership of a node created with its create() function
+         * @param obj The node to add
+         * @return A handle to the node
+         */
+        template<typename T>
+        dibiff::graph::NodeHandle<T> add(std::unique_ptr<T> obj);
+        /**
+         * @brief Reserve memory for a number of nodes
+         * @details Makes room in the arena and the node tables up front, so the
+         * nodes placed next are laid out in one chunk without further allocation
+         * @param bytes The total size of the nodes, including alignment padding
+         * @param count The number of nodes
+         */
+        void reserve(std::size_t bytes, std::size_t count);
+        /**
+         * @brief Place a node in the graph without initializing it
+         * @details For loaders that construct many nodes first and initialize them
+         * together. The caller must initialize the node before the graph ticks.
+         * @param size The size of the node
+         * @param alignment The alignment of the node
+         * @param construct Constructs the node at the given address
+         * @return A handle to the node
+         */
+        dibiff::graph::NodeHandle<dibiff::graph::AudioObject> place(std::size_t size, std::size_t alignment, const std::function<dibiff::graph::AudioObject*(void*)>& construct);
+        /**
+         * @brief Add a node to the graph without taking ownership
+         * @details The caller must keep the node alive for as long as the graph uses it
+         */
         dibiff::graph::AudioObject* add(dibiff::graph::AudioObject* obj);
         dibiff::graph::AudioCompositeObject* add(dibiff::graph::AudioCompositeObject* obj);
         void remove(dibiff::graph::AudioObject* obj);
         void remove(dibiff::graph::AudioCompositeObject* obj);
+        /**
+         * @brief Remove and destroy a node owned by the graph
+         * @param handle The handle of the node to remove
+         */
+        template<typename T>
+        void remove(dibiff::graph::NodeHandle<T> handle);
+        /**
+         * @brief Get a node owned by the graph
+         * @param index The slot index of the node
+         * @return The node, or nullptr if it has been removed
+         */
+        dibiff::graph::AudioObject* node(std::size_t index) const;
+        /**
+         * @brief Get the state memory of the graph
+         * @details Sums the state memory of every object, which bounds the memory of
+         * any path through the graph
+         * @return The state memory in samples, or -1 if any object has unbounded memory
+         */
+        long getStateMemory() const;
+        /**
+         * @brief Reset every object in the graph
+         */
+        void reset();
+        /**
+         * @brief Save the runtime state of every object in the graph
+         * @return A blob holding each object's name and state, in graph order
+         */
+        std::vector<unsigned char> saveState() const;
+        /**
+         * @brief Restore the runtime state of every object in the graph
+         * @details The graph must have been built the same way as the one that saved the state
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state);
+        /**
+         * @brief Set the runtime options of the graph
+         * @details Applies the process-wide options and the per-thread options to the
+         * calling thread, which should be the thread that ticks the graph. If the graph is
+         * ticked from another thread, the per-thread options are applied to it once, on its
+         * first tick, and a refusal is logged. The worker threads of a tick inherit the
+         * scheduling and affinity of the ticking thread, and locked memory covers their
+         * stacks. Set the options before building the graph, so locked memory covers the
+         * buffers the nodes allocate. Throws if the system refuses an option.
+         * @param options The runtime options
+         */
+        void setRuntimeOptions(const dibiff::graph::RuntimeOptions& options);
+        const dibiff::graph::RuntimeOptions& getRuntimeOptions() const { return runtimeOptions; }
+        /**
+         * @brief Change the block size of the graph
+         * @details Passes the block size to every object, so a running graph can switch
+         * between small blocks for low latency and large blocks for throughput without
+         * being rebuilt. Call it from the control thread between ticks; the buffers are
+         * resized here rather than on the next tick. An object with a rate divisor of D
+         * is given blockSize / D. Throws if the block size is not a multiple of every
+         * rate divisor in the graph.
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize);
+        /**
+         * @brief Get the block size of the graph
+         * @return The block size last set with setBlockSize(), or 0 if it was never set
+         */
+        int getBlockSize() const { return blockSize; }
+        /**
+         * @brief Set the evaluation mode
+         * @details In pull evaluation the graph compiles a schedule of the objects that
+         * an enabled sink depends on, and skips everything else: dangling branches,
+         * disconnected nodes and the inputs of disabled sinks cost nothing. The schedule
+         * is recompiled as soon as a connection, node or sink changes, so a tick never
+         * compiles it; make such changes between ticks.
+         * @param evaluation The evaluation mode
+         */
+        void setEvaluation(Evaluation evaluation);
+        /**
+         * @brief Monitor the health of an output
+         * @details The output is checked once per block after its node has processed.
+         * Replaces any monitor already on the output.
+         * @param port The output to monitor
+         * @param options The thresholds and the action taken on unhealthy blocks
+         * @return The monitor, owned by the graph
+         */
+        dibiff::graph::HealthMonitor* monitor(dibiff::graph::AudioOutput* port, const dibiff::graph::HealthOptions& options);
+        dibiff::graph::HealthMonitor* monitor(dibiff::graph::AudioOutput* port);
+        /**
+         * @brief Stop monitoring an output
+         * @param port The monitored output
+         */
+        void unmonitor(dibiff::graph::AudioOutput* port);
+        Evaluation getEvaluation() const { return evaluation; }
+        /**
+         * @brief Get the objects processed each tick
+         * @return Every object in push evaluation, or the compiled schedule in pull evaluation
+         */
+        const std::vector<dibiff::graph::AudioObject*>& getSchedule();
+        /**
+         * @brief Recompile the schedule of the graph an object belongs to
+         * @details Called whenever a connection is made or broken or a sink is toggled.
+         * Other graphs are left alone.
+         * @param obj The object whose connections or state changed
+         */
+        static void topologyChanged(dibiff::graph::AudioObject* obj);
         void tick();
         static void connect(dibiff::graph::AudioOutput* outChannel, dibiff::graph::AudioInput* inChannel);
         static void connect(dibiff::graph::AudioInput* inChannel, dibiff::graph::AudioOutput* outChannel);
@@ -234,4 +583,92 @@ class dibiff::graph::AudioGraph {
         static void disconnect(dibiff::graph::AudioConnectionPoint* pt1, dibiff::graph::AudioConnectionPoint* pt2);
     private:
         std::vector<dibiff::graph::AudioObject*> objects;
-};
\ No newline at end of file
+        /// Owned nodes, indexed by handle; arena nodes are destroyed in place
+        std::vector<dibiff::graph::AudioObject*> nodes;
+        std::vector<bool> inArena;
+        dibiff::util::Arena arena;
+        dibiff::graph::RuntimeOptions runtimeOptions;
+        int blockSize = 0;
+        /// The thread the per-thread options were last applied to
+        std::thread::id optionsThread;
+        Evaluation evaluation = Evaluation::Push;
+        /// The objects upstream of an enabled sink, in graph order
+        std::vector<dibiff::graph::AudioObject*> schedule;
+        std::vector<std::unique_ptr<dibiff::graph::HealthMonitor>> monitors;
+        void checkHealth(dibiff::graph::AudioObject* obj);
+        void compileSchedule();
+        /**
+         * @brief Add an object to the list of objects processed
+         * @param obj The object
+         */
+        void enlist(dibiff::graph::AudioObject* obj);
+        /// Destroys a node constructed in the arena without freeing its memory
+        struct InPlace {
+            template<typename T>
+            void operator()(T* obj) const { obj->~T(); }
+        };
+        /**
+         * @brief Make room to register one more node
+         * @details Grows the node tables ahead of a registration, so registering a
+         * node that is already constructed cannot throw and leave it half-registered
+         */
+        void makeRoom();
+        std::size_t track(dibiff::graph::AudioObject* obj, bool arenaAllocated);
+        static void adaptInputs(dibiff::graph::AudioObject* obj);
+        static void silence(dibiff::graph::AudioObject* obj);
+        static void processBypassed(dibiff::graph::AudioObject* obj);
+        /**
+         * @brief Pick up the bypass requested for an object
+         * @param obj The object about to be processed
+         */
+        static void applyBypass(dibiff::graph::AudioObject* obj);
+        void destroy(std::size_t index);
+};
+/**
+ * @brief Node Handle
+ * @details A typed, stable handle to a node owned by an audio graph. Handles stay
+ * valid while the graph is alive; a handle to a removed node resolves to nullptr.
+ */
+template<typename T>
+class dibiff::graph::NodeHandle {
+    public:
+        NodeHandle() = default;
+        NodeHandle(dibiff::graph::AudioGraph* graph, std::size_t index)
+        : graph(graph), index(index) {};
+        T* get() const { return graph ? static_cast<T*>(graph->node(index)) : nullptr; }
+        T* operator->() const { return get(); }
+        T& operator*() const { return *get(); }
+        explicit operator bool() const { return get() != nullptr; }
+        std::size_t getIndex() const { return index; }
+    private:
+        dibiff::graph::AudioGraph* graph = nullptr;
+        std::size_t index = 0;
+};
+
+template<typename T, typename... Args>
+dibiff::graph::NodeHandle<T> dibiff::graph::AudioGraph::emplace(Args&&... args) {
+    static_assert(std::is_base_of<dibiff::graph::AudioObject, T>::value, "Nodes must derive from AudioObject");
+    /// The node is destroyed in place if initialize() throws, and only registered once it has succeeded
+    std::unique_ptr<T, InPlace> obj(new (arena.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...));
+    obj->initialize();
+    makeRoom();
+    enlist(obj.get());
+    return dibiff::graph::NodeHandle<T>(this, track(obj.release(), true));
+}
+
+template<typename T>
+dibiff::graph::NodeHandle<T> dibiff::graph::AudioGraph::add(std::unique_ptr<T> obj) {
+    static_assert(std::is_base_of<dibiff::graph::AudioObject, T>::value, "Nodes must derive from AudioObject");
+    makeRoom();
+    T* raw = obj.release();
+    enlist(raw);
+    return dibiff::graph::NodeHandle<T>(this, track(raw, false));
+}
+
+template<typename T>
+void dibiff::graph::AudioGraph::remove(dibiff::graph::NodeHandle<T> handle) {
+    if (auto obj = handle.get()) {
+        remove(static_cast<dibiff::graph::AudioObject*>(obj));
+        destroy(handle.getIndex());
+    }
+}
\ No newline at end of file
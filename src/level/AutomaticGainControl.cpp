@@ -1,7 +1,6 @@
 /// AutomaticGainControl.cpp
 
 #include "AutomaticGainControl.h"
-#include "../inc/Eigen/Dense"
 
 /**
  * @brief Constructor
@@ -43,7 +42,7 @@ float dibiff::level::AutomaticGainControl::process(float sample) {
     rmsLevel = rmsCoefficient * rmsLevel + (1.0f - rmsCoefficient) * inputLevel * inputLevel;
     float rmsValue = std::sqrt(rmsLevel);
     // Gain adjustment
-    float desiredGain = targetLevelLinear / (rmsValue + 1e-6f); // Avoid division by zero
+    float desiredGain = this->desiredGain(rmsValue);
     if (desiredGain < currentGain) {
         currentGain = attackCoefficient * currentGain + (1.0f - attackCoefficient) * desiredGain;
     } else {
@@ -65,6 +64,22 @@ void dibiff::level::AutomaticGainControl::process() {
     } else if (input->isReady()) {
         const std::vector<float>& data = input->getData();
         const int blockSize = input->getBlockSize();
+        if (mode == Mode::Block) {
+            /// The window follows the time constant of the one-pole average
+            const int window = static_cast<int>(std::lround(1.0f / std::max(1.0f - rmsCoefficient, 1.0e-6f)));
+            if (window != static_cast<int>(squares.size())) {
+                squares.assign(window, 0.0f);
+                position = 0;
+                sum = 0.0;
+            }
+            std::vector<float> out(blockSize);
+            for (int i = 0; i < blockSize; i += subBlockSize) {
+                processSubBlock(data.data() + i, out.data() + i, std::min(subBlockSize, blockSize - i));
+            }
+            output->setData(std::move(out), blockSize);
+            markProcessed();
+            return;
+        }
         Eigen::VectorXf x(blockSize), y(blockSize);
         for (int i = 0; i < blockSize; ++i) {
             x(i) = data[i];
@@ -80,6 +95,87 @@ void dibiff::level::AutomaticGainControl::process() {
         markProcessed();
     }
 }
+/**
+ * @brief Process a sub-block in block mode
+ * @details The squares of the sub-block replace the oldest squares of the window and
+ * the running sum is updated by the difference, then summed afresh whenever the ring
+ * wraps so rounding errors cannot build up. The gain moves towards the desired gain as
+ * the per-sample one-pole would over the sub-block, and is ramped linearly from its
+ * previous value so the gain changes without steps.
+ * @param in The input samples
+ * @param out The output samples
+ * @param n The number of samples, at most the sub-block size
+ */
+void dibiff::level::AutomaticGainControl::processSubBlock(const float* in, float* out, int n) {
+    const int window = static_cast<int>(squares.size());
+    for (int done = 0; done < n;) {
+        const int m = std::min(n - done, window - position);
+        Eigen::Map<Eigen::ArrayXf> oldest(squares.data() + position, m);
+        sum -= oldest.sum();
+        oldest = Eigen::Map<const Eigen::ArrayXf>(in + done, m).square();
+        sum += oldest.sum();
+        position += m;
+        done += m;
+        if (position == window) {
+            position = 0;
+            sum = Eigen::Map<const Eigen::ArrayXf>(squares.data(), window).cast<double>().sum();
+        }
+    }
+    const float rms = std::sqrt(static_cast<float>(std::max(sum, 0.0) / window));
+    const float desired = desiredGain(rms);
+    const float coefficient = std::pow(desired < currentGain ? attackCoefficient : releaseCoefficient, static_cast<float>(n));
+    const float next = coefficient * currentGain + (1.0f - coefficient) * desired;
+    const float step = (next - currentGain) / n;
+    Eigen::Map<Eigen::ArrayXf>(out, n) = Eigen::Map<const Eigen::ArrayXf>(in, n) * (currentGain + step * ramp.head(n));
+    currentGain = next;
+}
+/**
+ * @brief Decide the gain for a level
+ * @details Below the noise floor the gain is held, so it is not raised in silence
+ * @param rms The RMS level of the input
+ * @return The gain to move towards
+ */
+float dibiff::level::AutomaticGainControl::desiredGain(float rms) const {
+    if (rms < noiseFloorLinear) {
+        return currentGain;
+    }
+    return std::min(targetLevelLinear / (rms + 1e-6f), maximumGainLinear); // Avoid division by zero
+}
+/**
+ * @brief Set how the gain is computed
+ * @details The level is measured afresh in the new mode, while the gain carries over
+ * @param mode The mode
+ */
+void dibiff::level::AutomaticGainControl::setMode(Mode mode) {
+    this->mode = mode;
+    rmsLevel = 0.0f;
+    squares.clear();
+}
+/**
+ * @brief Set the sub-block size of block mode
+ * @param samples The number of samples between gain decisions
+ */
+void dibiff::level::AutomaticGainControl::setSubBlockSize(int samples) {
+    if (samples < 1) {
+        throw std::runtime_error("AGC sub-block size must be at least one sample.");
+    }
+    subBlockSize = samples;
+    ramp = Eigen::ArrayXf::LinSpaced(samples, 1.0f, static_cast<float>(samples));
+}
+/**
+ * @brief Set the noise floor
+ * @param level The RMS level in dB below which the gain is held
+ */
+void dibiff::level::AutomaticGainControl::setNoiseFloor(float level) {
+    noiseFloorLinear = std::pow(10.0f, level / 20.0f);
+}
+/**
+ * @brief Set the maximum gain
+ * @param gain The maximum gain in dB
+ */
+void dibiff::level::AutomaticGainControl::setMaximumGain(float gain) {
+    maximumGainLinear = std::pow(10.0f, gain / 20.0f);
+}
 /**
  * @brief Reset the AGC
  * @details Resets the AGC to the default state
@@ -87,6 +183,9 @@ void dibiff::level::AutomaticGainControl::process() {
 void dibiff::level::AutomaticGainControl::reset() {
     currentGain = 1.0f;
     rmsLevel = 0.0f;
+    std::fill(squares.begin(), squares.end(), 0.0f);
+    position = 0;
+    sum = 0.0;
 }
 /**
  * @brief Check if the AGC is finished processing
@@ -4,12 +4,19 @@
 
 #include "level.h"
 #include "../graph/graph.h"
+#include "../inc/Eigen/Dense"
 
 /**
  * @brief Automatic Gain Control
  * @details An automatic gain control (AGC) object is a simple object that adjusts
  * the gain of an audio signal to a certain target level. The AGC has attack and
  * release times, as well as a coefficient for RMS level calculation.
+ * Gain is not raised while the input is below a noise floor, and never above a
+ * maximum gain, so silence and hiss between phrases are not pumped up.
+ * In block mode the level is the RMS over a rectangular window kept as a running sum
+ * of squares, and the gain is decided once per sub-block and ramped linearly across
+ * it, which replaces the square root, division and branches of every sample with a
+ * few vector operations.
  * @param targetLevel The target output level in dB
  * @param sampleRate The sample rate of the input signal
  * @param attack The attack time of the AGC in seconds, default value is 0.01
@@ -18,6 +25,15 @@
  */
 class dibiff::level::AutomaticGainControl : public dibiff::graph::AudioObject {
     public:
+        /**
+         * @brief How the gain is computed
+         */
+        enum class Mode {
+            /// A one-pole RMS and gain update at every sample
+            Sample,
+            /// A windowed RMS and gain update at every sub-block, with a gain ramp between
+            Block
+        };
         dibiff::graph::AudioInput* input;
         dibiff::graph::AudioOutput* output;
         /**
@@ -56,6 +72,31 @@ class dibiff::level::AutomaticGainControl : public dibiff::graph::AudioObject {
          * @details Not used
          */
         void clear() override {}
+        /**
+         * @brief Set how the gain is computed
+         * @param mode The mode
+         */
+        void setMode(Mode mode);
+        /**
+         * @brief Get how the gain is computed
+         * @return The mode
+         */
+        Mode getMode() const { return mode; }
+        /**
+         * @brief Set the sub-block size of block mode
+         * @param samples The number of samples between gain decisions, 64 by default
+         */
+        void setSubBlockSize(int samples);
+        /**
+         * @brief Set the noise floor
+         * @param level The RMS level in dB below which the gain is held, -60 dB by default
+         */
+        void setNoiseFloor(float level);
+        /**
+         * @brief Set the maximum gain
+         * @param gain The maximum gain in dB, 30 dB by default
+         */
+        void setMaximumGain(float gain);
         /**
          * @brief Check if the AGC is finished processing
          * @return True if the AGC is finished processing, false otherwise
@@ -86,4 +127,28 @@ class dibiff::level::AutomaticGainControl : public dibiff::graph::AudioObject {
         float targetLevelLinear;
         float currentGain = 1.0f;
         float rmsLevel = 0.0f;
+        Mode mode = Mode::Sample;
+        int subBlockSize = 64;
+        float noiseFloorLinear = 0.001f;
+        float maximumGainLinear = 31.622776f;
+        /// 1, 2, ..., the sub-block size, the steps of the gain ramp
+        Eigen::ArrayXf ramp = Eigen::ArrayXf::LinSpaced(64, 1.0f, 64.0f);
+        /// The squares of the last samples in block mode, a ring of one window
+        std::vector<float> squares;
+        int position = 0;
+        /// The sum of the squares in the window
+        double sum = 0.0;
+        /**
+         * @brief Decide the gain for a level
+         * @param rms The RMS level of the input
+         * @return The gain to move towards
+         */
+        float desiredGain(float rms) const;
+        /**
+         * @brief Process a sub-block in block mode
+         * @param in The input samples
+         * @param out The output samples
+         * @param n The number of samples, at most the sub-block size
+         */
+        void processSubBlock(const float* in, float* out, int n);
 };
\ No newline at end of file
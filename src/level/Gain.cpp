@@ -17,7 +17,7 @@ dibiff::level::Gain::Gain(float& value)
  * @details Initializes the gain connection points
  */
 void dibiff::level::Gain::initialize() {
-    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "GainInput"));
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "GainInput", 0));
     _inputs.emplace_back(std::move(i));
     input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
     auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "GainOutput"));
@@ -32,13 +32,20 @@ void dibiff::level::Gain::initialize() {
 float dibiff::level::Gain::process(float sample) {
     return sample * _value;
 }
+/**
+ * @brief Prepare a block
+ * @details Updates the linear gain from the gain in dB
+ */
+void dibiff::level::Gain::prepare() {
+    _value = std::pow(10.0f, _valuedB / 20.0f);
+}
 /**
  * @brief Process a block of samples
- * @details Processes a block of audio data
+ * @details Processes a block of audio data, scaling every channel of
+ * the input in one pass
  */
 void dibiff::level::Gain::process() {
-    /// Update value
-    _value = std::pow(10.0f, _valuedB / 20.0f);
+    prepare();
     if (!input->isConnected()) {
         /// If no input is connected, just dump zeros into the output
         std::vector<float> out(input->getBlockSize(), 0.0f);
@@ -47,18 +54,12 @@ void dibiff::level::Gain::process() {
     } else if (input->isReady()) {
         const std::vector<float>& audioData = input->getData();
         const int blockSize = input->getBlockSize();
-        Eigen::VectorXf x(blockSize), y(blockSize);
-        for (int i = 0; i < blockSize; ++i) {
-            x(i) = audioData[i];
-        }
-        for (int i = 0; i < blockSize; ++i) {
-            y(i) = process(x(i));
-        }
-        std::vector<float> out(blockSize);
-        for (int i = 0; i < blockSize; ++i) {
-            out[i] = y(i);
-        }
-        output->setData(out, blockSize);
+        const int channels = input->connectedOutput->getChannels();
+        /// All channel planes are contiguous, so scale them in one pass
+        const int N = blockSize * channels;
+        std::vector<float> out(N);
+        Eigen::Map<Eigen::VectorXf>(out.data(), N) = Eigen::Map<const Eigen::VectorXf>(audioData.data(), N) * _value;
+        output->setData(std::move(out), blockSize, channels);
         markProcessed();
     }
 }
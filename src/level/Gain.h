@@ -33,9 +33,15 @@ class dibiff::level::Gain : public dibiff::graph::AudioObject {
          * @param sample The input sample
          */
         float process(float sample);
+        /**
+         * @brief Prepare a block
+         * @details Updates the linear gain from the gain in dB
+         */
+        void prepare();
         /**
          * @brief Process a block of samples
-         * @details Processes a block of audio data
+         * @details Processes a block of audio data, scaling every channel of
+         * the input in one pass
          */
         void process() override;
         /**
@@ -58,6 +64,11 @@ class dibiff::level::Gain : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the gain
+         * @return The gain holds no state, so 0
+         */
+        long getStateMemory() const override { return 0; }
         /**
          * Create a new gain object
          * @param value The gain of the object in dB
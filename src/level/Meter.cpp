@@ -0,0 +1,171 @@
+/// Meter.cpp
+
+#include "Meter.h"
+#include "../inc/Eigen/Dense"
+
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Constructor
+ * @details Initializes the meter and designs the K-weighting filters of ITU-R BS.1770
+ * for the given sample rate: a high shelf modelling the head, followed by the RLB highpass
+ * @param sampleRate The sample rate of the input signal
+ * @param peakDecay The fall rate of the peak reading in dB per second
+ */
+dibiff::level::Meter::Meter(float sampleRate, float peakDecay)
+: dibiff::graph::AudioObject(), sampleRate(sampleRate), peakDecay(peakDecay),
+  segments(30, 0.0), segmentLength(static_cast<int>(std::round(0.1f * sampleRate))) {
+    name = "Meter";
+    double K = std::tan(M_PI * 1681.974450955533 / sampleRate);
+    double Q = 0.7071752369554196;
+    const double Vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    const double Vb = std::pow(Vh, 0.4996667741545416);
+    double a0 = 1.0 + K / Q + K * K;
+    shelf = {(Vh + Vb * K / Q + K * K) / a0, 2.0 * (K * K - Vh) / a0, (Vh - Vb * K / Q + K * K) / a0,
+             2.0 * (K * K - 1.0) / a0, (1.0 - K / Q + K * K) / a0};
+    K = std::tan(M_PI * 38.13547087602444 / sampleRate);
+    Q = 0.5003270373238773;
+    a0 = 1.0 + K / Q + K * K;
+    highpass = {1.0, -2.0, 1.0, 2.0 * (K * K - 1.0) / a0, (1.0 - K / Q + K * K) / a0};
+};
+/**
+ * @brief Initialize
+ * @details Initializes the meter connection points
+ */
+void dibiff::level::Meter::initialize() {
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "MeterInput", 0));
+    _inputs.emplace_back(std::move(i));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+}
+/**
+ * @brief Process a block of samples
+ * @details Measures a block of audio data and publishes the readings. Peak and mean
+ * square are vectorized reductions over each channel; the K-weighted energy is summed
+ * into 100 ms segments, from which the loudness windows are formed.
+ */
+void dibiff::level::Meter::process() {
+    if (input->isConnected() && input->isReady()) {
+        const int blockSize = input->getBlockSize();
+        const int channels = std::min(input->getChannels(), maxChannels);
+        if (static_cast<int>(peak.size()) != channels) {
+            state.assign(2 * channels, State());
+            peak.assign(channels, 0.0f);
+            meanSquare.assign(channels, 0.0f);
+        }
+        const float peakFall = std::pow(10.0f, -peakDecay * blockSize / sampleRate / 20.0f);
+        const float rmsCoeff = std::exp(-blockSize / (0.3f * sampleRate));
+        weighted.assign(blockSize, 0.0f);
+        Eigen::Map<Eigen::ArrayXf> w(weighted.data(), blockSize);
+        for (int c = 0; c < channels; ++c) {
+            Eigen::Map<const Eigen::ArrayXf> x(input->getChannel(c), blockSize);
+            peak[c] = std::max(x.abs().maxCoeff(), peak[c] * peakFall);
+            meanSquare[c] = rmsCoeff * meanSquare[c] + (1.0f - rmsCoeff) * x.square().mean();
+            /// K-weight the channel and accumulate its energy
+            State& s1 = state[2 * c];
+            State& s2 = state[2 * c + 1];
+            for (int i = 0; i < blockSize; ++i) {
+                const double x0 = x(i);
+                const double y1 = shelf.b0 * x0 + shelf.b1 * s1.x1 + shelf.b2 * s1.x2 - shelf.a1 * s1.y1 - shelf.a2 * s1.y2;
+                s1.x2 = s1.x1; s1.x1 = x0; s1.y2 = s1.y1; s1.y1 = y1;
+                const double y2 = highpass.b0 * y1 + highpass.b1 * s2.x1 + highpass.b2 * s2.x2 - highpass.a1 * s2.y1 - highpass.a2 * s2.y2;
+                s2.x2 = s2.x1; s2.x1 = y1; s2.y2 = s2.y1; s2.y1 = y2;
+                w(i) += static_cast<float>(y2 * y2);
+            }
+        }
+        /// Split the block at 100 ms segment boundaries
+        for (int i = 0; i < blockSize;) {
+            const int take = std::min(segmentLength - segmentFill, blockSize - i);
+            segmentSum += w.segment(i, take).sum();
+            segmentFill += take;
+            i += take;
+            if (segmentFill == segmentLength) {
+                segments[segmentCount % segments.size()] = segmentSum / segmentLength;
+                segmentCount++;
+                segmentFill = 0;
+                segmentSum = 0.0;
+            }
+        }
+        Reading reading;
+        reading.channels = channels;
+        for (int c = 0; c < channels; ++c) {
+            reading.peak[c] = 20.0f * std::log10(peak[c]);
+            reading.rms[c] = 10.0f * std::log10(meanSquare[c]);
+        }
+        reading.momentary = static_cast<float>(loudness(4));
+        reading.shortTerm = static_cast<float>(loudness(30));
+        published.store(reading);
+    }
+    markProcessed();
+}
+/**
+ * @brief Loudness over the most recent segments
+ * @param numSegments The window length in 100 ms segments
+ * @return The loudness in LUFS, over the segments available so far
+ */
+double dibiff::level::Meter::loudness(int numSegments) const {
+    const long n = std::min(static_cast<long>(numSegments), segmentCount);
+    if (n == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    double sum = 0.0;
+    for (long k = 1; k <= n; ++k) {
+        sum += segments[(segmentCount - k) % segments.size()];
+    }
+    return -0.691 + 10.0 * std::log10(sum / n);
+}
+/**
+ * @brief Reset the meter
+ * @details Clears the filter state and the measurement windows
+ */
+void dibiff::level::Meter::reset() {
+    std::fill(state.begin(), state.end(), State());
+    std::fill(peak.begin(), peak.end(), 0.0f);
+    std::fill(meanSquare.begin(), meanSquare.end(), 0.0f);
+    std::fill(segments.begin(), segments.end(), 0.0);
+    segmentFill = 0;
+    segmentSum = 0.0;
+    segmentCount = 0;
+}
+/**
+ * @brief Check if the meter is finished processing
+ * @return True if the meter is finished processing, false otherwise
+ */
+bool dibiff::level::Meter::isFinished() const {
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
+}
+/**
+ * @brief Check if the meter is ready to process
+ * @return True if the meter is ready to process, false otherwise
+ */
+bool dibiff::level::Meter::isReadyToProcess() const {
+    if (!input->isConnected()) {
+        return !processed;
+    }
+    return input->isReady() && !processed;
+}
+/**
+ * @brief Attach the meter to an output port
+ * @param port The port to measure
+ */
+void dibiff::level::Meter::attach(dibiff::graph::AudioOutput* port) {
+    port->connect(input);
+}
+/**
+ * @brief Read the latest published levels
+ * @details Lock-free and safe to call from any thread
+ * @return The latest reading
+ */
+dibiff::level::Meter::Reading dibiff::level::Meter::read() const {
+    return published.load();
+}
+/**
+ * Create a new meter object
+ * @param sampleRate The sample rate of the input signal
+ * @param peakDecay The fall rate of the peak reading in dB per second
+ */
+std::unique_ptr<dibiff::level::Meter> dibiff::level::Meter::create(float sampleRate, float peakDecay) {
+    auto instance = std::make_unique<dibiff::level::Meter>(sampleRate, peakDecay);
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,120 @@
+/// Meter.h
+
+#pragma once
+
+#include "level.h"
+#include "../graph/graph.h"
+#include "../util/SeqLock.h"
+
+#include <vector>
+
+/**
+ * @brief Meter
+ * @details A meter is a tap that can be attached to any output port to measure its
+ * level without altering the signal. It computes a decaying peak, a 300 ms RMS and the
+ * EBU R128 momentary (400 ms) and short-term (3 s) loudness of the K-weighted signal.
+ * The readings are published once per block through a seqlock, so monitoring threads
+ * can poll read() at any rate without ever blocking the audio thread.
+ * All channels are weighted equally in the loudness sum, as for mono and stereo.
+ * @param sampleRate The sample rate of the input signal
+ * @param peakDecay The fall rate of the peak reading in dB per second
+ */
+class dibiff::level::Meter : public dibiff::graph::AudioObject {
+    public:
+        static constexpr int maxChannels = 8;
+        /**
+         * @brief Meter reading
+         * @details Levels are in dBFS and loudness in LUFS; silence reads as -infinity
+         */
+        struct Reading {
+            int channels = 0;
+            float peak[maxChannels] = {};
+            float rms[maxChannels] = {};
+            float momentary = 0.0f;
+            float shortTerm = 0.0f;
+        };
+        dibiff::graph::AudioInput* input;
+        /**
+         * @brief Constructor
+         * @details Initializes the meter and designs the K-weighting filters
+         * @param sampleRate The sample rate of the input signal
+         * @param peakDecay The fall rate of the peak reading in dB per second
+         */
+        Meter(float sampleRate, float peakDecay = 20.0f);
+        /**
+         * @brief Initialize
+         * @details Initializes the meter connection points
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Measures a block of audio data and publishes the readings
+         */
+        void process() override;
+        /**
+         * @brief Reset the meter
+         * @details Clears the filter state and the measurement windows
+         */
+        void reset() override;
+        /**
+         * @brief Clear the meter
+         * @details Not used
+         */
+        void clear() override {}
+        /**
+         * @brief Check if the meter is finished processing
+         * @return True if the meter is finished processing, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the meter is ready to process
+         * @return True if the meter is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the meter
+         * @return The meter has no audio output, so 0
+         */
+        long getStateMemory() const override { return 0; }
+        /**
+         * @brief Attach the meter to an output port
+         * @param port The port to measure
+         */
+        void attach(dibiff::graph::AudioOutput* port);
+        /**
+         * @brief Read the latest published levels
+         * @details Lock-free and safe to call from any thread
+         * @return The latest reading
+         */
+        Reading read() const;
+        /**
+         * Create a new meter object
+         * @param sampleRate The sample rate of the input signal
+         * @param peakDecay The fall rate of the peak reading in dB per second
+         */
+        static std::unique_ptr<Meter> create(float sampleRate, float peakDecay = 20.0f);
+    private:
+        struct Biquad {
+            double b0, b1, b2, a1, a2;
+        };
+        struct State {
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        };
+        float sampleRate;
+        float peakDecay;
+        Biquad shelf;
+        Biquad highpass;
+        /// K-weighting filter state, two sections per channel
+        std::vector<State> state;
+        std::vector<float> peak;
+        std::vector<float> meanSquare;
+        std::vector<float> weighted;
+        /// Mean squares of the K-weighted signal over consecutive 100 ms segments
+        std::vector<double> segments;
+        int segmentLength;
+        int segmentFill = 0;
+        double segmentSum = 0.0;
+        long segmentCount = 0;
+        dibiff::util::SeqLock<Reading> published;
+        double loudness(int numSegments) const;
+};
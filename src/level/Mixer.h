@@ -50,6 +50,11 @@ class dibiff::level::Mixer : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the mixer
+         * @return The mixer holds no state, so 0
+         */
+        long getStateMemory() const override { return 0; }
         /**
          * Create a new mixer object
          * @param value The mixer of the object in dB
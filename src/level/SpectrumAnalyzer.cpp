@@ -0,0 +1,148 @@
+/// SpectrumAnalyzer.cpp
+
+#include "SpectrumAnalyzer.h"
+#include "../inc/Eigen/Dense"
+
+#include <cmath>
+
+/**
+ * @brief Constructor
+ * @param sampleRate The sample rate of the input signal
+ * @param fftSize The transform size, a power of two
+ * @param interval The number of blocks between transforms
+ * @param smoothing The smoothing time constant of the magnitudes in seconds
+ */
+dibiff::level::SpectrumAnalyzer::SpectrumAnalyzer(float sampleRate, int fftSize, int interval, float smoothing)
+: dibiff::graph::AudioObject(), sampleRate(sampleRate), fftSize(fftSize), interval(std::max(1, interval)),
+  smoothing(smoothing), fft(fftSize) {
+    name = "SpectrumAnalyzer";
+};
+/**
+ * @brief Initialize
+ * @details Initializes the analyzer connection points and allocates every buffer up
+ * front, so processing never allocates
+ */
+void dibiff::level::SpectrumAnalyzer::initialize() {
+    auto i = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "SpectrumAnalyzerInput", 0));
+    _inputs.emplace_back(std::move(i));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+    window.resize(fftSize);
+    float sum = 0.0f;
+    for (int n = 0; n < fftSize; ++n) {
+        window[n] = 0.5f - 0.5f * std::cos(2.0f * static_cast<float>(M_PI) * n / fftSize);
+        sum += window[n];
+    }
+    /// Scale so a full-scale sine peaks at 0 dB
+    for (auto& w : window) {
+        w *= 2.0f / sum;
+    }
+    history.assign(fftSize, 0.0f);
+    frameBuffer.resize(fftSize);
+    spectrum.resize(fftSize / 2 + 1);
+    smoothed.assign(fftSize / 2 + 1, -120.0f);
+    Snapshot empty;
+    empty.magnitudes.assign(fftSize / 2 + 1, -120.0f);
+    published.fill(empty);
+}
+/**
+ * @brief Process a block of samples
+ * @details Adds a block to the history, and transforms and publishes a
+ * snapshot every interval blocks
+ */
+void dibiff::level::SpectrumAnalyzer::process() {
+    if (input->isConnected() && input->isReady()) {
+        const int blockSize = input->getBlockSize();
+        const int channels = input->getChannels();
+        for (int i = 0; i < blockSize; ++i) {
+            float sum = 0.0f;
+            for (int c = 0; c < channels; ++c) {
+                sum += input->getChannel(c)[i];
+            }
+            history[writeIndex] = sum / channels;
+            writeIndex = (writeIndex + 1) % fftSize;
+        }
+        if (++blockCount >= interval) {
+            blockCount = 0;
+            /// Unroll the history, oldest sample first, and window it
+            const int tail = fftSize - writeIndex;
+            std::copy(history.begin() + writeIndex, history.end(), frameBuffer.begin());
+            std::copy(history.begin(), history.begin() + writeIndex, frameBuffer.begin() + tail);
+            Eigen::Map<Eigen::ArrayXf> x(frameBuffer.data(), fftSize);
+            x *= Eigen::Map<const Eigen::ArrayXf>(window.data(), fftSize);
+            fft.forward(frameBuffer.data(), spectrum.data());
+            /// Smooth in dB, as one vectorized pass over the bins
+            const int bins = fftSize / 2 + 1;
+            const float elapsed = static_cast<float>(interval) * blockSize / sampleRate;
+            const float a = smoothing > 0.0f ? std::exp(-elapsed / smoothing) : 0.0f;
+            Eigen::Map<const Eigen::ArrayXcf> X(spectrum.data(), bins);
+            Eigen::Map<Eigen::ArrayXf> s(smoothed.data(), bins);
+            s = a * s + (1.0f - a) * (10.0f * (X.abs2() + 1e-12f).log10());
+            Snapshot& snapshot = published.back();
+            std::copy(smoothed.begin(), smoothed.end(), snapshot.magnitudes.begin());
+            snapshot.frame = ++frame;
+            published.publish();
+        }
+    }
+    markProcessed();
+}
+/**
+ * @brief Reset the analyzer
+ * @details Clears the history and the smoothed magnitudes
+ */
+void dibiff::level::SpectrumAnalyzer::reset() {
+    std::fill(history.begin(), history.end(), 0.0f);
+    std::fill(smoothed.begin(), smoothed.end(), -120.0f);
+    writeIndex = 0;
+    blockCount = 0;
+}
+/**
+ * @brief Check if the analyzer is finished processing
+ * @return True if the analyzer is finished processing, false otherwise
+ */
+bool dibiff::level::SpectrumAnalyzer::isFinished() const {
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
+}
+/**
+ * @brief Check if the analyzer is ready to process
+ * @return True if the analyzer is ready to process, false otherwise
+ */
+bool dibiff::level::SpectrumAnalyzer::isReadyToProcess() const {
+    if (!input->isConnected()) {
+        return !processed;
+    }
+    return input->isReady() && !processed;
+}
+/**
+ * @brief Attach the analyzer to an output port
+ * @param port The port to analyze
+ */
+void dibiff::level::SpectrumAnalyzer::attach(dibiff::graph::AudioOutput* port) {
+    port->connect(input);
+}
+/**
+ * @brief Read the latest snapshot
+ * @return The latest published snapshot
+ */
+const dibiff::level::SpectrumAnalyzer::Snapshot& dibiff::level::SpectrumAnalyzer::read() {
+    return published.read();
+}
+/**
+ * @brief Get the centre frequency of a bin
+ * @param bin The bin index
+ * @return The frequency in Hz
+ */
+float dibiff::level::SpectrumAnalyzer::getFrequency(int bin) const {
+    return bin * sampleRate / fftSize;
+}
+/**
+ * Create a new spectrum analyzer object
+ * @param sampleRate The sample rate of the input signal
+ * @param fftSize The transform size, a power of two
+ * @param interval The number of blocks between transforms
+ * @param smoothing The smoothing time constant of the magnitudes in seconds
+ */
+std::unique_ptr<dibiff::level::SpectrumAnalyzer> dibiff::level::SpectrumAnalyzer::create(float sampleRate, int fftSize, int interval, float smoothing) {
+    auto instance = std::make_unique<dibiff::level::SpectrumAnalyzer>(sampleRate, fftSize, interval, smoothing);
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,123 @@
+/// SpectrumAnalyzer.h
+
+#pragma once
+
+#include "level.h"
+#include "../graph/graph.h"
+#include "../util/FFT.h"
+#include "../util/TripleBuffer.h"
+
+#include <vector>
+
+/**
+ * @brief Spectrum Analyzer
+ * @details A spectrum analyzer is a tap that can be attached to any output port to
+ * publish live magnitude spectra without altering the signal. The channels are mixed
+ * to mono into a history of the last fftSize samples, and every `interval` blocks the
+ * history is Hann-windowed and transformed. Magnitudes are smoothed in dB and published
+ * through a triple buffer, so a monitoring thread reads a consistent snapshot without
+ * copying audio or taking locks. The cost on the audio thread is one FFT per interval,
+ * set by fftSize and interval.
+ * @param sampleRate The sample rate of the input signal
+ * @param fftSize The transform size, a power of two
+ * @param interval The number of blocks between transforms
+ * @param smoothing The smoothing time constant of the magnitudes in seconds
+ */
+class dibiff::level::SpectrumAnalyzer : public dibiff::graph::AudioObject {
+    public:
+        /**
+         * @brief Spectrum snapshot
+         * @details Magnitudes in dBFS for bins 0 to fftSize / 2; a full-scale sine reads 0 dB
+         */
+        struct Snapshot {
+            std::vector<float> magnitudes;
+            long frame = 0;
+        };
+        dibiff::graph::AudioInput* input;
+        /**
+         * @brief Constructor
+         * @param sampleRate The sample rate of the input signal
+         * @param fftSize The transform size, a power of two
+         * @param interval The number of blocks between transforms
+         * @param smoothing The smoothing time constant of the magnitudes in seconds
+         */
+        SpectrumAnalyzer(float sampleRate, int fftSize = 2048, int interval = 4, float smoothing = 0.1f);
+        /**
+         * @brief Initialize
+         * @details Initializes the analyzer connection points and buffers
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Adds a block to the history, and transforms and publishes a
+         * snapshot every interval blocks
+         */
+        void process() override;
+        /**
+         * @brief Reset the analyzer
+         * @details Clears the history and the smoothed magnitudes
+         */
+        void reset() override;
+        /**
+         * @brief Clear the analyzer
+         * @details Not used
+         */
+        void clear() override {}
+        /**
+         * @brief Check if the analyzer is finished processing
+         * @return True if the analyzer is finished processing, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the analyzer is ready to process
+         * @return True if the analyzer is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the spectrum analyzer
+         * @return The analyzer has no audio output, so 0
+         */
+        long getStateMemory() const override { return 0; }
+        /**
+         * @brief Attach the analyzer to an output port
+         * @param port The port to analyze
+         */
+        void attach(dibiff::graph::AudioOutput* port);
+        /**
+         * @brief Read the latest snapshot
+         * @details Wait-free, for a single monitoring thread. The reference stays valid
+         * until the next call.
+         * @return The latest published snapshot
+         */
+        const Snapshot& read();
+        /**
+         * @brief Get the centre frequency of a bin
+         * @param bin The bin index
+         * @return The frequency in Hz
+         */
+        float getFrequency(int bin) const;
+        /**
+         * Create a new spectrum analyzer object
+         * @param sampleRate The sample rate of the input signal
+         * @param fftSize The transform size, a power of two
+         * @param interval The number of blocks between transforms
+         * @param smoothing The smoothing time constant of the magnitudes in seconds
+         */
+        static std::unique_ptr<SpectrumAnalyzer> create(float sampleRate, int fftSize = 2048, int interval = 4, float smoothing = 0.1f);
+    private:
+        float sampleRate;
+        int fftSize;
+        int interval;
+        float smoothing;
+        dibiff::util::FFT fft;
+        std::vector<float> window;
+        /// Circular history of the mono mix
+        std::vector<float> history;
+        int writeIndex = 0;
+        int blockCount = 0;
+        long frame = 0;
+        std::vector<float> frameBuffer;
+        std::vector<dibiff::util::FFT::Complex> spectrum;
+        std::vector<float> smoothed;
+        dibiff::util::TripleBuffer<Snapshot> published;
+};
@@ -12,5 +12,7 @@ namespace dibiff {
         class Gain;
         class AutomaticGainControl;
         class Mixer;
+        class Meter;
+        class SpectrumAnalyzer;
     }
 }
\ No newline at end of file
@@ -0,0 +1,349 @@
+/// MidiFilePlayer.cpp
+
+#include "MidiFilePlayer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    /**
+     * @brief A reader of the big-endian fields of a MIDI file
+     */
+    struct MidiFileReader {
+        const std::vector<unsigned char>& data;
+        std::size_t pos = 0;
+        void need(std::size_t n) const {
+            if (pos + n > data.size()) {
+                throw std::runtime_error("Truncated MIDI file.");
+            }
+        }
+        unsigned char byte() {
+            need(1);
+            return data[pos++];
+        }
+        unsigned char peek() const {
+            need(1);
+            return data[pos];
+        }
+        std::uint32_t read32() {
+            need(4);
+            std::uint32_t v = (data[pos] << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8) | data[pos + 3];
+            pos += 4;
+            return v;
+        }
+        std::uint16_t read16() {
+            need(2);
+            std::uint16_t v = static_cast<std::uint16_t>((data[pos] << 8) | data[pos + 1]);
+            pos += 2;
+            return v;
+        }
+        /// A variable-length quantity of at most four bytes
+        std::uint32_t readVariable() {
+            std::uint32_t v = 0;
+            for (int i = 0; i < 4; ++i) {
+                const unsigned char b = byte();
+                v = (v << 7) | (b & 0x7F);
+                if (!(b & 0x80)) {
+                    return v;
+                }
+            }
+            throw std::runtime_error("Invalid variable-length quantity in MIDI file.");
+        }
+        bool match(const char* id) {
+            need(4);
+            const bool matches = std::equal(id, id + 4, data.begin() + pos);
+            pos += 4;
+            return matches;
+        }
+        void skip(std::size_t n) {
+            need(n);
+            pos += n;
+        }
+    };
+}
+
+/**
+ * @brief Constructor
+ * @param filename The path of the MIDI file
+ * @param blockSize The block size
+ * @param sampleRate The sample rate
+ * @param loop True to loop the file
+ */
+dibiff::midi::MidiFilePlayer::MidiFilePlayer(const std::string& filename, int blockSize, float sampleRate, bool loop)
+: dibiff::graph::AudioObject(), filename(filename), blockSize(blockSize), sampleRate(sampleRate), loop(loop) {
+    name = "MidiFilePlayer";
+}
+/**
+ * @brief Initialize
+ * @details Creates the output and parses the file
+ */
+void dibiff::midi::MidiFilePlayer::initialize() {
+    auto o = std::make_unique<dibiff::graph::MidiOutput>(dibiff::graph::MidiOutput(this, "MidiFilePlayerMidiOutput"));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::MidiOutput*>(_outputs.back().get());
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Error opening the MIDI file.");
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    events = parse(data, sampleRate, length);
+}
+/**
+ * @brief Emit the events of the next block
+ * @details Walks the events from the cursor up to the end of the block, wrapping
+ * around to the start of the file when looping
+ */
+void dibiff::midi::MidiFilePlayer::process() {
+    messages.clear();
+    offsets.clear();
+    const long target = seekTarget.exchange(-1);
+    if (target >= 0) {
+        releaseHeld(0);
+        moveTo(std::min(target, length));
+    }
+    int offset = 0;
+    while (offset < blockSize) {
+        if (position >= length) {
+            if (!loop.load() || length == 0) {
+                break;
+            }
+            releaseHeld(offset);
+            moveTo(0);
+        }
+        const long end = std::min(position + (blockSize - offset), length);
+        for (; cursor < events.size() && events[cursor].sample < end; ++cursor) {
+            const Event& e = events[cursor];
+            if (e.size == 3) {
+                messages.push_back({e.status, e.data1, e.data2});
+            } else {
+                messages.push_back({e.status, e.data1});
+            }
+            offsets.push_back(offset + static_cast<int>(e.sample - position));
+            const int type = e.status & 0xF0;
+            const int note = (e.status & 0x0F) * 128 + e.data1;
+            if (type == 0x90 && e.data2 > 0) {
+                held[note] = true;
+            } else if (type == 0x80 || type == 0x90) {
+                held[note] = false;
+            }
+        }
+        offset += static_cast<int>(end - position);
+        position = end;
+    }
+    output->setData(messages, blockSize, offsets);
+    markProcessed();
+}
+/**
+ * @brief Reset the player
+ * @details Rewinds to the start of the file
+ */
+void dibiff::midi::MidiFilePlayer::reset() {
+    seekTarget.store(-1);
+    moveTo(0);
+    std::fill(held.begin(), held.end(), false);
+}
+/**
+ * @brief Check if the player is ready to process
+ * @return True if the player is ready to process, false otherwise
+ */
+bool dibiff::midi::MidiFilePlayer::isReadyToProcess() const {
+    return !processed;
+}
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+void dibiff::midi::MidiFilePlayer::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
+/**
+ * @brief Check if the player has finished
+ * @return True if the file has been played to the end and is not looping, false otherwise
+ */
+bool dibiff::midi::MidiFilePlayer::isFinished() const {
+    return !loop.load() && position >= length;
+}
+/**
+ * @brief Seek to a position
+ * @param sample The position in samples from the start of the file
+ */
+void dibiff::midi::MidiFilePlayer::seek(long sample) {
+    seekTarget.store(std::max(sample, 0L));
+}
+/**
+ * @brief Enable or disable looping
+ * @param enabled True to loop the file
+ */
+void dibiff::midi::MidiFilePlayer::setLoop(bool enabled) {
+    loop.store(enabled);
+}
+/**
+ * @brief Get the length of the file
+ * @return The time of the end of the longest track in samples
+ */
+long dibiff::midi::MidiFilePlayer::getLength() const {
+    return length;
+}
+/**
+ * @brief Get the playback position
+ * @return The position in samples from the start of the file
+ */
+long dibiff::midi::MidiFilePlayer::getPosition() const {
+    return position;
+}
+/**
+ * @brief Get the parsed events
+ * @return The channel messages in time order
+ */
+const std::vector<dibiff::midi::MidiFilePlayer::Event>& dibiff::midi::MidiFilePlayer::getEvents() const {
+    return events;
+}
+void dibiff::midi::MidiFilePlayer::releaseHeld(int offset) {
+    for (int note = 0; note < static_cast<int>(held.size()); ++note) {
+        if (held[note]) {
+            messages.push_back({static_cast<unsigned char>(0x80 | (note / 128)), static_cast<unsigned char>(note % 128), 0});
+            offsets.push_back(offset);
+            held[note] = false;
+        }
+    }
+}
+void dibiff::midi::MidiFilePlayer::moveTo(long sample) {
+    position = sample;
+    cursor = std::lower_bound(events.begin(), events.end(), sample, [](const Event& e, long s) {
+        return e.sample < s;
+    }) - events.begin();
+}
+/**
+ * @brief Parse a Standard MIDI File
+ * @details Reads formats 0, 1 and 2, playing the tracks of a format 2 file at the
+ * same time. Channel messages are kept; meta events other than tempo changes and
+ * system exclusive messages are skipped. Events at the same tick keep their order
+ * within a track, and earlier tracks come first.
+ * @param data The contents of the file
+ * @param sampleRate The sample rate to time the events at
+ * @param length Set to the time of the end of the longest track in samples
+ * @return The channel messages in time order
+ */
+std::vector<dibiff::midi::MidiFilePlayer::Event> dibiff::midi::MidiFilePlayer::parse(const std::vector<unsigned char>& data, float sampleRate, long& length) {
+    MidiFileReader r{data};
+    if (!r.match("MThd")) {
+        throw std::runtime_error("Not a MIDI file.");
+    }
+    const std::uint32_t headerLength = r.read32();
+    if (headerLength < 6) {
+        throw std::runtime_error("Invalid MIDI file header.");
+    }
+    const std::size_t headerEnd = r.pos + headerLength;
+    r.read16();
+    const int trackCount = r.read16();
+    const std::uint16_t division = r.read16();
+    r.pos = headerEnd;
+    if (division == 0) {
+        throw std::runtime_error("Invalid MIDI file division.");
+    }
+    /// Events in ticks first, the tempo map applies across all tracks
+    std::vector<std::pair<std::uint64_t, Event>> timed;
+    std::vector<std::pair<std::uint64_t, double>> tempos;
+    std::uint64_t endTick = 0;
+    for (int track = 0; track < trackCount; ++track) {
+        /// Skip chunks of unknown types
+        while (!r.match("MTrk")) {
+            r.skip(r.read32());
+        }
+        const std::uint32_t trackLength = r.read32();
+        r.need(trackLength);
+        const std::size_t trackEnd = r.pos + trackLength;
+        std::uint64_t tick = 0;
+        unsigned char running = 0;
+        while (r.pos < trackEnd) {
+            tick += r.readVariable();
+            unsigned char status = r.peek();
+            if (status & 0x80) {
+                r.pos++;
+            } else if (running == 0) {
+                throw std::runtime_error("Missing status byte in MIDI file.");
+            } else {
+                status = running;
+            }
+            if (status == 0xFF) {
+                const unsigned char type = r.byte();
+                const std::uint32_t size = r.readVariable();
+                r.need(size);
+                if (type == 0x51 && size == 3) {
+                    const double microseconds = (data[r.pos] << 16) | (data[r.pos + 1] << 8) | data[r.pos + 2];
+                    tempos.emplace_back(tick, microseconds);
+                }
+                r.pos += size;
+                if (type == 0x2F) {
+                    break;
+                }
+            } else if (status == 0xF0 || status == 0xF7) {
+                r.skip(r.readVariable());
+                running = 0;
+            } else if (status > 0xF0) {
+                throw std::runtime_error("Unexpected system message in MIDI file.");
+            } else {
+                running = status;
+                const int type = status & 0xF0;
+                Event e{0, status, r.byte(), 0, 2};
+                if (type != 0xC0 && type != 0xD0) {
+                    e.data2 = r.byte();
+                    e.size = 3;
+                }
+                timed.emplace_back(tick, e);
+            }
+        }
+        endTick = std::max(endTick, tick);
+        r.pos = trackEnd;
+    }
+    auto byTick = [](const auto& a, const auto& b) { return a.first < b.first; };
+    std::stable_sort(timed.begin(), timed.end(), byTick);
+    std::stable_sort(tempos.begin(), tempos.end(), byTick);
+    /// Convert ticks to samples, walking the tempo map alongside the sorted ticks
+    double secondsPerTick;
+    const bool smpte = division & 0x8000;
+    if (smpte) {
+        const int fps = -static_cast<signed char>(division >> 8);
+        const double rate = fps == 29 ? 29.97 : fps;
+        secondsPerTick = 1.0 / (rate * (division & 0xFF));
+    } else {
+        secondsPerTick = 500000.0 * 1e-6 / division;
+    }
+    std::size_t tempo = 0;
+    std::uint64_t lastTick = 0;
+    double seconds = 0.0;
+    auto toSample = [&](std::uint64_t tick) {
+        while (!smpte && tempo < tempos.size() && tempos[tempo].first <= tick) {
+            seconds += (tempos[tempo].first - lastTick) * secondsPerTick;
+            lastTick = tempos[tempo].first;
+            secondsPerTick = tempos[tempo].second * 1e-6 / division;
+            ++tempo;
+        }
+        return std::lround((seconds + (tick - lastTick) * secondsPerTick) * sampleRate);
+    };
+    std::vector<Event> events;
+    events.reserve(timed.size());
+    for (auto& [tick, e] : timed) {
+        e.sample = toSample(tick);
+        events.push_back(e);
+    }
+    length = toSample(endTick);
+    if (!events.empty()) {
+        length = std::max(length, events.back().sample + 1);
+    }
+    return events;
+}
+/**
+ * @brief Create a new MIDI file player
+ * @param filename The path of the MIDI file
+ * @param blockSize The block size
+ * @param sampleRate The sample rate
+ * @param loop True to loop the file
+ */
+std::unique_ptr<dibiff::midi::MidiFilePlayer> dibiff::midi::MidiFilePlayer::create(const std::string& filename, int blockSize, float sampleRate, bool loop) {
+    auto instance = std::make_unique<dibiff::midi::MidiFilePlayer>(filename, blockSize, sampleRate, loop);
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,148 @@
+/// MidiFilePlayer.h
+
+#pragma once
+
+#include "midi.h"
+#include "../graph/graph.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @brief MIDI File Player
+ * @details A MIDI source that plays a Standard MIDI File. The file is parsed once on
+ * initialization into a flat array of channel messages, merged across tracks and
+ * timed in samples through the file's tempo map, so playback is deterministic and
+ * each block only walks the events that fall inside it. Messages are emitted with
+ * their sample offsets within the block. Playback can loop and seek; notes still
+ * held at a loop point or a seek are released first.
+ */
+class dibiff::midi::MidiFilePlayer : public dibiff::graph::AudioObject {
+    public:
+        /**
+         * @brief A channel message and its time
+         */
+        struct Event {
+            /// The time of the event in samples from the start of the file
+            long sample;
+            unsigned char status;
+            unsigned char data1;
+            unsigned char data2;
+            /// The number of bytes of the message, 2 or 3
+            unsigned char size;
+        };
+        /**
+         * @brief The MIDI output connection point
+         */
+        dibiff::graph::MidiOutput* output;
+        /**
+         * @brief Constructor
+         * @param filename The path of the MIDI file
+         * @param blockSize The block size
+         * @param sampleRate The sample rate
+         * @param loop True to loop the file
+         */
+        MidiFilePlayer(const std::string& filename, int blockSize, float sampleRate, bool loop = false);
+        /**
+         * @brief Initialize
+         * @details Creates the output and parses the file
+         */
+        void initialize() override;
+        /**
+         * @brief Emit the events of the next block
+         */
+        void process() override;
+        /**
+         * @brief Reset the player
+         * @details Rewinds to the start of the file
+         */
+        void reset() override;
+        /**
+         * @brief Clear the player
+         * @details Not used.
+         */
+        void clear() override {}
+        /**
+         * @brief Check if the player is ready to process
+         * @return True if the player is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
+        /**
+         * @brief Check if the player has finished
+         * @return True if the file has been played to the end and is not looping, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Seek to a position
+         * @details Safe to call from any thread, takes effect at the next block
+         * @param sample The position in samples from the start of the file
+         */
+        void seek(long sample);
+        /**
+         * @brief Enable or disable looping
+         * @details Safe to call from any thread
+         * @param enabled True to loop the file
+         */
+        void setLoop(bool enabled);
+        /**
+         * @brief Get the length of the file
+         * @return The time of the end of the longest track in samples
+         */
+        long getLength() const;
+        /**
+         * @brief Get the playback position
+         * @return The position in samples from the start of the file
+         */
+        long getPosition() const;
+        /**
+         * @brief Get the parsed events
+         * @return The channel messages in time order
+         */
+        const std::vector<Event>& getEvents() const;
+        /**
+         * @brief Parse a Standard MIDI File
+         * @param data The contents of the file
+         * @param sampleRate The sample rate to time the events at
+         * @param length Set to the time of the end of the longest track in samples
+         * @return The channel messages in time order
+         */
+        static std::vector<Event> parse(const std::vector<unsigned char>& data, float sampleRate, long& length);
+        /**
+         * @brief Create a new MIDI file player
+         * @param filename The path of the MIDI file
+         * @param blockSize The block size
+         * @param sampleRate The sample rate
+         * @param loop True to loop the file
+         */
+        static std::unique_ptr<MidiFilePlayer> create(const std::string& filename, int blockSize, float sampleRate, bool loop = false);
+    private:
+        std::string filename;
+        int blockSize;
+        float sampleRate;
+        std::atomic<bool> loop;
+        std::atomic<long> seekTarget{-1};
+        std::vector<Event> events;
+        long length = 0;
+        long position = 0;
+        std::size_t cursor = 0;
+        /// Notes currently held, indexed by channel * 128 + key
+        std::vector<bool> held = std::vector<bool>(16 * 128, false);
+        std::vector<std::vector<unsigned char>> messages;
+        std::vector<int> offsets;
+        /**
+         * @brief Emit note offs for every held note
+         * @param offset The sample offset within the block
+         */
+        void releaseHeld(int offset);
+        /**
+         * @brief Move the cursor to the first event at or after a position
+         * @param sample The position in samples
+         */
+        void moveTo(long sample);
+};
@@ -47,6 +47,13 @@ void dibiff::midi::MidiInput::process() {
 bool dibiff::midi::MidiInput::isReadyToProcess() const {
     return !processed;
 }
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+void dibiff::midi::MidiInput::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
 /**
  * @brief Check if the object is finished
  */
@@ -54,6 +54,11 @@ class dibiff::midi::MidiInput : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
         /**
          * @brief Check if the MIDI input has finished generating samples
          * @return True if the MIDI input has finished generating samples, false otherwise
@@ -80,6 +80,13 @@ bool dibiff::midi::VoiceSelector::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Set the block size
+ * @param blockSize The new block size
+ */
+void dibiff::midi::VoiceSelector::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
 /**
  * @brief Create a new instance of the object.
  * @param blockSize The block size of the object
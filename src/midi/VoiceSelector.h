@@ -28,6 +28,7 @@ class dibiff::midi::VoiceSelector : public dibiff::graph::AudioObject {
         void reset() override {};
         void clear() override {}
         bool isReadyToProcess() const override;
+        void setBlockSize(int blockSize) override;
         bool isFinished() const override;
         static std::unique_ptr<VoiceSelector> create(int blockSize, int numVoices = 3);
     private:
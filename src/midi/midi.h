@@ -10,6 +10,7 @@ namespace dibiff {
      */
     namespace midi {
         class MidiInput;
+        class MidiFilePlayer;
         class Voice;
         class VoiceSelector;
     }
@@ -0,0 +1,53 @@
+/// BufferSink.cpp
+
+#include "BufferSink.h"
+
+dibiff::sink::BufferSink::BufferSink(int channels)
+: dibiff::graph::AudioObject(), channels(channels), buffers(channels) {
+    name = "BufferSink";
+}
+
+void dibiff::sink::BufferSink::initialize() {
+    auto in = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "BufferSinkInput", 0));
+    _inputs.emplace_back(std::move(in));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
+}
+
+void dibiff::sink::BufferSink::process() {
+    if (input->isConnected() && input->isReady()) {
+        const int blockSize = input->getBlockSize();
+        const int inChannels = input->getChannels();
+        for (int c = 0; c < channels; ++c) {
+            const float* in = input->getChannel(c < inChannels ? c : 0);
+            buffers[c].insert(buffers[c].end(), in, in + blockSize);
+        }
+    }
+    markProcessed();
+}
+
+void dibiff::sink::BufferSink::clear() {
+    for (auto& buffer : buffers) {
+        buffer.clear();
+    }
+}
+
+bool dibiff::sink::BufferSink::isFinished() const {
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
+}
+
+bool dibiff::sink::BufferSink::isReadyToProcess() const {
+    if (!input->isConnected()) {
+        return !processed;
+    }
+    return input->isReady() && !processed;
+}
+
+const std::vector<float>& dibiff::sink::BufferSink::getChannelData(int channel) const {
+    return buffers[channel];
+}
+
+std::unique_ptr<dibiff::sink::BufferSink> dibiff::sink::BufferSink::create(int channels) {
+    auto instance = std::make_unique<BufferSink>(channels);
+    instance->initialize();
+    return std::move(instance);
+}
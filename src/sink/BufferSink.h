@@ -0,0 +1,73 @@
+/// BufferSink.h
+
+#pragma once
+
+#include "sink.h"
+#include "../graph/graph.h"
+
+#include <vector>
+
+/**
+ * @brief Buffer Sink
+ * @details A buffer sink object that appends every block it receives to an in-memory
+ * buffer per channel, used for offline rendering. Mono inputs are broadcast to every
+ * channel.
+ */
+class dibiff::sink::BufferSink : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioInput* input;
+        /**
+         * @brief Constructor
+         * @param channels The number of channels to record
+         */
+        BufferSink(int channels);
+        /**
+         * @brief Initialize
+         * @details Initializes the BufferSink connection points
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Appends the input block to the buffers
+         */
+        void process() override;
+        /**
+         * @brief Reset the BufferSink
+         * @details Not used.
+         */
+        void reset() override {}
+        /**
+         * @brief Clear the BufferSink
+         * @details Discards the recorded audio
+         */
+        void clear() override;
+        /**
+         * @brief Check if the BufferSink is finished processing
+         * @return True if the BufferSink is finished processing, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the BufferSink is ready to process
+         * @return True if the BufferSink is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the buffer sink
+         * @return The sink has no audio output, so 0
+         */
+        long getStateMemory() const override { return 0; }
+        /**
+         * @brief Get the recorded audio of a channel
+         * @param channel The channel
+         * @return The recorded samples
+         */
+        const std::vector<float>& getChannelData(int channel) const;
+        /**
+         * @brief Creates a new BufferSink object
+         * @param channels The number of channels to record
+         */
+        static std::unique_ptr<BufferSink> create(int channels);
+    private:
+        int channels;
+        std::vector<std::vector<float>> buffers;
+};
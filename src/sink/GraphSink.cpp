@@ -14,57 +14,49 @@ dibiff::sink::GraphSink::GraphSink(int channels, int rate, int blockSize)
 }
 
 void dibiff::sink::GraphSink::initialize() {
+    auto in = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "GraphSinkInput", channels));
+    _inputs.emplace_back(std::move(in));
+    input = static_cast<dibiff::graph::AudioInput*>(_inputs.back().get());
     for (int i = 0; i < channels; i++) {
-        auto in = std::make_unique<dibiff::graph::AudioInput>(dibiff::graph::AudioInput(this, "GraphSinkInput" + std::to_string(i)));
-        _inputs.emplace_back(std::move(in));
         ringBuffers.push_back(std::make_unique<RingBuffer<float>>(blockSize * 10));
     }
 }
 
 void dibiff::sink::GraphSink::process() {
-    for (int i = 0; i < channels; i++) {
-        auto in = static_cast<dibiff::graph::AudioInput*>(_inputs[i].get());
-        if (!in->isConnected()) {
-            /// Fill ring buffers with zeros
-            std::vector<float> zeros(blockSize, 0.0f);
-            ringBuffers[i]->write(zeros, blockSize);
-        } else if (in->isReady()) {
-            const std::vector<float>& audioData = in->getData();
-            const int blockSize = in->getBlockSize();
-            /// Add the audioData to the ring buffers
-            ringBuffers[i]->write(audioData, blockSize);
+    if (!input->isConnected()) {
+        /// Fill ring buffers with zeros
+        std::vector<float> zeros(blockSize, 0.0f);
+        for (int i = 0; i < channels; i++) {
+            ringBuffers[i]->write(zeros.data(), blockSize);
+        }
+    } else if (input->isReady()) {
+        const int blockSize = input->getBlockSize();
+        /// Add each channel plane to its ring buffer
+        for (int i = 0; i < channels; i++) {
+            ringBuffers[i]->write(input->getChannel(i), blockSize);
         }
     }
     markProcessed();
 }
 
 bool dibiff::sink::GraphSink::isFinished() const {
-    bool allFinished = true;
-    for (int i = 0; i < channels; ++i) {
-        auto in = static_cast<dibiff::graph::AudioInput*>(_inputs[i].get());
-        if (!in->isConnected() || !in->isReady() || !in->isFinished()) {
-            allFinished = false;
-            break;
-        }
-    }
-    return allFinished && processed;
+    return input->isConnected() && input->isReady() && input->isFinished() && processed;
 }
 
 bool dibiff::sink::GraphSink::isReadyToProcess() const {
-    std::vector<bool> connected(channels, false);
-    for (int i = 0; i < channels; ++i) {
-        auto in = static_cast<dibiff::graph::AudioInput*>(_inputs[i].get());
-        connected[i] = in->isConnected();
+    if (!input->isConnected()) {
+        return !processed;
     }
-    bool isReady = true;
-    for (int i = 0; i < channels; ++i) {
-        auto in = static_cast<dibiff::graph::AudioInput*>(_inputs[i].get());
-        if (connected[i] && !in->isReady()) {
-            isReady = false;
-            break;
-        }
+    return input->isReady() && !processed;
+}
+
+void dibiff::sink::GraphSink::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+    const std::size_t capacity = static_cast<std::size_t>(blockSize) * 10;
+    /// Grow in place: the other thread keeps using the same rings and the queued audio
+    for (auto& ring : ringBuffers) {
+        ring->reserve(capacity);
     }
-    return isReady && !processed;
 }
 
 std::unique_ptr<dibiff::sink::GraphSink> dibiff::sink::GraphSink::create(int channels, int rate, int blockSize) {
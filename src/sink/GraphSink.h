@@ -13,10 +13,12 @@
 /**
  * @brief Graph Sink
  * @details A graph sink object that sends audio data to the thread responsible for handling
- * the audio data.
+ * the audio data. The sink has a single multichannel input, and each channel is written to
+ * its own ring buffer.
  */
 class dibiff::sink::GraphSink : public dibiff::graph::AudioObject {
     public:
+        dibiff::graph::AudioInput* input;
         std::condition_variable cv;
         std::mutex cv_mtx;
         int sampleRate;
@@ -68,6 +70,19 @@ class dibiff::sink::GraphSink : public dibiff::graph::AudioObject {
          * @return True if the GraphSink is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the graph sink
+         * @return The sink has no audio output, so 0
+         */
+        long getStateMemory() const override { return 0; }
+
+        /**
+         * @brief Set the block size
+         * @details Grows the ring buffers in place if they are too small for ten blocks,
+         * keeping the audio queued in them, so the thread reading from them can keep running.
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
 
         /**
          * @brief Creates a new GraphSink object
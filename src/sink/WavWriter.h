@@ -61,6 +61,11 @@ class dibiff::sink::WavWriter : public dibiff::graph::AudioObject {
          * @return True if the WAV sink is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the wav writer
+         * @return The writer has no audio output, so 0
+         */
+        long getStateMemory() const override { return 0; }
         /**
          * @brief Finalize the WAV header
          * @details Finalizes the WAV header by writing the chunk sizes
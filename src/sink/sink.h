@@ -11,5 +11,6 @@ namespace dibiff {
     namespace sink {
         class WavWriter;
         class GraphSink;
+        class BufferSink;
     }
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+/// BufferSource.cpp
+
+#include "BufferSource.h"
+
+#include <algorithm>
+
+dibiff::source::BufferSource::BufferSource(const float* data, int channels, long frames, int blockSize, long start, long end)
+: dibiff::graph::AudioObject(), data(data), channels(channels), frames(frames), blockSize(blockSize),
+  start(start), end(end < 0 ? frames : std::min(end, frames)), position(start) {
+    name = "BufferSource";
+}
+
+void dibiff::source::BufferSource::initialize() {
+    auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "BufferSourceOutput", channels));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
+}
+
+void dibiff::source::BufferSource::process() {
+    std::vector<float> planar(static_cast<std::size_t>(blockSize) * channels, 0.0f);
+    const long available = std::max(0L, std::min(static_cast<long>(blockSize), end - position));
+    for (int c = 0; c < channels; ++c) {
+        const float* in = data + static_cast<std::size_t>(c) * frames + position;
+        std::copy(in, in + available, planar.begin() + static_cast<std::size_t>(c) * blockSize);
+    }
+    position += blockSize;
+    output->setData(std::move(planar), blockSize, channels);
+    markProcessed();
+}
+
+void dibiff::source::BufferSource::reset() {
+    position = start;
+}
+
+bool dibiff::source::BufferSource::isFinished() const {
+    return position >= end;
+}
+
+bool dibiff::source::BufferSource::isReadyToProcess() const {
+    return !processed;
+}
+
+void dibiff::source::BufferSource::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+}
+
+std::unique_ptr<dibiff::source::BufferSource> dibiff::source::BufferSource::create(const float* data, int channels, long frames, int blockSize, long start, long end) {
+    auto instance = std::make_unique<BufferSource>(data, channels, frames, blockSize, start, end);
+    instance->initialize();
+    return std::move(instance);
+}
@@ -0,0 +1,89 @@
+/// BufferSource.h
+
+#pragma once
+
+#include "source.h"
+#include "../graph/graph.h"
+
+#include <vector>
+
+/**
+ * @brief Buffer Source
+ * @details A buffer source object that plays a range of an in-memory planar buffer
+ * one block at a time, used for offline rendering. Blocks past the end of the range
+ * are zero-padded.
+ */
+class dibiff::source::BufferSource : public dibiff::graph::AudioObject {
+    public:
+        dibiff::graph::AudioOutput* output;
+        /**
+         * @brief Constructor
+         * @details Initializes the BufferSource with a planar buffer of `frames` samples per channel.
+         * The buffer is not copied and must outlive the source.
+         * @param data The planar audio data
+         * @param channels The number of channels in the audio data
+         * @param frames The number of samples per channel in the audio data
+         * @param blockSize The block size of the output
+         * @param start The first sample to play
+         * @param end The sample to stop before, or -1 to play to the end of the buffer
+         */
+        BufferSource(const float* data, int channels, long frames, int blockSize, long start = 0, long end = -1);
+        /**
+         * @brief Initialize
+         * @details Initializes the BufferSource connection points
+         */
+        void initialize() override;
+        /**
+         * @brief Process a block of samples
+         * @details Publishes the next block of the buffer
+         */
+        void process() override;
+        /**
+         * @brief Reset the BufferSource
+         * @details Rewinds to the start of the range
+         */
+        void reset() override;
+        /**
+         * @brief Clear the BufferSource
+         * @details Not used.
+         */
+        void clear() override {}
+        /**
+         * @brief Check if the BufferSource is finished processing
+         * @return True if the whole range has been played, false otherwise
+         */
+        bool isFinished() const override;
+        /**
+         * @brief Check if the BufferSource is ready to process
+         * @return True if the BufferSource is ready to process, false otherwise
+         */
+        bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the buffer source
+         * @return The source plays its buffer from any position, so 0
+         */
+        long getStateMemory() const override { return 0; }
+        /**
+         * @brief Set the block size
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
+        /**
+         * @brief Creates a new BufferSource object
+         * @param data The planar audio data
+         * @param channels The number of channels in the audio data
+         * @param frames The number of samples per channel in the audio data
+         * @param blockSize The block size of the output
+         * @param start The first sample to play
+         * @param end The sample to stop before, or -1 to play to the end of the buffer
+         */
+        static std::unique_ptr<BufferSource> create(const float* data, int channels, long frames, int blockSize, long start = 0, long end = -1);
+    private:
+        const float* data;
+        int channels;
+        long frames;
+        int blockSize;
+        long start;
+        long end;
+        long position;
+};
@@ -14,25 +14,21 @@ dibiff::source::GraphSource::GraphSource(int channels, int rate, int blockSize)
 }
 
 void dibiff::source::GraphSource::initialize() {
+    auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "GraphSourceOutput", channels));
+    _outputs.emplace_back(std::move(o));
+    output = static_cast<dibiff::graph::AudioOutput*>(_outputs.back().get());
     for (int i = 0; i < channels; i++) {
-        auto o = std::make_unique<dibiff::graph::AudioOutput>(dibiff::graph::AudioOutput(this, "GraphSourceOutput" + std::to_string(i)));
-        _outputs.emplace_back(std::move(o));
         ringBuffers.push_back(std::make_unique<RingBuffer<float>>(blockSize * 10));
     }
 }
 
 void dibiff::source::GraphSource::process() {
+    /// Read each channel plane from its ring buffer, zero-padding on underrun
+    std::vector<float> planar(static_cast<std::size_t>(blockSize) * channels, 0.0f);
     for (int i = 0; i < channels; i++) {
-        auto out = static_cast<dibiff::graph::AudioOutput*>(_outputs[i].get());
-        /// Read the data from the ring buffer
-        if (ringBuffers[i]->available() > 0) {
-            std::vector<float> ringData = ringBuffers[i]->read(blockSize);
-            out->setData(ringData, blockSize);
-        } else {
-            std::vector<float> ringData(blockSize, 0.0f);
-            out->setData(ringData, blockSize);
-        }
+        ringBuffers[i]->read(planar.data() + static_cast<std::size_t>(i) * blockSize, blockSize);
     }
+    output->setData(std::move(planar), blockSize, channels);
     markProcessed();
 }
 
@@ -44,6 +40,15 @@ bool dibiff::source::GraphSource::isReadyToProcess() const {
     return !processed;
 }
 
+void dibiff::source::GraphSource::setBlockSize(int blockSize) {
+    this->blockSize = blockSize;
+    const std::size_t capacity = static_cast<std::size_t>(blockSize) * 10;
+    /// Grow in place: the other thread keeps using the same rings and the queued audio
+    for (auto& ring : ringBuffers) {
+        ring->reserve(capacity);
+    }
+}
+
 std::unique_ptr<dibiff::source::GraphSource> dibiff::source::GraphSource::create(int channels, int rate, int blockSize) {
     auto instance = std::make_unique<GraphSource>(channels, rate, blockSize);
     instance->initialize();
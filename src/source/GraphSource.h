@@ -13,10 +13,12 @@
 /**
  * @brief Graph Source
  * @details A graph source object that receives audio data from the thread responsible for handling
- * the audio data.
+ * the audio data. Each channel is read from its own ring buffer and published on a single
+ * multichannel output.
  */
 class dibiff::source::GraphSource : public dibiff::graph::AudioObject {
     public:
+        dibiff::graph::AudioOutput* output;
         std::condition_variable cv;
         std::mutex cv_mtx;
         int sampleRate;
@@ -69,6 +71,14 @@ class dibiff::source::GraphSource : public dibiff::graph::AudioObject {
          */
         bool isReadyToProcess() const override;
 
+        /**
+         * @brief Set the block size
+         * @details Grows the ring buffers in place if they are too small for ten blocks,
+         * keeping the audio queued in them, so the thread writing to them can keep running.
+         * @param blockSize The new block size
+         */
+        void setBlockSize(int blockSize) override;
+
         /**
          * @brief Creates a new GraphSource object
          * @param channels The number of channels in the audio data
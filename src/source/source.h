@@ -11,5 +11,6 @@ namespace dibiff {
      */
     namespace source {
         class GraphSource;
+        class BufferSource;
     }
 }
\ No newline at end of file
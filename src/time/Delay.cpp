@@ -1,6 +1,7 @@
 /// Delay.cpp
 
 #include "Delay.h"
+#include "../util/StateBlob.h"
 #include "../inc/Eigen/Dense"
 
 /**
@@ -70,7 +71,7 @@ void dibiff::time::Delay::process() {
  * @details Resets the delay buffer
  */
 void dibiff::time::Delay::reset() {
-    buffer = std::vector<float>(buffer.size(), 0.0f);
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
 }
 /**
  * @brief Clear the delay
@@ -96,6 +97,38 @@ bool dibiff::time::Delay::isReadyToProcess() const {
     }
     return input->isReady() && !processed;
 }
+/**
+ * @brief Get the state memory of the delay
+ * @return The length of the delay line in samples
+ */
+long dibiff::time::Delay::getStateMemory() const {
+    return static_cast<long>(buffer.size());
+}
+/**
+ * @brief Save the runtime state of the delay
+ * @return A versioned blob of the delay line and its position
+ */
+std::vector<unsigned char> dibiff::time::Delay::saveState() const {
+    dibiff::util::StateWriter writer("Delay", 1);
+    writer.writeVector(buffer);
+    writer.write(bufferIndex);
+    return writer.finish();
+}
+/**
+ * @brief Restore the runtime state of the delay
+ * @param state A blob returned by saveState()
+ */
+void dibiff::time::Delay::restoreState(const std::vector<unsigned char>& state) {
+    dibiff::util::StateReader reader(state, "Delay", 1);
+    dibiff::util::HugeVector<float> line(buffer.size());
+    reader.readVector(line);
+    const int index = reader.read<int>();
+    if (index < 0 || index >= static_cast<int>(std::max<std::size_t>(line.size(), 1))) {
+        throw std::runtime_error("Invalid delay position.");
+    }
+    buffer = std::move(line);
+    bufferIndex = index;
+}
 /**
  * Create a new delay object
  * @param delayTime The delay time of the object in milliseconds
@@ -4,6 +4,7 @@
 
 #include "time.h"
 #include "../graph/graph.h"
+#include "../util/HugePages.h"
 
 /**
  * @brief Delay
@@ -60,6 +61,21 @@ class dibiff::time::Delay : public dibiff::graph::AudioObject {
          * @return True if the filter is ready to process, false otherwise
          */
         bool isReadyToProcess() const override;
+        /**
+         * @brief Get the state memory of the delay
+         * @return The length of the delay line in samples
+         */
+        long getStateMemory() const override;
+        /**
+         * @brief Save the runtime state of the delay
+         * @return A versioned blob of the delay line and its position
+         */
+        std::vector<unsigned char> saveState() const override;
+        /**
+         * @brief Restore the runtime state of the delay
+         * @param state A blob returned by saveState()
+         */
+        void restoreState(const std::vector<unsigned char>& state) override;
         /**
          * Create a new delay object
          * @param delayTime The delay time of the object in milliseconds
@@ -69,6 +85,6 @@ class dibiff::time::Delay : public dibiff::graph::AudioObject {
     private:
         float delayTime;
         float sampleRate;
-        std::vector<float> buffer;
+        dibiff::util::HugeVector<float> buffer;
         int bufferIndex = 0;
 };
\ No newline at end of file
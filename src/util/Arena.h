@@ -0,0 +1,115 @@
+/// Arena.h
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dibiff {
+    /**
+     * @brief Utility Namespace
+     * @details A namespace containing low-level helpers shared by the audio objects
+     */
+    namespace util {
+        class Arena;
+    }
+}
+
+/**
+ * @brief Arena
+ * @details A bump allocator that hands out memory from large contiguous chunks.
+ * Allocations are never moved or individually freed, so pointers into the arena
+ * stay valid until the arena itself is destroyed. Objects placed in the arena
+ * must be destroyed by their owner before the arena goes away.
+ */
+class dibiff::util::Arena {
+public:
+    /**
+     * @brief Construct a new Arena object
+     * @param chunkSize The size of each chunk in bytes
+     */
+    explicit Arena(std::size_t chunkSize = 64 * 1024);
+
+    /**
+     * @brief Allocate memory from the arena
+     * @param size The number of bytes to allocate
+     * @param alignment The required alignment, must be a power of two
+     * @return A pointer to the allocated memory
+     */
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Make room for a number of bytes
+     * @details Starts a new chunk unless the current one has room, so the next
+     * allocations totalling at most size bytes are contiguous
+     * @param size The number of bytes, including alignment padding
+     */
+    void reserve(std::size_t size);
+
+    /**
+     * @brief Get the number of bytes handed out by the arena
+     * @return The number of bytes allocated, including alignment padding
+     */
+    std::size_t used() const;
+
+private:
+    std::size_t chunkSize;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    std::size_t chunkCapacity = 0;
+    std::size_t offset = 0;
+    std::size_t totalUsed = 0;
+};
+
+/**
+ * @brief Construct a new Arena object
+ * @param chunkSize The size of each chunk in bytes
+ */
+inline dibiff::util::Arena::Arena(std::size_t chunkSize)
+    : chunkSize(chunkSize) {}
+/**
+ * @brief Allocate memory from the arena
+ * @param size The number of bytes to allocate
+ * @param alignment The required alignment, must be a power of two
+ * @return A pointer to the allocated memory
+ */
+inline void* dibiff::util::Arena::allocate(std::size_t size, std::size_t alignment) {
+    if (!chunks.empty()) {
+        auto base = reinterpret_cast<std::uintptr_t>(chunks.back().get());
+        std::size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+        if (aligned + size <= chunkCapacity) {
+            totalUsed += aligned + size - offset;
+            offset = aligned + size;
+            return chunks.back().get() + aligned;
+        }
+    }
+    /// Start a new chunk large enough for this allocation
+    chunkCapacity = std::max(chunkSize, size + alignment);
+    chunks.emplace_back(new unsigned char[chunkCapacity]);
+    auto base = reinterpret_cast<std::uintptr_t>(chunks.back().get());
+    std::size_t aligned = ((base + alignment - 1) & ~(alignment - 1)) - base;
+    offset = aligned + size;
+    totalUsed += offset;
+    return chunks.back().get() + aligned;
+}
+/**
+ * @brief Make room for a number of bytes
+ * @param size The number of bytes, including alignment padding
+ */
+inline void dibiff::util::Arena::reserve(std::size_t size) {
+    if (!chunks.empty() && offset + size <= chunkCapacity) {
+        return;
+    }
+    chunkCapacity = std::max(chunkSize, size);
+    chunks.emplace_back(new unsigned char[chunkCapacity]);
+    offset = 0;
+}
+/**
+ * @brief Get the number of bytes handed out by the arena
+ * @return The number of bytes allocated, including alignment padding
+ */
+inline std::size_t dibiff::util::Arena::used() const {
+    return totalUsed;
+}
@@ -0,0 +1,301 @@
+/// EventLog.h
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace dibiff {
+    namespace util {
+        class EventLog;
+    }
+}
+
+/**
+ * @brief Event Log
+ * @details A real-time safe log for reporting events from process(). Records are
+ * fixed-size and written into a preallocated ring with a lock-free multi-producer
+ * queue, so logging from any number of audio threads costs a bounded copy and never
+ * allocates, locks or blocks; when the ring is full the record is dropped and counted.
+ * Formatting and output happen on the reader's side, either by draining the log
+ * manually or from a background thread started with start().
+ */
+class dibiff::util::EventLog {
+public:
+    enum class Level { Debug, Info, Warning, Error };
+    struct Record {
+        /// Nanoseconds since the log was created
+        std::int64_t time;
+        Level level;
+        char source[32];
+        char message[96];
+        double values[4];
+        int valueCount;
+    };
+
+    /**
+     * @brief Construct a new Event Log object
+     * @param capacity The number of records the ring holds, rounded up to a power of two
+     */
+    explicit EventLog(std::size_t capacity = 1024);
+    ~EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    /**
+     * @brief Log an event
+     * @details Real-time safe. Strings are copied and truncated to the record's fields.
+     * @param level The severity
+     * @param source The name of the reporting object
+     * @param message The message
+     * @param values Up to four values to report with the message
+     * @return True if the record was logged, false if the ring was full
+     */
+    bool log(Level level, const char* source, const char* message, std::initializer_list<double> values = {});
+
+    /**
+     * @brief Take the oldest record
+     * @param record Set to the record
+     * @return True if there was a record
+     */
+    bool pop(Record& record);
+
+    /**
+     * @brief Take every pending record
+     * @param handler Called with each record in order
+     * @return The number of records
+     */
+    std::size_t drain(const std::function<void(const Record&)>& handler);
+
+    /**
+     * @brief Format a record as a line of text
+     * @param record The record
+     * @return The line, without a newline
+     */
+    static std::string format(const Record& record);
+
+    /**
+     * @brief Start flushing records from a background thread
+     * @param sink Called with each formatted line, writes to std::cerr if empty
+     * @param interval The time between flushes
+     */
+    void start(std::function<void(const std::string&)> sink = {}, std::chrono::milliseconds interval = std::chrono::milliseconds(50));
+
+    /**
+     * @brief Stop the background thread after a final flush
+     */
+    void stop();
+
+    /**
+     * @brief Get the number of records dropped because the ring was full
+     * @return The number of dropped records
+     */
+    std::size_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the log shared by the audio objects
+     * @return The global log
+     */
+    static EventLog& global();
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Record record;
+    };
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::atomic<std::size_t> dropped{0};
+    std::chrono::steady_clock::time_point origin;
+    std::thread flusher;
+    std::mutex flusherMutex;
+    std::condition_variable flusherWake;
+    bool flusherRunning = false;
+};
+
+/**
+ * @brief Construct a new Event Log object
+ * @param capacity The number of records the ring holds, rounded up to a power of two
+ */
+inline dibiff::util::EventLog::EventLog(std::size_t capacity)
+    : origin(std::chrono::steady_clock::now()) {
+    std::size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells.reset(new Cell[size]);
+    for (std::size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = size - 1;
+}
+inline dibiff::util::EventLog::~EventLog() {
+    stop();
+}
+/**
+ * @brief Log an event
+ * @details Claims a cell by advancing the head, copies the record in and publishes
+ * it through the cell's sequence number
+ * @param level The severity
+ * @param source The name of the reporting object
+ * @param message The message
+ * @param values Up to four values to report with the message
+ * @return True if the record was logged, false if the ring was full
+ */
+inline bool dibiff::util::EventLog::log(Level level, const char* source, const char* message, std::initializer_list<double> values) {
+    Cell* cell;
+    std::size_t position = head.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+    Record& r = cell->record;
+    r.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    r.level = level;
+    auto copy = [](char* to, std::size_t size, const char* from) {
+        std::size_t i = 0;
+        for (; from != nullptr && i + 1 < size && from[i] != '\0'; ++i) {
+            to[i] = from[i];
+        }
+        to[i] = '\0';
+    };
+    copy(r.source, sizeof(r.source), source);
+    copy(r.message, sizeof(r.message), message);
+    r.valueCount = 0;
+    for (double v : values) {
+        if (r.valueCount == 4) {
+            break;
+        }
+        r.values[r.valueCount++] = v;
+    }
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+/**
+ * @brief Take the oldest record
+ * @param record Set to the record
+ * @return True if there was a record
+ */
+inline bool dibiff::util::EventLog::pop(Record& record) {
+    Cell* cell;
+    std::size_t position = tail.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+    record = cell->record;
+    cell->sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+}
+/**
+ * @brief Take every pending record
+ * @param handler Called with each record in order
+ * @return The number of records
+ */
+inline std::size_t dibiff::util::EventLog::drain(const std::function<void(const Record&)>& handler) {
+    Record record;
+    std::size_t count = 0;
+    while (pop(record)) {
+        handler(record);
+        ++count;
+    }
+    return count;
+}
+/**
+ * @brief Format a record as a line of text
+ * @param record The record
+ * @return The line, without a newline
+ */
+inline std::string dibiff::util::EventLog::format(const Record& record) {
+    static const char* levels[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+    std::ostringstream line;
+    line << "[" << record.time / 1000000.0 << " ms] " << levels[static_cast<int>(record.level)] << " " << record.source << ": " << record.message;
+    for (int i = 0; i < record.valueCount; ++i) {
+        line << (i == 0 ? " (" : ", ") << record.values[i];
+    }
+    if (record.valueCount > 0) {
+        line << ")";
+    }
+    return line.str();
+}
+/**
+ * @brief Start flushing records from a background thread
+ * @param sink Called with each formatted line, writes to std::cerr if empty
+ * @param interval The time between flushes
+ */
+inline void dibiff::util::EventLog::start(std::function<void(const std::string&)> sink, std::chrono::milliseconds interval) {
+    stop();
+    if (!sink) {
+        sink = [](const std::string& line) { std::cerr << line << std::endl; };
+    }
+    flusherRunning = true;
+    flusher = std::thread([this, sink, interval]() {
+        auto flush = [&]() {
+            drain([&](const Record& record) { sink(format(record)); });
+        };
+        std::unique_lock<std::mutex> lock(flusherMutex);
+        while (flusherRunning) {
+            flusherWake.wait_for(lock, interval);
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+        lock.unlock();
+        flush();
+    });
+}
+/**
+ * @brief Stop the background thread after a final flush
+ */
+inline void dibiff::util::EventLog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(flusherMutex);
+        flusherRunning = false;
+    }
+    flusherWake.notify_all();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+}
+/**
+ * @brief Get the log shared by the audio objects
+ * @return The global log
+ */
+inline dibiff::util::EventLog& dibiff::util::EventLog::global() {
+    static EventLog log(4096);
+    return log;
+}
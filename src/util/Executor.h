@@ -0,0 +1,188 @@
+/// Executor.h
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dibiff {
+    namespace util {
+        class Executor;
+    }
+}
+
+/**
+ * @brief Executor
+ * @details A pool of background threads for work that does not have to finish within
+ * the tick that starts it. Jobs are posted into a preallocated ring with a lock-free
+ * multi-producer queue, so posting from an audio thread never locks or blocks; when
+ * the ring is full the job is refused. Idle workers sleep and are woken on post, or
+ * after a millisecond at most.
+ */
+class dibiff::util::Executor {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Construct a new Executor object
+     * @param threads The number of worker threads, at least one
+     * @param capacity The number of jobs the ring holds, rounded up to a power of two
+     */
+    explicit Executor(std::size_t threads = 1, std::size_t capacity = 1024);
+    ~Executor();
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Post a job
+     * @details Real-time safe as long as moving the job does not allocate
+     * @param job The job to run on a worker thread
+     * @return True if the job was queued, false if the ring was full
+     */
+    bool post(Job&& job);
+
+    /**
+     * @brief Get the number of worker threads
+     * @return The number of worker threads
+     */
+    std::size_t getThreads() const { return workers.size(); }
+
+    /**
+     * @brief Get the executor shared by the audio objects
+     * @details Runs one worker per hardware thread, less one for the graph
+     * @return The global executor
+     */
+    static Executor& global();
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Job job;
+    };
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::vector<std::thread> workers;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> running{true};
+    bool take(Job& job);
+};
+
+/**
+ * @brief Construct a new Executor object
+ * @param threads The number of worker threads, at least one
+ * @param capacity The number of jobs the ring holds, rounded up to a power of two
+ */
+inline dibiff::util::Executor::Executor(std::size_t threads, std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells.reset(new Cell[size]);
+    for (std::size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = size - 1;
+    for (std::size_t t = 0; t < std::max<std::size_t>(threads, 1); ++t) {
+        workers.emplace_back([this]() {
+            Job job;
+            while (running.load(std::memory_order_acquire)) {
+                if (take(job)) {
+                    job();
+                    job = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wake.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            /// Finish what was posted before shutting down
+            while (take(job)) {
+                job();
+            }
+        });
+    }
+}
+inline dibiff::util::Executor::~Executor() {
+    running.store(false, std::memory_order_release);
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+/**
+ * @brief Post a job
+ * @details Claims a cell by advancing the head, moves the job in and publishes it
+ * through the cell's sequence number
+ * @param job The job to run on a worker thread
+ * @return True if the job was queued, false if the ring was full
+ */
+inline bool dibiff::util::Executor::post(Job&& job) {
+    Cell* cell;
+    std::size_t position = head.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+    cell->job = std::move(job);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    wake.notify_one();
+    return true;
+}
+/**
+ * @brief Take the oldest job
+ * @param job Set to the job
+ * @return True if there was a job
+ */
+inline bool dibiff::util::Executor::take(Job& job) {
+    Cell* cell;
+    std::size_t position = tail.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+    job = std::move(cell->job);
+    cell->job = nullptr;
+    cell->sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+}
+/**
+ * @brief Get the executor shared by the audio objects
+ * @return The global executor
+ */
+inline dibiff::util::Executor& dibiff::util::Executor::global() {
+    static Executor executor([]() {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 1u;
+    }());
+    return executor;
+}
@@ -0,0 +1,159 @@
+/// FFT.h
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+namespace dibiff {
+    namespace util {
+        class FFT;
+    }
+}
+
+/**
+ * @brief FFT
+ * @details An iterative radix-2 fast Fourier transform of a fixed power-of-two size.
+ * Twiddle factors and the bit-reversal permutation are computed once on construction,
+ * so transforms do not allocate. Real signals are transformed through a complex FFT of
+ * half the size, and the inverse transforms are normalized so a round trip is exact.
+ */
+class dibiff::util::FFT {
+public:
+    using Complex = std::complex<float>;
+
+    /**
+     * @brief Construct a new FFT object
+     * @param size The transform size, must be a power of two of at least 2
+     */
+    explicit FFT(int size);
+
+    /**
+     * @brief Get the transform size
+     * @return The number of real samples of a real transform
+     */
+    int getSize() const { return size; }
+
+    /**
+     * @brief Forward transform of a real signal
+     * @param in The input, size samples
+     * @param out The spectrum, size / 2 + 1 bins
+     */
+    void forward(const float* in, Complex* out);
+
+    /**
+     * @brief Inverse transform to a real signal
+     * @param in The spectrum, size / 2 + 1 bins
+     * @param out The output, size samples
+     */
+    void inverse(const Complex* in, float* out);
+
+private:
+    int size;
+    int half;
+    /// Twiddles of the half-size complex transform
+    std::vector<Complex> twiddles;
+    /// Twiddles splitting the packed real transform, exp(-2 pi i k / size)
+    std::vector<Complex> split;
+    std::vector<int> reversed;
+    std::vector<Complex> work;
+    /**
+     * @brief In-place complex transform of half the size
+     * @param data The data, half samples
+     * @param inverse True for the unnormalized inverse transform
+     */
+    void transform(Complex* data, bool inverse);
+};
+
+/**
+ * @brief Construct a new FFT object
+ * @param size The transform size, must be a power of two of at least 2
+ */
+inline dibiff::util::FFT::FFT(int size)
+    : size(size), half(size / 2) {
+    if (size < 2 || (size & (size - 1)) != 0) {
+        throw std::runtime_error("FFT size must be a power of two.");
+    }
+    twiddles.resize(half / 2 > 0 ? half / 2 : 1);
+    for (int k = 0; k < half / 2; ++k) {
+        twiddles[k] = std::polar(1.0f, static_cast<float>(-2.0 * M_PI * k / half));
+    }
+    split.resize(half + 1);
+    for (int k = 0; k <= half; ++k) {
+        split[k] = std::polar(1.0f, static_cast<float>(-2.0 * M_PI * k / size));
+    }
+    reversed.resize(half);
+    int bits = 0;
+    while ((1 << bits) < half) {
+        ++bits;
+    }
+    for (int i = 0; i < half; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        reversed[i] = r;
+    }
+    work.resize(half);
+}
+/**
+ * @brief Forward transform of a real signal
+ * @details Packs even and odd samples into one complex signal of half the size,
+ * transforms it and separates the two halves of the spectrum
+ * @param in The input, size samples
+ * @param out The spectrum, size / 2 + 1 bins
+ */
+inline void dibiff::util::FFT::forward(const float* in, Complex* out) {
+    for (int n = 0; n < half; ++n) {
+        work[n] = Complex(in[2 * n], in[2 * n + 1]);
+    }
+    transform(work.data(), false);
+    for (int k = 0; k <= half; ++k) {
+        const Complex a = work[k % half];
+        const Complex b = std::conj(work[(half - k) % half]);
+        const Complex even = 0.5f * (a + b);
+        const Complex odd = Complex(0.0f, -0.5f) * (a - b);
+        out[k] = even + split[k] * odd;
+    }
+}
+/**
+ * @brief Inverse transform to a real signal
+ * @param in The spectrum, size / 2 + 1 bins
+ * @param out The output, size samples
+ */
+inline void dibiff::util::FFT::inverse(const Complex* in, float* out) {
+    for (int k = 0; k < half; ++k) {
+        const Complex a = in[k];
+        const Complex b = std::conj(in[half - k]);
+        const Complex even = 0.5f * (a + b);
+        const Complex odd = 0.5f * (a - b) * std::conj(split[k]);
+        work[k] = even + Complex(0.0f, 1.0f) * odd;
+    }
+    transform(work.data(), true);
+    const float scale = 1.0f / half;
+    for (int n = 0; n < half; ++n) {
+        out[2 * n] = work[n].real() * scale;
+        out[2 * n + 1] = work[n].imag() * scale;
+    }
+}
+inline void dibiff::util::FFT::transform(Complex* data, bool inverse) {
+    for (int i = 0; i < half; ++i) {
+        if (i < reversed[i]) {
+            std::swap(data[i], data[reversed[i]]);
+        }
+    }
+    for (int length = 2; length <= half; length <<= 1) {
+        const int step = half / length;
+        for (int start = 0; start < half; start += length) {
+            for (int k = 0; k < length / 2; ++k) {
+                const Complex w = inverse ? std::conj(twiddles[k * step]) : twiddles[k * step];
+                const Complex u = data[start + k];
+                const Complex v = data[start + k + length / 2] * w;
+                data[start + k] = u + v;
+                data[start + k + length / 2] = u - v;
+            }
+        }
+    }
+}
@@ -0,0 +1,232 @@
+/// HugePages.h
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace dibiff {
+    namespace util {
+        class HugePages;
+        template<typename T> class HugePageAllocator;
+        /**
+         * @brief A vector whose storage is backed by huge pages when it is large enough
+         */
+        template<typename T>
+        using HugeVector = std::vector<T, HugePageAllocator<T>>;
+    }
+}
+
+/**
+ * @brief Huge Pages
+ * @details Backs large, randomly accessed buffers such as delay lines and sample data
+ * with 2 MB pages, so they take a handful of TLB entries instead of hundreds. Buffers at
+ * or above the threshold are mapped on a 2 MB boundary and either taken from the
+ * reserved huge page pool with MAP_HUGETLB or advised for transparent huge pages with
+ * madvise. Each step falls back to the next: explicit pages, transparent pages, then
+ * the regular heap. Smaller buffers always come from the heap. The live bytes of each
+ * kind are counted for memory statistics. Huge pages are only used on Linux.
+ */
+class dibiff::util::HugePages {
+public:
+    enum class Mode {
+        /// Always use the regular heap
+        Off,
+        /// Advise transparent huge pages
+        Transparent,
+        /// Use reserved huge pages, falling back to transparent huge pages
+        Explicit
+    };
+    struct Stats {
+        /// Bytes in buffers backed by reserved huge pages
+        std::size_t explicitBytes;
+        /// Bytes in buffers advised for transparent huge pages
+        std::size_t transparentBytes;
+        /// Bytes in buffers on the regular heap
+        std::size_t regularBytes;
+        /// The number of live buffers
+        std::size_t buffers;
+    };
+    static constexpr std::size_t pageSize = 2 * 1024 * 1024;
+
+    /**
+     * @brief Set the allocation mode
+     * @details Applies to buffers allocated afterwards
+     * @param mode The mode
+     */
+    static void setMode(Mode mode) { state().mode.store(mode); }
+    static Mode getMode() { return state().mode.load(); }
+    /**
+     * @brief Set the size from which buffers are backed by huge pages
+     * @param bytes The threshold in bytes
+     */
+    static void setThreshold(std::size_t bytes) { state().threshold.store(bytes); }
+    static std::size_t getThreshold() { return state().threshold.load(); }
+
+    /**
+     * @brief Get the memory statistics
+     * @return The live bytes of each kind of buffer
+     */
+    static Stats getStats();
+    /**
+     * @brief Get the memory the kernel has actually backed with transparent huge pages
+     * @details Reads AnonHugePages from /proc/self/smaps_rollup, for the whole process
+     * @return The bytes, or 0 if unavailable
+     */
+    static std::size_t getResidentBytes();
+
+    /**
+     * @brief Allocate a buffer
+     * @param bytes The size of the buffer
+     * @return The buffer, aligned to at least 16 bytes
+     */
+    static void* allocate(std::size_t bytes);
+    /**
+     * @brief Free a buffer returned by allocate()
+     * @param data The buffer
+     */
+    static void deallocate(void* data) noexcept;
+
+private:
+    enum class Kind : std::uint32_t { Regular, Transparent, Explicit };
+    /// Precedes every buffer, padded so the buffer stays aligned
+    struct alignas(64) Header {
+        std::size_t bytes;
+        std::size_t mapped;
+        Kind kind;
+    };
+    struct State {
+        std::atomic<Mode> mode{Mode::Transparent};
+        std::atomic<std::size_t> threshold{1024 * 1024};
+        std::atomic<std::size_t> bytes[3] = {};
+        std::atomic<std::size_t> buffers{0};
+    };
+    static State& state() {
+        static State s;
+        return s;
+    }
+    static void* finish(void* base, std::size_t bytes, std::size_t mapped, Kind kind) {
+        Header* header = new (base) Header{bytes, mapped, kind};
+        state().bytes[static_cast<int>(kind)] += bytes;
+        state().buffers++;
+        return header + 1;
+    }
+};
+
+/**
+ * @brief Huge Page Allocator
+ * @details A standard allocator over HugePages, for containers of large buffers
+ * @tparam T The element type
+ */
+template<typename T>
+class dibiff::util::HugePageAllocator {
+public:
+    using value_type = T;
+    HugePageAllocator() noexcept = default;
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(HugePages::allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+        HugePages::deallocate(p);
+    }
+    template<typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const HugePageAllocator<U>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Get the memory statistics
+ * @return The live bytes of each kind of buffer
+ */
+inline dibiff::util::HugePages::Stats dibiff::util::HugePages::getStats() {
+    State& s = state();
+    return Stats{
+        s.bytes[static_cast<int>(Kind::Explicit)].load(),
+        s.bytes[static_cast<int>(Kind::Transparent)].load(),
+        s.bytes[static_cast<int>(Kind::Regular)].load(),
+        s.buffers.load()
+    };
+}
+/**
+ * @brief Get the memory the kernel has actually backed with transparent huge pages
+ * @return The bytes, or 0 if unavailable
+ */
+inline std::size_t dibiff::util::HugePages::getResidentBytes() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    std::size_t kilobytes;
+    std::string unit;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:" && smaps >> kilobytes >> unit) {
+            return kilobytes * 1024;
+        }
+        smaps.ignore(256, '\n');
+    }
+    return 0;
+}
+/**
+ * @brief Allocate a buffer
+ * @param bytes The size of the buffer
+ * @return The buffer, aligned to at least 16 bytes
+ */
+inline void* dibiff::util::HugePages::allocate(std::size_t bytes) {
+#ifdef __linux__
+    const Mode mode = getMode();
+    if (mode != Mode::Off && bytes >= getThreshold()) {
+        const std::size_t length = (bytes + sizeof(Header) + pageSize - 1) / pageSize * pageSize;
+        if (mode == Mode::Explicit) {
+            void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                return finish(p, bytes, length, Kind::Explicit);
+            }
+        }
+        /// Map an extra page and trim it, so the buffer starts on a huge page boundary
+        void* raw = mmap(nullptr, length + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            const auto begin = reinterpret_cast<std::uintptr_t>(raw);
+            const auto aligned = (begin + pageSize - 1) & ~(pageSize - 1);
+            if (aligned > begin) {
+                munmap(raw, aligned - begin);
+            }
+            const std::size_t tail = begin + length + pageSize - (aligned + length);
+            if (tail > 0) {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+            madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+            return finish(reinterpret_cast<void*>(aligned), bytes, length, Kind::Transparent);
+        }
+    }
+#endif
+    return finish(::operator new(sizeof(Header) + bytes, std::align_val_t(alignof(Header))), bytes, 0, Kind::Regular);
+}
+/**
+ * @brief Free a buffer returned by allocate()
+ * @param data The buffer
+ */
+inline void dibiff::util::HugePages::deallocate(void* data) noexcept {
+    if (data == nullptr) {
+        return;
+    }
+    Header* header = static_cast<Header*>(data) - 1;
+    state().bytes[static_cast<int>(header->kind)] -= header->bytes;
+    state().buffers--;
+#ifdef __linux__
+    if (header->kind != Kind::Regular) {
+        munmap(header, header->mapped);
+        return;
+    }
+#endif
+    ::operator delete(header, std::align_val_t(alignof(Header)));
+}
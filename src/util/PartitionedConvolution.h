@@ -0,0 +1,160 @@
+/// PartitionedConvolution.h
+
+#pragma once
+
+#include "FFT.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace dibiff {
+    namespace util {
+        class PartitionedConvolution;
+    }
+}
+
+/**
+ * @brief Partitioned Convolution
+ * @details Uniformly partitioned overlap-save convolution of a single stream. The
+ * kernel is cut into partitions of one block, each transformed once with a transform
+ * of twice the block size. Every block transforms the last two input blocks, multiplies
+ * the spectra of the most recent inputs with the partitions they line up with and
+ * transforms the sum back, so the cost per block grows with the number of partitions
+ * rather than the number of taps, and there is no latency beyond the block itself.
+ */
+class dibiff::util::PartitionedConvolution {
+public:
+    using Complex = dibiff::util::FFT::Complex;
+
+    /**
+     * @brief Construct a new Partitioned Convolution object
+     * @param taps The impulse response, h[0] first
+     * @param length The number of taps
+     * @param blockSize The block size, must be a power of two
+     */
+    PartitionedConvolution(const float* taps, int length, int blockSize);
+
+    /**
+     * @brief Convolve a block
+     * @param in The input, one block
+     * @param out The output, one block
+     */
+    void process(const float* in, float* out);
+
+    /**
+     * @brief Set the input history
+     * @details Rebuilds the state as if the stream had been convolved so far, so the
+     * convolution can take over from another implementation without a discontinuity
+     * @param history The most recent input samples, oldest first
+     * @param count The number of samples, older samples are taken to be zero
+     */
+    void prime(const float* history, int count);
+
+    /**
+     * @brief Clear the input history
+     */
+    void reset();
+
+    /**
+     * @brief Get the block size
+     * @return The block size
+     */
+    int getBlockSize() const { return blockSize; }
+
+private:
+    int blockSize;
+    int bins;
+    int partitions;
+    dibiff::util::FFT fft;
+    /// Spectra of the kernel partitions
+    std::vector<Complex> kernel;
+    /// Spectra of the most recent input windows, a ring of one per partition
+    std::vector<Complex> inputs;
+    int position = 0;
+    /// The previous block followed by the current one
+    std::vector<float> window;
+    std::vector<Complex> sum;
+    std::vector<float> result;
+};
+
+/**
+ * @brief Construct a new Partitioned Convolution object
+ * @param taps The impulse response, h[0] first
+ * @param length The number of taps
+ * @param blockSize The block size, must be a power of two
+ */
+inline dibiff::util::PartitionedConvolution::PartitionedConvolution(const float* taps, int length, int blockSize)
+    : blockSize(blockSize), bins(blockSize + 1), partitions((length + blockSize - 1) / blockSize), fft(2 * blockSize),
+      kernel(static_cast<std::size_t>(partitions) * bins), inputs(static_cast<std::size_t>(partitions) * bins),
+      window(2 * blockSize, 0.0f), sum(bins), result(2 * blockSize) {
+    if (length < 1) {
+        throw std::runtime_error("A convolution needs at least one tap.");
+    }
+    std::vector<float> padded(2 * blockSize);
+    for (int p = 0; p < partitions; ++p) {
+        std::fill(padded.begin(), padded.end(), 0.0f);
+        const int start = p * blockSize;
+        std::copy(taps + start, taps + std::min(start + blockSize, length), padded.begin());
+        fft.forward(padded.data(), kernel.data() + static_cast<std::size_t>(p) * bins);
+    }
+}
+/**
+ * @brief Convolve a block
+ * @details The newest input spectrum goes into the ring slot before the previous
+ * newest, so slot position + k always holds the window of k blocks ago
+ * @param in The input, one block
+ * @param out The output, one block
+ */
+inline void dibiff::util::PartitionedConvolution::process(const float* in, float* out) {
+    std::copy(window.begin() + blockSize, window.end(), window.begin());
+    std::copy(in, in + blockSize, window.begin() + blockSize);
+    position = (position + partitions - 1) % partitions;
+    fft.forward(window.data(), inputs.data() + static_cast<std::size_t>(position) * bins);
+    std::fill(sum.begin(), sum.end(), Complex(0.0f, 0.0f));
+    for (int p = 0; p < partitions; ++p) {
+        const Complex* x = inputs.data() + static_cast<std::size_t>((position + p) % partitions) * bins;
+        const Complex* h = kernel.data() + static_cast<std::size_t>(p) * bins;
+        /// Written out, since std::complex multiplication checks for infinities
+        for (int k = 0; k < bins; ++k) {
+            const float re = x[k].real() * h[k].real() - x[k].imag() * h[k].imag();
+            const float im = x[k].real() * h[k].imag() + x[k].imag() * h[k].real();
+            sum[k] = Complex(sum[k].real() + re, sum[k].imag() + im);
+        }
+    }
+    fft.inverse(sum.data(), result.data());
+    /// The first half is wrapped around by the circular convolution, the second half is valid
+    std::copy(result.begin() + blockSize, result.end(), out);
+}
+/**
+ * @brief Set the input history
+ * @details Transforms the windows that the next blocks will find in the ring
+ * @param history The most recent input samples, oldest first
+ * @param count The number of samples, older samples are taken to be zero
+ */
+inline void dibiff::util::PartitionedConvolution::prime(const float* history, int count) {
+    /// The sample `back` samples before the end of the history
+    auto sample = [&](int back) {
+        const int i = count - 1 - back;
+        return i >= 0 ? history[i] : 0.0f;
+    };
+    std::vector<float> past(2 * blockSize);
+    /// After the next block arrives, the window of k blocks ago ends (k - 1) blocks before now
+    for (int k = 1; k < partitions; ++k) {
+        for (int i = 0; i < 2 * blockSize; ++i) {
+            past[i] = sample((k - 1) * blockSize + 2 * blockSize - 1 - i);
+        }
+        fft.forward(past.data(), inputs.data() + static_cast<std::size_t>((position + k - 1) % partitions) * bins);
+    }
+    for (int i = 0; i < blockSize; ++i) {
+        window[blockSize + i] = sample(blockSize - 1 - i);
+    }
+}
+/**
+ * @brief Clear the input history
+ */
+inline void dibiff::util::PartitionedConvolution::reset() {
+    std::fill(inputs.begin(), inputs.end(), Complex(0.0f, 0.0f));
+    std::fill(window.begin(), window.end(), 0.0f);
+    position = 0;
+}
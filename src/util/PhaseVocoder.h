@@ -0,0 +1,216 @@
+/// PhaseVocoder.h
+
+#pragma once
+
+#include "FFT.h"
+#include "../inc/Eigen/Dense"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace dibiff {
+    namespace util {
+        class PhaseVocoder;
+    }
+}
+
+/**
+ * @brief Phase Vocoder
+ * @details A short-time Fourier transform pitch shifter and time stretcher for a single
+ * stream, with identity phase locking. Each frame is Hann-windowed and transformed, and
+ * its magnitude peaks are found. The true frequency of each peak is estimated from its
+ * phase advance since the previous frame, and the peak is moved to the bin of its
+ * shifted frequency with its phase advanced by the shifted frequency over the synthesis
+ * hop. The other bins of the peak's region keep their phase relative to the peak, which
+ * keeps the partials coherent and avoids the smeared sound of a vocoder that advances
+ * every bin on its own. The frames are windowed again and overlap-added.
+ * The caller chooses where each analysis frame starts, so time is stretched by the ratio
+ * of the synthesis hop to the analysis hop, while the pitch is shifted independently.
+ * The work per bin is done on whole arrays; only the peak regions are walked one by one.
+ */
+class dibiff::util::PhaseVocoder {
+public:
+    /**
+     * @brief Construct a new Phase Vocoder object
+     * @param fftSize The frame size, a power of two; larger frames resolve low notes
+     * better at the cost of latency and transients
+     * @param hop The synthesis hop, at most a quarter of the frame size; smaller hops
+     * cost more frames per second
+     */
+    PhaseVocoder(int fftSize, int hop);
+
+    /**
+     * @brief Process a frame
+     * @param frame The analysis frame, fftSize samples
+     * @param analysisHop The number of input samples since the previous frame
+     * @param out The next hop output samples
+     */
+    void process(const float* frame, int analysisHop, float* out);
+
+    /**
+     * @brief Set the pitch ratio
+     * @param ratio The ratio of the output to the input frequencies, 2 is an octave up
+     */
+    void setPitch(float ratio) { pitch = ratio; }
+
+    /**
+     * @brief Get the pitch ratio
+     * @return The ratio of the output to the input frequencies
+     */
+    float getPitch() const { return pitch; }
+
+    int getFftSize() const { return fftSize; }
+    int getHop() const { return hop; }
+
+    /**
+     * @brief Clear the phases and the overlap-add buffer
+     */
+    void reset();
+
+private:
+    int fftSize;
+    int hop;
+    int bins;
+    float pitch = 1.0f;
+    bool first = true;
+    dibiff::util::FFT fft;
+    Eigen::ArrayXf window;
+    /// The centre frequency of each bin in radians per sample
+    Eigen::ArrayXf omega;
+    /// Scales the overlap-added squared windows to unity
+    float scale;
+    Eigen::ArrayXf frameBuffer;
+    std::vector<dibiff::util::FFT::Complex> spectrum;
+    Eigen::ArrayXf magnitude;
+    Eigen::ArrayXf phase;
+    Eigen::ArrayXf previousPhase;
+    Eigen::ArrayXf frequency;
+    Eigen::ArrayXf outputMagnitude;
+    Eigen::ArrayXf outputPhase;
+    Eigen::ArrayXf synthesisPhase;
+    Eigen::ArrayXf overlap;
+    std::vector<int> peaks;
+    /**
+     * @brief Wrap phases to [-pi, pi]
+     * @param x The phases
+     */
+    static void wrap(Eigen::ArrayXf& x);
+};
+
+/**
+ * @brief Construct a new Phase Vocoder object
+ * @param fftSize The frame size, a power of two
+ * @param hop The synthesis hop, at most a quarter of the frame size
+ */
+inline dibiff::util::PhaseVocoder::PhaseVocoder(int fftSize, int hop)
+    : fftSize(fftSize), hop(hop), bins(fftSize / 2 + 1), fft(fftSize) {
+    if (hop < 1 || hop * 4 > fftSize) {
+        throw std::runtime_error("Phase vocoder hop must be between 1 and a quarter of the FFT size.");
+    }
+    window.resize(fftSize);
+    for (int n = 0; n < fftSize; ++n) {
+        window(n) = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * n / fftSize));
+    }
+    /// With at least four frames overlapping, the squared Hann windows sum to a constant
+    scale = static_cast<float>(hop / window.square().sum());
+    omega = Eigen::ArrayXf::LinSpaced(bins, 0.0f, static_cast<float>(M_PI));
+    frameBuffer.resize(fftSize);
+    spectrum.resize(bins);
+    magnitude.resize(bins);
+    phase.resize(bins);
+    frequency.resize(bins);
+    outputMagnitude.resize(bins);
+    outputPhase.resize(bins);
+    peaks.reserve(bins);
+    reset();
+}
+/**
+ * @brief Process a frame
+ * @details Regions reach halfway to the neighbouring peaks. A region is moved by the
+ * whole number of bins that takes its peak to the shifted frequency; the phase advance
+ * sets the exact frequency of the resynthesized partial, so the rounding of the bin does
+ * not detune it.
+ * @param frame The analysis frame, fftSize samples
+ * @param analysisHop The number of input samples since the previous frame
+ * @param out The next hop output samples
+ */
+inline void dibiff::util::PhaseVocoder::process(const float* frame, int analysisHop, float* out) {
+    frameBuffer = Eigen::Map<const Eigen::ArrayXf>(frame, fftSize) * window;
+    fft.forward(frameBuffer.data(), spectrum.data());
+    const Eigen::Map<const Eigen::ArrayXcf> bin(spectrum.data(), bins);
+    magnitude = bin.abs();
+    phase = bin.arg();
+    /// The true frequency of every bin from its phase advance over the analysis hop
+    if (first || analysisHop <= 0) {
+        frequency = omega;
+    } else {
+        frequency = phase - previousPhase - omega * static_cast<float>(analysisHop);
+        wrap(frequency);
+        frequency = omega + frequency / static_cast<float>(analysisHop);
+    }
+    previousPhase = phase;
+    /// Peaks more than 100 dB below the loudest bin are noise and get no region
+    const float floor = magnitude.maxCoeff() * 1.0e-5f;
+    peaks.clear();
+    for (int k = 1; k < bins - 1; ++k) {
+        if (magnitude(k) > floor && magnitude(k) > magnitude(k - 1) && magnitude(k) >= magnitude(k + 1)) {
+            peaks.push_back(k);
+        }
+    }
+    outputMagnitude.setZero();
+    outputPhase = synthesisPhase;
+    const float advance = static_cast<float>(hop) * pitch;
+    /// Unshifted and unstretched, the frame is resynthesized as it is and the output is
+    /// the input delayed, noise and transients included
+    if (pitch == 1.0f && analysisHop == hop) {
+        peaks.clear();
+        outputMagnitude = magnitude;
+        outputPhase = phase;
+    }
+    for (std::size_t j = 0; j < peaks.size(); ++j) {
+        const int p = peaks[j];
+        const int lo = j == 0 ? 0 : (peaks[j - 1] + p) / 2 + 1;
+        const int hi = j + 1 == peaks.size() ? bins - 1 : (p + peaks[j + 1]) / 2;
+        const int target = static_cast<int>(std::lround(p * pitch));
+        if (target < 1 || target >= bins - 1) {
+            continue;
+        }
+        const int shift = target - p;
+        const float peakPhase = first ? phase(p) : synthesisPhase(target) + advance * frequency(p);
+        for (int k = std::max(lo, -shift); k <= std::min(hi, bins - 1 - shift); ++k) {
+            outputMagnitude(k + shift) += magnitude(k);
+            outputPhase(k + shift) = peakPhase + (phase(k) - phase(p));
+        }
+    }
+    wrap(outputPhase);
+    synthesisPhase = outputPhase;
+    Eigen::Map<Eigen::ArrayXcf> synthesis(spectrum.data(), bins);
+    synthesis.real() = outputMagnitude * outputPhase.cos();
+    synthesis.imag() = outputMagnitude * outputPhase.sin();
+    fft.inverse(spectrum.data(), frameBuffer.data());
+    overlap += frameBuffer * window * scale;
+    Eigen::Map<Eigen::ArrayXf>(out, hop) = overlap.head(hop);
+    /// Move the unfinished part of the overlap-add to the front
+    std::copy(overlap.data() + hop, overlap.data() + fftSize, overlap.data());
+    overlap.tail(hop).setZero();
+    first = false;
+}
+/**
+ * @brief Clear the phases and the overlap-add buffer
+ */
+inline void dibiff::util::PhaseVocoder::reset() {
+    previousPhase.setZero(bins);
+    synthesisPhase.setZero(bins);
+    overlap.setZero(fftSize);
+    first = true;
+}
+/**
+ * @brief Wrap phases to [-pi, pi]
+ * @param x The phases
+ */
+inline void dibiff::util::PhaseVocoder::wrap(Eigen::ArrayXf& x) {
+    const float twoPi = static_cast<float>(2.0 * M_PI);
+    x -= twoPi * (x / twoPi).round();
+}
@@ -28,6 +28,13 @@ public:
      */
     void write(const std::vector<T> data, std::size_t samples);
 
+    /**
+     * @brief Write data to the ring buffer
+     * @param data Pointer to the data to write
+     * @param samples The number of samples to write
+     */
+    void write(const T* data, std::size_t samples);
+
     /**
      * @brief Read data from the ring buffer
      * @param data The buffer to read into
@@ -36,12 +43,27 @@ public:
      */
     std::vector<T> read(std::size_t samples);
 
+    /**
+     * @brief Read data from the ring buffer without blocking
+     * @param data The buffer to read into
+     * @param samples The maximum number of samples to read
+     * @return The actual number of samples read
+     */
+    std::size_t read(T* data, std::size_t samples);
+
     /**
      * @brief Get the number of samples available in the buffer
      * @return The number of samples available
      */
     std::size_t available() const;
 
+    /**
+     * @brief Grow the buffer
+     * @details Keeps the samples queued, so it is safe while other threads read and write
+     * @param capacity The new capacity in samples; a smaller capacity changes nothing
+     */
+    void reserve(std::size_t capacity);
+
     /**
      * @brief Clear the buffer
      * @details Reset the head and tail pointers to zero
@@ -84,6 +106,21 @@ void RingBuffer<T>::write(const std::vector<T> data, std::size_t samples) {
     }
     cv.notify_one();
 }
+/**
+ * @brief Write data to the ring buffer
+ * @param data Pointer to the data to write
+ * @param samples The number of samples to write
+ */
+template<typename T>
+void RingBuffer<T>::write(const T* data, std::size_t samples) {
+    std::unique_lock<std::mutex> lock(mtx);
+    for (std::size_t i = 0; i < samples && currentSize < maxCapacity; ++i) {
+        buffer[tail] = data[i];
+        tail = (tail + 1) % maxCapacity;
+        ++currentSize;
+    }
+    cv.notify_one();
+}
 /**
  * @brief Read data from the ring buffer
  * @param samples The number of samples to read
@@ -102,6 +139,23 @@ std::vector<T> RingBuffer<T>::read(std::size_t samples) {
     }
     return data;
 }
+/**
+ * @brief Read data from the ring buffer without blocking
+ * @param data The buffer to read into
+ * @param samples The maximum number of samples to read
+ * @return The actual number of samples read
+ */
+template<typename T>
+std::size_t RingBuffer<T>::read(T* data, std::size_t samples) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::size_t readCount = 0;
+    for (; readCount < samples && currentSize > 0; ++readCount) {
+        data[readCount] = buffer[head];
+        head = (head + 1) % maxCapacity;
+        --currentSize;
+    }
+    return readCount;
+}
 /**
  * @brief Get the number of samples available in the buffer
  * @return The number of samples available
@@ -111,6 +165,33 @@ std::size_t RingBuffer<T>::available() const {
     std::lock_guard<std::mutex> lock(mtx);
     return currentSize;
 }
+/**
+ * @brief Grow the buffer
+ * @details The new storage is allocated before the lock is taken, so readers and
+ * writers only wait for the queued samples to be copied
+ * @param capacity The new capacity in samples; a smaller capacity changes nothing
+ */
+template<typename T>
+void RingBuffer<T>::reserve(std::size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (capacity <= maxCapacity) {
+            return;
+        }
+    }
+    std::vector<T> grown(capacity);
+    std::lock_guard<std::mutex> lock(mtx);
+    if (capacity <= maxCapacity) {
+        return;
+    }
+    for (std::size_t i = 0; i < currentSize; ++i) {
+        grown[i] = buffer[(head + i) % maxCapacity];
+    }
+    buffer.swap(grown);
+    head = 0;
+    tail = currentSize % capacity;
+    maxCapacity = capacity;
+}
 /**
  * @brief Clear the buffer
  * @details Reset the head and tail pointers to zero
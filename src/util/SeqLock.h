@@ -0,0 +1,72 @@
+/// SeqLock.h
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace dibiff {
+    namespace util {
+        template<typename T> class SeqLock;
+    }
+}
+
+/**
+ * @brief SeqLock
+ * @details A sequence lock for publishing a small trivially copyable value from one
+ * writer, typically the audio thread, to any number of readers polling at their own
+ * rate. The writer never waits; a reader that overlaps a write simply retries. The
+ * value is stored as relaxed atomic words, so torn reads are detected rather than
+ * being data races.
+ * @tparam T The type of the published value, must be trivially copyable
+ */
+template<typename T>
+class dibiff::util::SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+public:
+    SeqLock() {
+        store(T{});
+    }
+    /**
+     * @brief Publish a value
+     * @details Must only be called from a single writer thread
+     * @param value The value to publish
+     */
+    void store(const T& value) {
+        std::uint32_t buffer[words];
+        std::memcpy(buffer, &value, sizeof(T));
+        const std::uint32_t s = sequence.load(std::memory_order_relaxed);
+        sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < words; ++i) {
+            data[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(s + 2, std::memory_order_release);
+    }
+    /**
+     * @brief Read the latest published value
+     * @details Safe to call from any thread
+     * @return A consistent copy of the latest value
+     */
+    T load() const {
+        std::uint32_t buffer[words];
+        std::uint32_t s1, s2;
+        do {
+            s1 = sequence.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < words; ++i) {
+                buffer[i] = data[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            s2 = sequence.load(std::memory_order_relaxed);
+        } while ((s1 & 1) || s1 != s2);
+        T value;
+        std::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+private:
+    static constexpr std::size_t words = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint32_t> data[words];
+};
@@ -0,0 +1,144 @@
+/// SignalHealth.h
+
+#pragma once
+
+#include "../inc/Eigen/Dense"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace dibiff {
+    namespace util {
+        class SignalHealth;
+    }
+}
+
+/**
+ * @brief Signal Health
+ * @details Whole-block checks and repairs for audio buffers, vectorised so they run
+ * without a branch per sample. Meant to be run once per block on the outputs that
+ * matter rather than inside every node.
+ */
+class dibiff::util::SignalHealth {
+public:
+    struct Report {
+        /// The number of NaN or infinite samples
+        std::size_t nonFinite;
+        /// The number of nonzero samples too small to be represented normally
+        std::size_t denormals;
+        /// The largest magnitude of the finite samples
+        float peak;
+        /// The mean of the finite samples
+        float dc;
+    };
+
+    /**
+     * @brief Analyze a block
+     * @param data The samples
+     * @param n The number of samples
+     * @return The health of the block
+     */
+    static Report analyze(const float* data, std::size_t n);
+
+    /**
+     * @brief Check if a block has no NaN or infinite samples
+     * @param data The samples
+     * @param n The number of samples
+     * @return True if every sample is finite
+     */
+    static bool isFinite(const float* data, std::size_t n);
+
+    /**
+     * @brief Repair a block in place
+     * @details Replaces NaN and infinite samples with zero and flushes denormals to zero
+     * @param data The samples
+     * @param n The number of samples
+     */
+    static void sanitize(float* data, std::size_t n);
+};
+
+/**
+ * @brief Analyze a block
+ * @details Non-finite samples are masked out of the peak and DC measurements. Uses
+ * AVX2 when available, eight samples per step with the counts taken from the
+ * comparison masks.
+ * @param data The samples
+ * @param n The number of samples
+ * @return The health of the block
+ */
+inline dibiff::util::SignalHealth::Report dibiff::util::SignalHealth::analyze(const float* data, std::size_t n) {
+    Report report{0, 0, 0.0f, 0.0f};
+    if (n == 0) {
+        return report;
+    }
+    const float largest = std::numeric_limits<float>::max();
+    const float smallest = std::numeric_limits<float>::min();
+    std::size_t i = 0;
+    std::size_t finiteCount = 0;
+    double sum = 0.0;
+#ifdef __AVX2__
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 largestV = _mm256_set1_ps(largest);
+    const __m256 smallestV = _mm256_set1_ps(smallest);
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 peakV = zero;
+    __m256 sumV = zero;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 v = _mm256_loadu_ps(data + i);
+        const __m256 m = _mm256_and_ps(v, absMask);
+        /// Ordered comparisons are false for NaN, so this mask rejects NaN and infinity alike
+        const __m256 finite = _mm256_cmp_ps(m, largestV, _CMP_LE_OQ);
+        const __m256 denormal = _mm256_and_ps(_mm256_cmp_ps(m, smallestV, _CMP_LT_OQ), _mm256_cmp_ps(m, zero, _CMP_GT_OQ));
+        finiteCount += static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_ps(finite)));
+        report.denormals += static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_ps(denormal)));
+        peakV = _mm256_max_ps(peakV, _mm256_and_ps(m, finite));
+        sumV = _mm256_add_ps(sumV, _mm256_and_ps(v, finite));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, peakV);
+    for (float lane : lanes) {
+        report.peak = std::max(report.peak, lane);
+    }
+    _mm256_store_ps(lanes, sumV);
+    for (float lane : lanes) {
+        sum += lane;
+    }
+#endif
+    for (; i < n; ++i) {
+        const float m = std::abs(data[i]);
+        if (m <= largest) {
+            ++finiteCount;
+            report.peak = std::max(report.peak, m);
+            sum += data[i];
+            report.denormals += m < smallest && m > 0.0f;
+        }
+    }
+    report.nonFinite = n - finiteCount;
+    report.dc = finiteCount > 0 ? static_cast<float>(sum / static_cast<double>(finiteCount)) : 0.0f;
+    return report;
+}
+/**
+ * @brief Check if a block has no NaN or infinite samples
+ * @param data The samples
+ * @param n The number of samples
+ * @return True if every sample is finite
+ */
+inline bool dibiff::util::SignalHealth::isFinite(const float* data, std::size_t n) {
+    return Eigen::Map<const Eigen::ArrayXf>(data, static_cast<Eigen::Index>(n)).allFinite();
+}
+/**
+ * @brief Repair a block in place
+ * @details Replaces NaN and infinite samples with zero and flushes denormals to zero
+ * @param data The samples
+ * @param n The number of samples
+ */
+inline void dibiff::util::SignalHealth::sanitize(float* data, std::size_t n) {
+    Eigen::Map<Eigen::ArrayXf> x(data, static_cast<Eigen::Index>(n));
+    x = (x.abs() >= std::numeric_limits<float>::min() && x.abs() <= std::numeric_limits<float>::max()).select(x, 0.0f);
+}
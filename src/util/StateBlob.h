@@ -0,0 +1,211 @@
+/// StateBlob.h
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dibiff {
+    namespace util {
+        class StateWriter;
+        class StateReader;
+    }
+}
+
+/**
+ * @brief State Writer
+ * @details Builds a versioned binary blob of an object's runtime state. The blob starts
+ * with a header of a magic number, the blob format version, the object's type name and
+ * the object's own state version. Values and arrays are copied in bulk in native byte
+ * order, so blobs are meant to be restored on the same platform. Every array carries
+ * its element size and count, so restoring into a differently configured object fails
+ * loudly instead of silently.
+ */
+class dibiff::util::StateWriter {
+public:
+    static constexpr std::uint32_t magic = 0x54534244; // "DBST"
+    static constexpr std::uint16_t formatVersion = 1;
+
+    /**
+     * @brief Construct a new State Writer object
+     * @param type The type name of the object
+     * @param version The version of the object's state layout
+     */
+    StateWriter(const std::string& type, std::uint16_t version) {
+        write(magic);
+        write(formatVersion);
+        write(version);
+        write(static_cast<std::uint16_t>(type.size()));
+        append(type.data(), type.size());
+    }
+
+    /**
+     * @brief Write a trivially copyable value
+     * @param value The value
+     */
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "State values must be trivially copyable");
+        append(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Write an array of trivially copyable values
+     * @param data The values
+     * @param count The number of values
+     */
+    template<typename T>
+    void writeArray(const T* data, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "State values must be trivially copyable");
+        write(static_cast<std::uint32_t>(sizeof(T)));
+        write(static_cast<std::uint64_t>(count));
+        append(data, sizeof(T) * count);
+    }
+
+    /**
+     * @brief Write a vector of trivially copyable values
+     * @param values The values
+     */
+    template<typename T, typename Allocator>
+    void writeVector(const std::vector<T, Allocator>& values) {
+        writeArray(values.data(), values.size());
+    }
+
+    /**
+     * @brief Write a string
+     * @param value The string
+     */
+    void writeString(const std::string& value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        append(value.data(), value.size());
+    }
+
+    /**
+     * @brief Get the finished blob
+     * @return The blob
+     */
+    std::vector<unsigned char> finish() {
+        return std::move(blob);
+    }
+
+private:
+    std::vector<unsigned char> blob;
+    void append(const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        blob.insert(blob.end(), bytes, bytes + size);
+    }
+};
+
+/**
+ * @brief State Reader
+ * @details Reads a blob written by a StateWriter, checking its header against the
+ * expected type name and version and every array against the expected size. Any
+ * mismatch throws; objects read into temporaries and only commit them once the whole
+ * blob has been read, so a failed restore leaves them unchanged.
+ */
+class dibiff::util::StateReader {
+public:
+    /**
+     * @brief Construct a new State Reader object
+     * @param blob The blob
+     * @param type The expected type name
+     * @param version The expected state version
+     */
+    StateReader(const std::vector<unsigned char>& blob, const std::string& type, std::uint16_t version)
+        : blob(blob) {
+        if (read<std::uint32_t>() != StateWriter::magic) {
+            throw std::runtime_error("Not a state blob.");
+        }
+        if (read<std::uint16_t>() != StateWriter::formatVersion) {
+            throw std::runtime_error("Unsupported state blob format.");
+        }
+        const std::uint16_t stateVersion = read<std::uint16_t>();
+        const std::uint16_t length = read<std::uint16_t>();
+        take(length);
+        if (std::string(reinterpret_cast<const char*>(blob.data()) + offset - length, length) != type) {
+            throw std::runtime_error("State blob belongs to a different type of object.");
+        }
+        if (stateVersion != version) {
+            throw std::runtime_error("Unsupported state version.");
+        }
+    }
+
+    /**
+     * @brief Read a trivially copyable value
+     * @return The value
+     */
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "State values must be trivially copyable");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Read an array of trivially copyable values
+     * @param data The destination
+     * @param count The expected number of values
+     */
+    template<typename T>
+    void readArray(T* data, std::size_t count) {
+        if (read<std::uint32_t>() != sizeof(T) || read<std::uint64_t>() != count) {
+            throw std::runtime_error("State size mismatch.");
+        }
+        std::memcpy(data, take(sizeof(T) * count), sizeof(T) * count);
+    }
+
+    /**
+     * @brief Read a vector of trivially copyable values
+     * @details The vector must already have the size that was saved
+     * @param values The destination
+     */
+    template<typename T, typename Allocator>
+    void readVector(std::vector<T, Allocator>& values) {
+        readArray(values.data(), values.size());
+    }
+
+    /**
+     * @brief Read a vector of trivially copyable values of any length
+     * @details Used for nested blobs, whose size depends on what was saved
+     * @return The values, as many as were saved
+     */
+    template<typename T>
+    std::vector<T> readVector() {
+        if (read<std::uint32_t>() != sizeof(T)) {
+            throw std::runtime_error("State size mismatch.");
+        }
+        const std::uint64_t count = read<std::uint64_t>();
+        if (count > (blob.size() - offset) / sizeof(T)) {
+            throw std::runtime_error("State blob is truncated.");
+        }
+        std::vector<T> values(count);
+        std::memcpy(values.data(), take(sizeof(T) * count), sizeof(T) * count);
+        return values;
+    }
+
+    /**
+     * @brief Read a string of any length
+     * @return The string
+     */
+    std::string readString() {
+        const std::uint32_t length = read<std::uint32_t>();
+        return std::string(reinterpret_cast<const char*>(take(length)), length);
+    }
+
+private:
+    const std::vector<unsigned char>& blob;
+    std::size_t offset = 0;
+    const unsigned char* take(std::size_t size) {
+        if (offset + size > blob.size()) {
+            throw std::runtime_error("State blob is truncated.");
+        }
+        const unsigned char* p = blob.data() + offset;
+        offset += size;
+        return p;
+    }
+};
@@ -0,0 +1,79 @@
+/// TripleBuffer.h
+
+#pragma once
+
+#include <atomic>
+
+namespace dibiff {
+    namespace util {
+        template<typename T> class TripleBuffer;
+    }
+}
+
+/**
+ * @brief Triple Buffer
+ * @details A wait-free channel for handing snapshots from one writer to one reader,
+ * suited to values too large to copy on every read. The writer fills its back slot
+ * and publishes it by swapping it with the middle slot; the reader takes the middle
+ * slot when it holds something new. Neither side ever blocks, and slots are reused,
+ * so sized containers can be prepared once and never reallocated.
+ * @tparam T The type of the snapshot
+ */
+template<typename T>
+class dibiff::util::TripleBuffer {
+public:
+    /**
+     * @brief Construct a new Triple Buffer object
+     * @param initial The initial value of all three slots
+     */
+    explicit TripleBuffer(const T& initial = T())
+        : slots{initial, initial, initial} {}
+
+    /**
+     * @brief Set all three slots
+     * @details Not thread-safe, call before the writer and reader start
+     * @param value The value to copy into every slot
+     */
+    void fill(const T& value) {
+        for (auto& slot : slots) {
+            slot = value;
+        }
+    }
+
+    /**
+     * @brief Get the slot to write the next snapshot into
+     * @details Writer thread only
+     * @return The back slot
+     */
+    T& back() {
+        return slots[backIndex];
+    }
+
+    /**
+     * @brief Publish the back slot
+     * @details Writer thread only
+     */
+    void publish() {
+        backIndex = middle.exchange(backIndex | dirty, std::memory_order_acq_rel) & index;
+    }
+
+    /**
+     * @brief Get the latest snapshot
+     * @details Reader thread only. The returned reference stays valid until the next call.
+     * @return The most recently published snapshot
+     */
+    const T& read() {
+        if (middle.load(std::memory_order_relaxed) & dirty) {
+            frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & index;
+        }
+        return slots[frontIndex];
+    }
+
+private:
+    static constexpr int dirty = 4;
+    static constexpr int index = 3;
+    T slots[3];
+    int backIndex = 0;
+    std::atomic<int> middle{1};
+    int frontIndex = 2;
+};
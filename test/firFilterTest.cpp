@@ -0,0 +1,82 @@
+#include "../dibiff"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/// Runs a stereo FIR filter through block size changes, short blocks and mode switches,
+/// and checks the output against a naive convolution of the whole stream
+int main() {
+    using Mode = dibiff::filter::FIRFilter::Mode;
+    const int length = 700;
+    const int channels = 2;
+    const long frames = 16384;
+    std::vector<float> taps(length);
+    for (int k = 0; k < length; ++k) {
+        taps[k] = static_cast<float>(std::sin(k * 0.37) * std::exp(-k / 200.0) / 8.0);
+    }
+    std::vector<float> x(static_cast<std::size_t>(frames) * channels);
+    for (long i = 0; i < frames; ++i) {
+        x[i] = static_cast<float>(std::sin(i * 0.01) + 0.3 * std::cos(i * 0.7));
+        x[frames + i] = static_cast<float>(std::cos(i * 0.023) - 0.5 * std::sin(i * 1.3));
+    }
+    int failures = 0;
+    for (Mode mode : {Mode::Direct, Mode::Partitioned, Mode::Automatic}) {
+        dibiff::graph::AudioGraph graph;
+        auto source = graph.add(dibiff::source::BufferSource::create(x.data(), channels, frames, 256));
+        auto filter = graph.add(dibiff::filter::FIRFilter::create(taps));
+        auto sink = graph.add(dibiff::sink::BufferSink::create(channels));
+        graph.connect(source->getOutput(), filter->getInput());
+        graph.connect(filter->getOutput(), sink->getInput());
+        filter->setMode(mode);
+        filter->setChannels(channels);
+        graph.setBlockSize(256);
+        bool everPartitioned = false;
+        auto run = [&](int ticks) {
+            for (int t = 0; t < ticks; ++t) {
+                graph.tick();
+                everPartitioned |= filter->isPartitioned();
+            }
+        };
+        run(4);
+        /// Announced change of block size
+        graph.setBlockSize(128);
+        run(4);
+        /// Shorter blocks the filter is not told about, like a final block
+        source->setBlockSize(100);
+        run(3);
+        source->setBlockSize(128);
+        run(3);
+        /// Switch implementation mid-stream and back
+        filter->setMode(mode == Mode::Direct ? Mode::Partitioned : Mode::Direct);
+        run(3);
+        filter->setMode(mode);
+        run(3);
+        graph.setBlockSize(512);
+        run(4);
+        if (mode == Mode::Partitioned && !everPartitioned) {
+            std::printf("mode %d: never used partitioned convolution\n", static_cast<int>(mode));
+            ++failures;
+        }
+        double worst = 0.0;
+        std::size_t samples = 0;
+        for (int c = 0; c < channels; ++c) {
+            const std::vector<float>& y = sink->getChannelData(c);
+            const float* in = x.data() + static_cast<std::size_t>(c) * frames;
+            samples = y.size();
+            for (std::size_t n = 0; n < y.size(); ++n) {
+                double reference = 0.0;
+                for (int k = 0; k < length && k <= static_cast<long>(n); ++k) {
+                    reference += taps[k] * in[n - k];
+                }
+                worst = std::max(worst, std::fabs(reference - y[n]));
+            }
+        }
+        std::printf("mode %d: %zu samples, largest error %.2e\n", static_cast<int>(mode), samples, worst);
+        if (samples == 0 || worst > 1.0e-4) {
+            ++failures;
+        }
+    }
+    std::printf("%s\n", failures == 0 ? "passed" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include "../dibiff"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/// Freezes a finite sine through a gain, which ends on a short block, then changes the
+/// watched gain while the frozen graph plays and checks that the new render is swapped in
+int main() {
+    const int blockSize = 256;
+    const int sampleRate = 48000;
+    const float frequency = 440.0f;
+    const int samples = 1000;
+    const long length = 4800;
+    int failures = 0;
+    float gaindB = 0.0f;
+    auto frozen = dibiff::graph::Frozen::create([&](dibiff::graph::AudioGraph& inner, dibiff::graph::AudioInput* exit) {
+        auto sine = inner.add(dibiff::generator::SineGenerator::create(blockSize, sampleRate, frequency, samples));
+        auto gain = inner.add(dibiff::level::Gain::create(gaindB));
+        inner.connect(sine->output, gain->input);
+        inner.connect(gain->output, exit);
+    }, blockSize, length);
+    frozen->watch(gaindB);
+    auto expected = [&](long n, float level) {
+        const double x = n < samples ? std::sin(2.0 * M_PI * frequency * n / sampleRate) : 0.0;
+        return static_cast<float>(level * x);
+    };
+
+    // The short final block of the sine is zero-padded, and the rest of the render is silent
+    frozen->freeze();
+    dibiff::graph::AudioGraph graph;
+    auto f = graph.add(std::move(frozen));
+    auto sink = graph.add(dibiff::sink::BufferSink::create(1));
+    graph.connect(f->output, sink->getInput());
+    graph.setBlockSize(blockSize);
+    graph.tick();
+    const float* cache = f->getCache();
+    double worst = 0.0;
+    for (long n = 0; cache != nullptr && n < length; ++n) {
+        worst = std::max(worst, static_cast<double>(std::fabs(cache[n] - expected(n, 1.0f))));
+    }
+    std::printf("short block: largest error %.2e\n", worst);
+    if (cache == nullptr || worst > 1.0e-4) {
+        ++failures;
+    }
+
+    // A change of the watched gain is rendered in the background while the old render plays
+    gaindB = -20.0f;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    int ticks = 1;
+    do {
+        graph.tick();
+        ++ticks;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while (!f->isFrozen() && std::chrono::steady_clock::now() < deadline);
+    /// Another loop period to swap the new render in and play its start
+    for (long n = 0; n <= length; n += blockSize) {
+        graph.tick();
+        ++ticks;
+    }
+    const std::vector<float>& y = sink->getChannelData(0);
+    int oldBlocks = 0;
+    int newBlocks = 0;
+    int wrongBlocks = 0;
+    bool switched = false;
+    for (int b = 0; b < ticks && static_cast<std::size_t>(b + 1) * blockSize <= y.size(); ++b) {
+        double oldError = 0.0;
+        double newError = 0.0;
+        for (int i = 0; i < blockSize; ++i) {
+            const long n = (static_cast<long>(b) * blockSize + i) % length;
+            oldError = std::max(oldError, static_cast<double>(std::fabs(y[b * blockSize + i] - expected(n, 1.0f))));
+            newError = std::max(newError, static_cast<double>(std::fabs(y[b * blockSize + i] - expected(n, 0.1f))));
+        }
+        /// Silent blocks match either render
+        if (newError < 1.0e-4 && oldError >= 1.0e-4) {
+            ++newBlocks;
+            switched = true;
+        } else if (oldError < 1.0e-4 && (!switched || newError < 1.0e-4)) {
+            ++oldBlocks;
+        } else {
+            ++wrongBlocks;
+        }
+    }
+    std::printf("re-render: %d blocks of the old render, %d of the new, %d wrong\n", oldBlocks, newBlocks, wrongBlocks);
+    if (!f->isFrozen() || !switched || wrongBlocks != 0 || y.size() != static_cast<std::size_t>(ticks) * blockSize) {
+        ++failures;
+    }
+
+    std::printf("%s\n", failures == 0 ? "passed" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
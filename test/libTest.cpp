@@ -14,15 +14,15 @@ int main() {
     dibiff::graph::AudioGraph graph;
 
     // Create MIDI Input
-    auto midiInput = graph.add(dibiff::midi::MidiInput::create(blockSize).get());
+    auto midiInput = graph.add(dibiff::midi::MidiInput::create(blockSize));
     midiInput->setName("midi-input");
 
     // Create Sine Generator
-    auto sineGenerator = graph.add(dibiff::generator::SineGenerator::create(blockSize, sampleRate).get());
+    auto sineGenerator = graph.add(dibiff::generator::SineGenerator::create(blockSize, sampleRate));
     sineGenerator->setName("sine-generator");
 
     // Create AudioPlayer
-    auto audioPlayer = graph.add(dibiff::sink::GraphSink::create(1, sampleRate, blockSize).get());
+    auto audioPlayer = graph.add(dibiff::sink::GraphSink::create(1, sampleRate, blockSize));
     audioPlayer->setName("audio-player");
 
     // Connect everything
@@ -34,18 +34,22 @@ int main() {
     std::mutex cv_mtx;
 
     // Start the audio graph in a separate thread
-    std::thread audioThread([&graph]() {
-        graph.run(true);
+    std::thread audioThread([&graph, sampleRate, blockSize]() {
+        const auto blockDuration = std::chrono::microseconds(static_cast<int>(std::round(1e6 * blockSize / sampleRate)));
+        while (true) {
+            graph.tick();
+            std::this_thread::sleep_for(blockDuration);
+        }
     });
 
     // Start MIDI event generation in a separate thread
-    std::thread midiThread([&midiInput, blockSize]() {
-        auto mi = dynamic_cast<dibiff::midi::MidiInput*>(midiInput);
+    std::thread midiThread([midiInput, blockSize]() {
+        auto mi = midiInput.get();
         while (true) {
             // Simulate generating a MIDI message (example: Note On)
             std::vector<unsigned char> midiMessage = {0x90, 0x40, 0x7F}; // Note On, middle C, velocity 127
             // Add the MIDI message to the input
-            mi->addMidiMessage(midiMessage);
+            mi->addMidiMessage({midiMessage});
             std::cout << "MIDI message added" << std::endl;
             // Wait for a bit before generating the next MIDI event
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -53,8 +57,8 @@ int main() {
     });
 
     // Start the audio data reading thread
-    std::thread readThread([&audioPlayer]() {
-        auto ap = dynamic_cast<dibiff::sink::GraphSink*>(audioPlayer);
+    std::thread readThread([audioPlayer]() {
+        auto ap = audioPlayer.get();
         std::vector<float> buffer(ap->blockSize);
 
         // Duration of each frame in microseconds
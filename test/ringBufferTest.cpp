@@ -0,0 +1,86 @@
+#include "../src/util/RingBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+/// Grows a ring in place while a reader and a writer run, and checks that every sample
+/// arrives once and in order
+int main() {
+    int failures = 0;
+
+    // Queued samples that wrap around the end keep their order when the ring grows
+    RingBuffer<float> wrapped(8);
+    const float x[6] = {1, 2, 3, 4, 5, 6};
+    float y[16];
+    wrapped.write(x, 6);
+    wrapped.read(y, 4);
+    wrapped.write(x, 6);
+    wrapped.reserve(32);
+    const float expected[8] = {5, 6, 1, 2, 3, 4, 5, 6};
+    const std::size_t n = wrapped.read(y, 16);
+    if (n != 8) {
+        std::printf("wrapped: read %zu samples, expected 8\n", n);
+        ++failures;
+    }
+    for (std::size_t i = 0; i < n && i < 8; ++i) {
+        if (y[i] != expected[i]) {
+            std::printf("wrapped: sample %zu is %g, expected %g\n", i, y[i], expected[i]);
+            ++failures;
+        }
+    }
+
+    // A reader and a writer keep running while the ring grows from 64 to 65536 samples
+    RingBuffer<long> ring(64);
+    std::atomic<std::size_t> capacity{64};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> written{false};
+    long received = 0;
+    long disorder = 0;
+    std::thread reader([&]() {
+        long block[16];
+        long last = -1;
+        while (!written || ring.available() > 0) {
+            const std::size_t k = ring.read(block, 16);
+            for (std::size_t i = 0; i < k; ++i) {
+                if (block[i] != last + 1) {
+                    ++disorder;
+                }
+                last = block[i];
+                ++received;
+            }
+        }
+    });
+    long sent = 0;
+    std::thread writer([&]() {
+        long block[8];
+        while (!stop) {
+            /// Never overrun, since a full ring drops samples by design
+            if (ring.available() + 8 > capacity) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (int i = 0; i < 8; ++i) {
+                block[i] = sent + i;
+            }
+            ring.write(block, 8);
+            sent += 8;
+        }
+    });
+    for (std::size_t size = 64; size <= 65536; size *= 2) {
+        ring.reserve(size);
+        capacity = size;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    stop = true;
+    writer.join();
+    written = true;
+    reader.join();
+    if (disorder != 0 || received != sent) {
+        std::printf("concurrent: sent %ld, received %ld, %ld out of order\n", sent, received, disorder);
+        ++failures;
+    }
+
+    std::printf("%s\n", failures == 0 ? "passed" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}